@@ -263,6 +263,8 @@ ClassDB::ClassInfo::ClassInfo() {
 	api = API_NONE;
 	creation_func = NULL;
 	inherits_ptr = NULL;
+	class_ptr = NULL;
+	overrides_call = false;
 	disabled = false;
 	exposed = false;
 }
@@ -554,7 +556,7 @@ bool ClassDB::can_instance(const StringName &p_class) {
 	return (!ti->disabled && ti->creation_func != NULL);
 }
 
-void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits) {
+void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits, void *p_class_ptr, bool p_overrides_call) {
 
 	OBJTYPE_WLOCK;
 
@@ -566,6 +568,8 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 	ClassInfo &ti = classes[name];
 	ti.name = name;
 	ti.inherits = p_inherits;
+	ti.class_ptr = p_class_ptr;
+	ti.overrides_call = p_overrides_call;
 	ti.api = current_api;
 
 	if (ti.inherits) {
@@ -667,6 +671,33 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	return NULL;
 }
 
+MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_name, MethodCache *p_cache) {
+
+	MethodBind *method;
+	if (p_cache->lookup(p_class, method))
+		return method;
+
+	bool overrides_call;
+	{
+		OBJTYPE_RLOCK;
+		ClassInfo *type = classes.getptr(p_class);
+		overrides_call = !type || type->overrides_call;
+	}
+
+	if (overrides_call) {
+		// the override may handle the name before the bound method, remember to always let it
+		p_cache->insert(p_class, NULL);
+		return NULL;
+	}
+
+	method = get_method(p_class, p_name);
+	if (method) {
+		// misses are not remembered, they end up as errors anyway
+		p_cache->insert(p_class, method);
+	}
+	return method;
+}
+
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int p_constant) {
 
 	OBJTYPE_WLOCK;
@@ -999,92 +1030,112 @@ void ClassDB::get_property_list(StringName p_class, List<PropertyInfo> *p_list,
 		check = check->inherits_ptr;
 	}
 }
-bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
+bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid, PropertyCache *p_cache) {
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
+	const StringName &class_name = p_object->get_class_name();
+	const PropertySetGet *psg = NULL;
 
-			if (!psg->setter) {
-				if (r_valid)
-					*r_valid = false;
-				return true; //return true but do nothing
-			}
+	if (!p_cache || !p_cache->lookup(class_name, psg)) {
 
-			Variant::CallError ce;
+		ClassInfo *check = classes.getptr(class_name);
+		while (check) {
+			psg = check->property_setget.getptr(p_property);
+			if (psg)
+				break;
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->call(psg->setter, arg, 2, ce);
-				}
+			check = check->inherits_ptr;
+		}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->call(psg->setter, arg, 1, ce);
-				}
-			}
+		if (p_cache)
+			p_cache->insert(class_name, psg);
+	}
 
-			if (r_valid)
-				*r_valid = ce.error == Variant::CallError::CALL_OK;
+	if (!psg)
+		return false;
 
-			return true;
+	if (!psg->setter) {
+		if (r_valid)
+			*r_valid = false;
+		return true; //return true but do nothing
+	}
+
+	Variant::CallError ce;
+
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->call(psg->setter, arg, 2, ce);
 		}
 
-		check = check->inherits_ptr;
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->call(psg->setter, arg, 1, ce);
+		}
 	}
 
-	return false;
+	if (r_valid)
+		*r_valid = ce.error == Variant::CallError::CALL_OK;
+
+	return true;
 }
-bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
+bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value, PropertyCache *p_cache) {
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter)
-				return true; //return true but do nothing
+	const StringName &class_name = p_object->get_class_name();
+	const PropertySetGet *psg = NULL;
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[1] = { &index };
-				Variant::CallError ce;
-				r_value = p_object->call(psg->getter, arg, 1, ce);
+	if (!p_cache || !p_cache->lookup(class_name, psg)) {
 
-			} else {
+		ClassInfo *check = classes.getptr(class_name);
+		while (check) {
+			psg = check->property_setget.getptr(p_property);
+			if (psg)
+				break;
 
-				Variant::CallError ce;
-				if (psg->_getptr) {
+			// constants are not cached, they are rarely read this way
+			const int *c = check->constant_map.getptr(p_property);
+			if (c) {
 
-					r_value = psg->_getptr->call(p_object, NULL, 0, ce);
-				} else {
-					r_value = p_object->call(psg->getter, NULL, 0, ce);
-				}
+				r_value = *c;
+				return true;
 			}
-			return true;
-		}
 
-		const int *c = check->constant_map.getptr(p_property);
-		if (c) {
-
-			r_value = *c;
-			return true;
+			check = check->inherits_ptr;
 		}
 
-		check = check->inherits_ptr;
+		if (p_cache)
+			p_cache->insert(class_name, psg);
 	}
 
-	return false;
+	if (!psg)
+		return false;
+
+	if (!psg->getter)
+		return true; //return true but do nothing
+
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[1] = { &index };
+		Variant::CallError ce;
+		r_value = p_object->call(psg->getter, arg, 1, ce);
+
+	} else {
+
+		Variant::CallError ce;
+		if (psg->_getptr) {
+
+			r_value = psg->_getptr->call(p_object, NULL, 0, ce);
+		} else {
+			r_value = p_object->call(psg->getter, NULL, 0, ce);
+		}
+	}
+	return true;
 }
 
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
@@ -34,6 +34,8 @@
 #include "core/method_bind.h"
 #include "core/object.h"
 #include "core/print_string.h"
+#include "core/safe_refcount.h"
+#include "core/type_info.h"
 
 /**	To bind more then 6 parameters include this:
  *  #include "core/method_bind_ext.gen.inc"
@@ -91,6 +93,9 @@ static _FORCE_INLINE_ const char *D_METHOD(const char *m_name, ...) {
 
 #endif
 
+class MethodCache;
+class PropertyCache;
+
 class ClassDB {
 public:
 	enum APIType {
@@ -132,6 +137,8 @@ public:
 		StringName name;
 		bool disabled;
 		bool exposed;
+		void *class_ptr; // matches Object::is_class_ptr() for instances of this class
+		bool overrides_call; // it or a parent class overrides Object::call(), bound methods may be shadowed
 		Object *(*creation_func)();
 		ClassInfo();
 		~ClassInfo();
@@ -155,7 +162,13 @@ public:
 
 	static APIType current_api;
 
-	static void _add_class2(const StringName &p_class, const StringName &p_inherits);
+	static void _add_class2(const StringName &p_class, const StringName &p_inherits, void *p_class_ptr, bool p_overrides_call);
+
+	// &T::call names the most derived declaration of call(), so C is Object unless a class in between overrides it
+	template <class C>
+	static bool _overrides_call(Variant (C::*)(const StringName &, const Variant **, int, Variant::CallError &)) {
+		return !TypesAreSame<C, Object>::value;
+	}
 
 	static HashMap<StringName, HashMap<StringName, Variant> > default_values;
 	static Set<StringName> default_values_cached;
@@ -165,7 +178,7 @@ public:
 	template <class T>
 	static void _add_class() {
 
-		_add_class2(T::get_class_static(), T::get_parent_class_static());
+		_add_class2(T::get_class_static(), T::get_parent_class_static(), T::get_class_ptr_static(), _overrides_call(&T::call));
 	}
 
 	template <class T>
@@ -327,8 +340,8 @@ public:
 	static void add_property(StringName p_class, const PropertyInfo &p_pinfo, const StringName &p_setter, const StringName &p_getter, int p_index = -1);
 	static void set_property_default_value(StringName p_class, const StringName &p_name, const Variant &p_default);
 	static void get_property_list(StringName p_class, List<PropertyInfo> *p_list, bool p_no_inheritance = false, const Object *p_validator = NULL);
-	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = NULL);
-	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
+	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = NULL, PropertyCache *p_cache = NULL);
+	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value, PropertyCache *p_cache = NULL);
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
@@ -340,6 +353,8 @@ public:
 
 	static void get_method_list(StringName p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false, bool p_exclude_from_properties = false);
 	static MethodBind *get_method(StringName p_class, StringName p_name);
+	// NULL for classes overriding Object::call(), callers must go through call() for them
+	static MethodBind *get_method(const StringName &p_class, const StringName &p_name, MethodCache *p_cache);
 
 	static void add_virtual_method(const StringName &p_class, const MethodInfo &p_method, bool p_virtual = true);
 	static void get_virtual_methods(const StringName &p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false);
@@ -374,6 +389,100 @@ public:
 	static void cleanup();
 };
 
+// Remembers the result of a lookup that only depends on the class of an object, so it can be kept per call site
+// (GDScript keeps one per name used in a function) instead of walking the class hierarchy every time. Classes
+// are identified by their name, StringNames being unique its data pointer is enough. Only the first MAX_CLASSES
+// classes seen are remembered, others always take the slow path. Reading and writing a property resolve
+// differently (constants can be read as properties), so they need separate caches.
+// Lookups don't lock: a table is never modified once published, adding a class publishes a copy and keeps the
+// previous one around until the cache is destroyed, as another thread may still be reading it.
+template <class T>
+class ClassLookupCache {
+public:
+	enum {
+		MAX_CLASSES = 4
+	};
+
+private:
+	struct Table {
+		int count;
+		const void *classes[MAX_CLASSES];
+		T values[MAX_CLASSES];
+		Table *retired;
+	};
+
+	Table *volatile table;
+
+public:
+	_FORCE_INLINE_ bool lookup(const StringName &p_class, T &r_value) const {
+
+		const Table *t = atomic_load_acquire(&table);
+		if (!t)
+			return false;
+
+		const void *key = p_class.data_unique_pointer();
+		for (int i = 0; i < t->count; i++) {
+			if (t->classes[i] == key) {
+				r_value = t->values[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void insert(const StringName &p_class, const T &p_value) {
+
+		Table *current = table;
+		if (current && current->count == MAX_CLASSES)
+			return;
+
+		Table *t = memnew(Table);
+		t->count = 0;
+		if (current) {
+			for (int i = 0; i < current->count; i++) {
+				t->classes[i] = current->classes[i];
+				t->values[i] = current->values[i];
+			}
+			t->count = current->count;
+		}
+		t->classes[t->count] = p_class.data_unique_pointer();
+		t->values[t->count] = p_value;
+		t->count++;
+		t->retired = current;
+
+		if (atomic_compare_and_swap((volatile uintptr_t *)&table, (uintptr_t)current, (uintptr_t)t) != (uintptr_t)current) {
+			// another thread got there first, its entry is as good as ours
+			memdelete(t);
+		}
+	}
+
+	ClassLookupCache() {
+		table = NULL;
+	}
+
+	// copies start empty, a cache only ever holds what its own lookups resolved
+	ClassLookupCache(const ClassLookupCache &p_from) {
+		table = NULL;
+	}
+
+	ClassLookupCache &operator=(const ClassLookupCache &p_from) {
+		return *this;
+	}
+
+	~ClassLookupCache() {
+		Table *t = table;
+		while (t) {
+			Table *retired = t->retired;
+			memdelete(t);
+			t = retired;
+		}
+	}
+};
+
+class MethodCache : public ClassLookupCache<MethodBind *> {};
+
+class PropertyCache : public ClassLookupCache<const ClassDB::PropertySetGet *> {};
+
 #ifdef DEBUG_METHODS_ENABLED
 
 #define BIND_CONSTANT(m_constant) \
@@ -32,6 +32,9 @@
 
 #include "core/os/os.h"
 
+volatile uint32_t CommandQueueMT::contended_pushes = 0;
+volatile uint32_t CommandQueueMT::stalls = 0;
+
 void CommandQueueMT::lock() {
 
 	if (mutex)
@@ -50,69 +53,44 @@ void CommandQueueMT::wait_for_flush() {
 	OS::get_singleton()->delay_usec(1000);
 }
 
-CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
+void CommandQueueMT::wait_for_publish() {
+
+	// a producer reserved the next command and is still writing it,
+	// it should be done in a few instructions
+	OS::get_singleton()->delay_usec(1);
+}
 
-	int idx = -1;
+CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 
 	while (true) {
 
-		lock();
 		for (int i = 0; i < SYNC_SEMAPHORES; i++) {
 
-			if (!sync_sems[i].in_use) {
-				sync_sems[i].in_use = true;
-				idx = i;
-				break;
+			if (sync_sems[i].in_use == 0 && atomic_compare_and_swap(&sync_sems[i].in_use, 0U, 1U) == 0) {
+				return &sync_sems[i];
 			}
 		}
-		unlock();
-
-		if (idx == -1) {
-			wait_for_flush();
-		} else {
-			break;
-		}
-	}
 
-	return &sync_sems[idx];
-}
-
-bool CommandQueueMT::dealloc_one() {
-tryagain:
-	if (dealloc_ptr == write_ptr) {
-		// The queue is empty
-		return false;
-	}
-
-	uint32_t size = *(uint32_t *)&command_mem[dealloc_ptr];
-
-	if (size == 0) {
-		// End of command buffer wrap down
-		dealloc_ptr = 0;
-		goto tryagain;
-	}
-
-	if (size & 1) {
-		// Still used, nothing can be deallocated
-		return false;
+		// all in use by other threads waiting for their results
+		atomic_increment(&stalls);
+		wait_for_flush();
 	}
-
-	dealloc_ptr += (size >> 1) + 8;
-	return true;
 }
 
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 
-	read_ptr = 0;
-	write_ptr = 0;
-	dealloc_ptr = 0;
+	write_pos = 0;
+	release_pos = 0;
+	read_pos = 0;
+	pending_release = 0;
 	mutex = Mutex::create();
 	command_mem = (uint8_t *)memalloc(COMMAND_MEM_SIZE);
+	zeromem(command_mem, COMMAND_MEM_SIZE);
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
 
 		sync_sems[i].sem = Semaphore::create();
-		sync_sems[i].in_use = false;
+		sync_sems[i].in_use = 0;
 	}
 	if (p_sync)
 		sync = Semaphore::create();
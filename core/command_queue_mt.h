@@ -31,9 +31,11 @@
 #ifndef COMMAND_QUEUE_MT_H
 #define COMMAND_QUEUE_MT_H
 
+#include "core/os/copymem.h"
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/safe_refcount.h"
 #include "core/simple_type.h"
 #include "core/typedefs.h"
 
@@ -228,11 +230,11 @@
 #define DECL_PUSH(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>       \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>();                 \
+		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                          \
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
+		publish(cmd);                                                        \
 		if (sync) sync->post();                                              \
 	}
 
@@ -242,16 +244,16 @@
 	template <class T, class M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) class R>                \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
-		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
+		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
 		cmd->instance = p_instance;                                                            \
 		cmd->method = p_method;                                                                \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
+		publish(cmd);                                                                          \
 		if (sync) sync->post();                                                                \
 		ss->sem->wait();                                                                       \
-		ss->in_use = false;                                                                    \
+		ss->in_use = 0;                                                                        \
 	}
 
 #define CMD_SYNC_TYPE(N) CommandSync##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
@@ -260,15 +262,15 @@
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
-		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
+		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
 		cmd->instance = p_instance;                                                   \
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
+		publish(cmd);                                                                 \
 		if (sync) sync->post();                                                       \
 		ss->sem->wait();                                                              \
-		ss->in_use = false;                                                           \
+		ss->in_use = 0;                                                               \
 	}
 
 #define MAX_CMD_PARAMS 13
@@ -278,7 +280,7 @@ class CommandQueueMT {
 	struct SyncSemaphore {
 
 		Semaphore *sem;
-		bool in_use;
+		volatile uint32_t in_use;
 	};
 
 	struct CommandBase {
@@ -316,129 +318,135 @@ class CommandQueueMT {
 		SYNC_SEMAPHORES = 8
 	};
 
+	// Every command is preceded by an 8 bytes header holding its size
+	// (header included) and the flags below. Producers reserve space by
+	// moving write_pos forward with a CAS and publish the header once the
+	// command is constructed, so the consumer only ever sees complete
+	// commands. A header of zero means not published yet.
+	enum {
+		HEADER_READY = 1,
+		HEADER_SKIP = 2, // padding up to the end of the ring, no command
+		HEADER_FLAG_BITS = 2
+	};
+
 	uint8_t *command_mem;
-	uint32_t read_ptr;
-	uint32_t write_ptr;
-	uint32_t dealloc_ptr;
+	// Positions grow monotonically and wrap around with uint32_t, the
+	// offset in command_mem is pos & (COMMAND_MEM_SIZE - 1).
+	volatile uint32_t write_pos; // reserved by producers
+	volatile uint32_t release_pos; // handed back to producers by the consumer
+	uint32_t read_pos; // consumer only
+	uint32_t pending_release; // consumer only, bytes flushed but not released yet
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex *mutex;
 	Semaphore *sync;
 
-	template <class T>
-	T *allocate() {
+	static volatile uint32_t contended_pushes;
+	static volatile uint32_t stalls;
 
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8;
+	uint8_t *reserve(uint32_t p_size) {
 
-	tryagain:
+		// alloc size is header+size
+		uint32_t alloc_size = p_size + 8;
 
-		if (write_ptr < dealloc_ptr) {
-			// behind dealloc_ptr, check that there is room
-			if ((dealloc_ptr - write_ptr) <= alloc_size) {
+		while (true) {
 
-				// There is no more room, try to deallocate something
-				if (dealloc_one()) {
-					goto tryagain;
-				}
-				return NULL;
+			uint32_t pos = write_pos;
+			uint32_t offset = pos & (COMMAND_MEM_SIZE - 1);
+			// commands are never split, skip to the beginning if it does not fit
+			uint32_t skip = (COMMAND_MEM_SIZE - offset < alloc_size) ? COMMAND_MEM_SIZE - offset : 0;
+
+			if (pos + skip + alloc_size - release_pos > (uint32_t)COMMAND_MEM_SIZE) {
+				// There is no more room, sleep a little until some is released
+				atomic_increment(&stalls);
+				wait_for_flush();
+				continue;
 			}
-		} else {
-			// ahead of dealloc_ptr, check that there is room
 
-			if ((COMMAND_MEM_SIZE - write_ptr) < alloc_size + sizeof(uint32_t)) {
-				// no room at the end, wrap down;
+			if (atomic_compare_and_swap(&write_pos, pos, pos + skip + alloc_size) != pos) {
+				// another producer got there first
+				atomic_increment(&contended_pushes);
+				continue;
+			}
 
-				if (dealloc_ptr == 0) { // don't want write_ptr to become dealloc_ptr
+			if (skip) {
+				atomic_add((uint32_t *)&command_mem[offset], (skip << HEADER_FLAG_BITS) | HEADER_SKIP | HEADER_READY);
+				offset = 0;
+			}
 
-					// There is no more room, try to deallocate something
-					if (dealloc_one()) {
-						goto tryagain;
-					}
-					return NULL;
-				}
+			return &command_mem[offset + 8];
+		}
+	}
 
-				// if this happens, it's a bug
-				ERR_FAIL_COND_V((COMMAND_MEM_SIZE - write_ptr) < 8, NULL);
-				// zero means, wrap to beginning
+	template <class T>
+	T *allocate() {
 
-				uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-				*p = 0;
-				write_ptr = 0;
-				goto tryagain;
-			}
-		}
-		// Allocate the size and the 'in use' bit.
-		// First bit used to mark if command is still in use (1)
-		// or if it has been destroyed and can be deallocated (0).
-		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
-		uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-		*p = (size << 1) | 1;
-		write_ptr += 8;
-		// allocate the command
-		T *cmd = memnew_placement(&command_mem[write_ptr], T);
-		write_ptr += size;
-		return cmd;
+		return memnew_placement(reserve((sizeof(T) + 8 - 1) & ~(8 - 1)), T);
 	}
 
 	template <class T>
-	T *allocate_and_lock() {
+	void publish(T *p_cmd) {
 
-		lock();
-		T *ret;
+		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8;
+		// header is still zero, adding is a full barrier so the command is
+		// visible before it is flagged as ready
+		atomic_add((uint32_t *)((uint8_t *)p_cmd - 8), (alloc_size << HEADER_FLAG_BITS) | HEADER_READY);
+	}
 
-		while ((ret = allocate<T>()) == NULL) {
+	bool pop_one() {
 
-			unlock();
-			// sleep a little until fetch happened and some room is made
-			wait_for_flush();
-			lock();
-		}
+		while (true) {
 
-		return ret;
-	}
+			uint32_t offset = read_pos & (COMMAND_MEM_SIZE - 1);
+			uint32_t header = atomic_compare_and_swap((uint32_t *)&command_mem[offset], 0U, 0U);
 
-	bool flush_one(bool p_lock = true) {
-		if (p_lock) lock();
-	tryagain:
+			if (!(header & HEADER_READY)) {
+				// empty queue, or the next command is still being written
+				return false;
+			}
 
-		// tried to read an empty queue
-		if (read_ptr == write_ptr) {
-			if (p_lock) unlock();
-			return false;
-		}
+			uint32_t alloc_size = header >> HEADER_FLAG_BITS;
+			read_pos += alloc_size;
 
-		uint32_t size_ptr = read_ptr;
-		uint32_t size = *(uint32_t *)&command_mem[read_ptr] >> 1;
+			if (!(header & HEADER_SKIP)) {
 
-		if (size == 0) {
-			//end of ringbuffer, wrap
-			read_ptr = 0;
-			goto tryagain;
-		}
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[offset + 8]);
+				cmd->call();
+				cmd->post();
+				cmd->~CommandBase();
+			}
 
-		read_ptr += 8;
+			// any word may be a header on the next lap, leave it zeroed
+			zeromem(&command_mem[offset], alloc_size);
+			pending_release += alloc_size;
 
-		CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
+			if (!(header & HEADER_SKIP)) {
+				return true;
+			}
+		}
+	}
 
-		read_ptr += size;
+	void release() {
 
-		if (p_lock) unlock();
-		cmd->call();
-		if (p_lock) lock();
+		if (pending_release) {
+			atomic_add(&release_pos, pending_release);
+			pending_release = 0;
+		}
+	}
 
-		cmd->post();
-		cmd->~CommandBase();
-		*(uint32_t *)&command_mem[size_ptr] &= ~1;
+	bool flush_one(bool p_lock = true) {
 
+		if (p_lock) lock();
+		bool flushed = pop_one();
+		release();
 		if (p_lock) unlock();
-		return true;
+		return flushed;
 	}
 
 	void lock();
 	void unlock();
 	void wait_for_flush();
+	void wait_for_publish();
 	SyncSemaphore *_alloc_sync_sem();
-	bool dealloc_one();
 
 public:
 	/* NORMAL PUSH COMMANDS */
@@ -456,18 +464,36 @@ public:
 	void wait_and_flush_one() {
 		ERR_FAIL_COND(!sync);
 		sync->wait();
-		flush_one();
+		// the command was published before the post, but commands reserved
+		// ahead of it by other producers may still be under construction.
+		// Nothing reserved means another flush already ran it.
+		lock();
+		while (!pop_one() && read_pos != write_pos) {
+			unlock();
+			wait_for_publish();
+			lock();
+		}
+		release();
+		unlock();
 	}
 
 	void flush_all() {
 
 		//ERR_FAIL_COND(sync);
 		lock();
-		while (flush_one(false))
-			;
+		while (pop_one()) {
+			// release in batches, producers only need room back once it runs low
+			if (pending_release >= COMMAND_MEM_SIZE / 4) {
+				release();
+			}
+		}
+		release();
 		unlock();
 	}
 
+	static uint32_t get_contended_pushes() { return contended_pushes; }
+	static uint32_t get_stalls() { return stalls; }
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
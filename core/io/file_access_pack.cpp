@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/os/copymem.h"
 #include "core/version.h"
 
 #include <stdio.h>
@@ -54,7 +55,8 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	PathMD5 pmd5(path.md5_buffer());
 	//printf("adding path %ls, %lli, %lli\n", path.c_str(), pmd5.a, pmd5.b);
 
-	bool exists = files.has(pmd5);
+	int pos = _find_file(pmd5);
+	bool exists = pos >= 0;
 
 	PackedFile pf;
 	pf.pack = pkg_path;
@@ -64,10 +66,16 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 		pf.md5[i] = p_md5[i];
 	pf.src = p_src;
 
-	if (!exists || p_replace_files)
-		files[pmd5] = pf;
+	if (exists && p_replace_files) {
+		files.write[pos] = pf;
+	}
 
 	if (!exists) {
+		_reserve_file_index(files.size() + 1);
+		files.push_back(pf);
+		file_md5s.push_back(pmd5);
+		_insert_file_index(pmd5, files.size() - 1);
+
 		//search for dir
 		String p = path.replace_first("res://", "");
 		PackedDir *cd = root;
@@ -98,6 +106,44 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	}
 }
 
+void PackedData::_insert_file_index(const PathMD5 &p_md5, uint32_t p_pos) {
+
+	uint32_t mask = file_index_capacity - 1;
+	uint32_t slot = uint32_t(p_md5.a) & mask;
+	while (file_index[slot]) {
+		slot = (slot + 1) & mask;
+	}
+	file_index[slot] = p_pos + 1;
+}
+
+void PackedData::_reserve_file_index(int p_count) {
+
+	// Keep the index at most half full so probe runs stay short.
+	uint32_t capacity = MAX(file_index_capacity, 16u);
+	while (capacity < uint32_t(p_count) * 2) {
+		capacity <<= 1;
+	}
+	if (capacity == file_index_capacity)
+		return;
+
+	if (file_index)
+		memfree(file_index);
+	file_index = (uint32_t *)memalloc(capacity * sizeof(uint32_t));
+	file_index_capacity = capacity;
+	for (uint32_t i = 0; i < capacity; i++) {
+		file_index[i] = 0;
+	}
+
+	for (int i = 0; i < file_md5s.size(); i++) {
+		_insert_file_index(file_md5s[i], i);
+	}
+}
+
+void PackedData::reserve_paths(int p_count) {
+
+	_reserve_file_index(files.size() + p_count);
+}
+
 void PackedData::add_pack_source(PackSource *p_source) {
 
 	if (p_source != NULL) {
@@ -113,6 +159,8 @@ PackedData::PackedData() {
 	root = memnew(PackedDir);
 	root->parent = NULL;
 	disabled = false;
+	file_index = NULL;
+	file_index_capacity = 0;
 
 	add_pack_source(memnew(PackedSourcePCK));
 }
@@ -130,10 +178,15 @@ PackedData::~PackedData() {
 		memdelete(sources[i]);
 	}
 	_free_packed_dirs(root);
+	if (file_index)
+		memfree(file_index);
 }
 
 //////////////////////////////////////////////////////////////////
 
+PackMapFunc PackedSourcePCK::map_func = NULL;
+PackUnmapFunc PackedSourcePCK::unmap_func = NULL;
+
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files) {
 
 	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
@@ -191,6 +244,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 	}
 
 	int file_count = f->get_32();
+	PackedData::get_singleton()->reserve_paths(file_count);
 
 	for (int i = 0; i < file_count; i++) {
 
@@ -210,6 +264,15 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, p_replace_files);
 	};
 
+	if (map_func) {
+		MappedPack mp;
+		mp.path = p_path;
+		mp.data = map_func(f->get_path_absolute(), &mp.size);
+		if (mp.data) {
+			mapped_packs.push_back(mp);
+		}
+	}
+
 	f->close();
 	memdelete(f);
 	return true;
@@ -217,9 +280,23 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 
+	for (int i = 0; i < mapped_packs.size(); i++) {
+		const MappedPack &mp = mapped_packs[i];
+		if (mp.path == p_file->pack && p_file->offset + p_file->size <= mp.size) {
+			return memnew(FileAccessPack(p_path, *p_file, mp.data + p_file->offset));
+		}
+	}
+
 	return memnew(FileAccessPack(p_path, *p_file));
 };
 
+PackedSourcePCK::~PackedSourcePCK() {
+
+	for (int i = 0; i < mapped_packs.size(); i++) {
+		unmap_func(mapped_packs[i].data, mapped_packs[i].size);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -230,11 +307,17 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 
 void FileAccessPack::close() {
 
+	if (data) {
+		data_open = false;
+		return;
+	}
 	f->close();
 }
 
 bool FileAccessPack::is_open() const {
 
+	if (data)
+		return data_open;
 	return f->is_open();
 }
 
@@ -246,7 +329,8 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(pf.offset + p_position);
+	if (!data)
+		f->seek(pf.offset + p_position);
 	pos = p_position;
 }
 void FileAccessPack::seek_end(int64_t p_position) {
@@ -274,6 +358,9 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (data)
+		return data[pos++];
+
 	pos++;
 	return f->get_8();
 }
@@ -289,18 +376,24 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 		to_read = int64_t(pf.size) - int64_t(pos);
 	}
 
+	size_t from = pos;
 	pos += p_length;
 
 	if (to_read <= 0)
 		return 0;
-	f->get_buffer(p_dst, to_read);
+	if (data) {
+		copymem(p_dst, data + from, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f)
+		f->set_endian_swap(p_swap);
 }
 
 Error FileAccessPack::get_error() const {
@@ -330,15 +423,22 @@ bool FileAccessPack::file_exists(const String &p_name) {
 	return false;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_data) :
 		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		f(NULL),
+		data(p_data),
+		data_open(p_data != NULL) {
 
+	pos = 0;
+	eof = false;
+
+	if (data)
+		return;
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	pos = 0;
-	eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
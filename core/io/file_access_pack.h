@@ -65,15 +65,6 @@ private:
 	struct PathMD5 {
 		uint64_t a;
 		uint64_t b;
-		bool operator<(const PathMD5 &p_md5) const {
-
-			if (p_md5.a == a) {
-				return b < p_md5.b;
-			} else {
-				return a < p_md5.a;
-			}
-		}
-
 		bool operator==(const PathMD5 &p_md5) const {
 			return a == p_md5.a && b == p_md5.b;
 		};
@@ -88,7 +79,17 @@ private:
 		};
 	};
 
-	Map<PathMD5, PackedFile> files;
+	// Flat open-addressing index over `files`, keyed by the path MD5.
+	// Slots hold the file position plus one (zero marks an empty slot),
+	// the capacity is always a power of two and is probed linearly.
+	Vector<PackedFile> files;
+	Vector<PathMD5> file_md5s;
+	uint32_t *file_index;
+	uint32_t file_index_capacity;
+
+	_FORCE_INLINE_ int _find_file(const PathMD5 &p_md5) const;
+	void _insert_file_index(const PathMD5 &p_md5, uint32_t p_pos);
+	void _reserve_file_index(int p_count);
 
 	Vector<PackSource *> sources;
 
@@ -103,6 +104,7 @@ private:
 public:
 	void add_pack_source(PackSource *p_source);
 	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files); // for PackSource
+	void reserve_paths(int p_count); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -125,11 +127,33 @@ public:
 	virtual ~PackSource() {}
 };
 
+typedef const uint8_t *(*PackMapFunc)(const String &p_path, uint64_t *r_size);
+typedef void (*PackUnmapFunc)(const uint8_t *p_data, uint64_t p_size);
+
 class PackedSourcePCK : public PackSource {
 
+	struct MappedPack {
+		String path;
+		const uint8_t *data;
+		uint64_t size;
+	};
+
+	Vector<MappedPack> mapped_packs;
+
+	static PackMapFunc map_func;
+	static PackUnmapFunc unmap_func;
+
 public:
+	// Set by platforms that can map a whole pack into memory, so pack files are read without going through a FileAccess.
+	static void set_map_funcs(PackMapFunc p_map, PackUnmapFunc p_unmap) {
+		map_func = p_map;
+		unmap_func = p_unmap;
+	}
+
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+
+	~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -140,6 +164,8 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 
 	FileAccess *f;
+	const uint8_t *data; // start of the file inside a mapped pack, reads bypass `f` when set
+	bool data_open;
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -171,25 +197,45 @@ public:
 
 	virtual bool file_exists(const String &p_name);
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_data = NULL);
 	~FileAccessPack();
 };
 
+int PackedData::_find_file(const PathMD5 &p_md5) const {
+
+	if (!file_index_capacity)
+		return -1;
+
+	const PathMD5 *md5s = file_md5s.ptr();
+	uint32_t mask = file_index_capacity - 1;
+	uint32_t slot = uint32_t(p_md5.a) & mask;
+
+	while (file_index[slot]) {
+		uint32_t pos = file_index[slot] - 1;
+		if (md5s[pos] == p_md5)
+			return pos;
+		slot = (slot + 1) & mask;
+	}
+
+	return -1;
+}
+
 FileAccess *PackedData::try_open_path(const String &p_path) {
 
-	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E)
+	int pos = _find_file(PathMD5(p_path.md5_buffer()));
+	if (pos < 0)
 		return NULL; //not found
-	if (E->get().offset == 0)
+
+	PackedFile *pf = &files.write[pos];
+	if (pf->offset == 0)
 		return NULL; //was erased
 
-	return E->get().src->get_file(p_path, &E->get());
+	return pf->src->get_file(p_path, pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
 
-	return files.has(PathMD5(p_path.md5_buffer()));
+	return _find_file(PathMD5(p_path.md5_buffer())) >= 0;
 }
 
 class DirAccessPack : public DirAccess {
@@ -629,6 +629,16 @@ Ref<Resource> ResourceInteractiveLoaderBinary::get_resource() {
 
 	return resource;
 }
+String ResourceInteractiveLoaderBinary::_get_external_path(int p_index) const {
+
+	String path = external_resources[p_index].path;
+
+	if (remaps.has(path)) {
+		path = remaps[path];
+	}
+	return path;
+}
+
 Error ResourceInteractiveLoaderBinary::poll() {
 
 	if (error != OK)
@@ -638,12 +648,23 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	if (s < external_resources.size()) {
 
-		String path = external_resources[s].path;
+		if (s == 0 && ResourceLoader::is_load_thread()) {
+			// Already loading in the background, so let the other loader threads
+			// load the dependencies in parallel. They are still collected in order.
+			for (int i = 0; i < external_resources.size(); i++) {
+				external_resources.write[i].requested = ResourceLoader::load_threaded_request(_get_external_path(i), external_resources[i].type) == OK;
+			}
+		}
 
-		if (remaps.has(path)) {
-			path = remaps[path];
+		String path = _get_external_path(s);
+
+		RES res;
+		if (external_resources[s].requested) {
+			external_resources.write[s].requested = false;
+			res = ResourceLoader::load_threaded_get(path);
+		} else {
+			res = ResourceLoader::load(path, external_resources[s].type);
 		}
-		RES res = ResourceLoader::load(path, external_resources[s].type);
 		if (res.is_null()) {
 
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -899,6 +920,7 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 		er.type = get_unicode_string();
 
 		er.path = get_unicode_string();
+		er.requested = false;
 
 		external_resources.push_back(er);
 	}
@@ -971,6 +993,12 @@ ResourceInteractiveLoaderBinary::ResourceInteractiveLoaderBinary() :
 
 ResourceInteractiveLoaderBinary::~ResourceInteractiveLoaderBinary() {
 
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].requested) {
+			ResourceLoader::load_threaded_cancel(_get_external_path(i));
+		}
+	}
+
 	if (f)
 		memdelete(f);
 }
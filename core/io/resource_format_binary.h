@@ -59,6 +59,7 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	struct ExtResource {
 		String path;
 		String type;
+		bool requested; //loading in the background, see poll()
 	};
 
 	Vector<ExtResource> external_resources;
@@ -71,6 +72,7 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	Vector<IntResource> internal_resources;
 
 	String get_unicode_string();
+	String _get_external_path(int p_index) const;
 	void _advance_padding(uint32_t p_len);
 
 	Map<String, String> remaps;
@@ -280,7 +280,7 @@ RES ResourceLoader::_load(const String &p_path, const String &p_original_path, c
 	ERR_FAIL_V_MSG(RES(), "No loader found for resource: " + p_path + ".");
 }
 
-bool ResourceLoader::_add_to_loading_map(const String &p_path) {
+bool ResourceLoader::_add_to_loading_map(const String &p_path, RES *r_loaded) {
 
 	bool success;
 	if (loading_map_mutex) {
@@ -291,10 +291,44 @@ bool ResourceLoader::_add_to_loading_map(const String &p_path) {
 	key.path = p_path;
 	key.thread = Thread::get_caller_id();
 
-	if (loading_map.has(key)) {
+	while (r_loaded && !loading_map.has(key)) {
+
+		ThreadLoadTask **E = thread_load_tasks.getptr(p_path);
+
+		if (E && (*E)->started && (*E)->status == THREAD_LOAD_IN_PROGRESS) {
+			//being loaded in the background, wait for it instead of loading it twice
+			ThreadLoadTask *task = *E;
+			if (_is_waiting_for_caller(task)) {
+				//the task depends on what this thread is loading
+				loading_map_mutex->unlock();
+				return false;
+			}
+
+			task->requests++;
+			_wait_for_task(task);
+
+			*r_loaded = task->resource;
+			task->requests--;
+			if (task->requests == 0) {
+				_free_thread_load_task(task);
+			}
+			break;
+		}
+
+		if (!_is_loading_in_other_thread(p_path)) {
+			break;
+		}
+
+		//being loaded by another thread with load(), wait until it's done and cached
+		_wait_for_other_thread(p_path);
+	}
+
+	if (r_loaded && r_loaded->is_valid()) {
+		success = true;
+	} else if (loading_map.has(key)) {
 		success = false;
 	} else {
-		loading_map[key] = true;
+		loading_map[key] = NULL;
 		success = true;
 	}
 
@@ -314,7 +348,7 @@ void ResourceLoader::_remove_from_loading_map(const String &p_path) {
 	key.path = p_path;
 	key.thread = Thread::get_caller_id();
 
-	loading_map.erase(key);
+	_erase_from_loading_map(key);
 
 	if (loading_map_mutex) {
 		loading_map_mutex->unlock();
@@ -330,13 +364,439 @@ void ResourceLoader::_remove_from_loading_map_and_thread(const String &p_path, T
 	key.path = p_path;
 	key.thread = p_thread;
 
-	loading_map.erase(key);
+	_erase_from_loading_map(key);
 
 	if (loading_map_mutex) {
 		loading_map_mutex->unlock();
 	}
 }
 
+void ResourceLoader::_erase_from_loading_map(const LoadingMapKey &p_key) {
+
+	LoadingMapWait **W = loading_map.getptr(p_key);
+	if (!W) {
+		return;
+	}
+
+	if (*W) {
+		//the last waiter to wake up frees it
+		for (int i = 0; i < (*W)->waiters; i++) {
+			(*W)->semaphore->post();
+		}
+	}
+
+	loading_map.erase(p_key);
+}
+
+void ResourceLoader::_wait_for_other_thread(const String &p_path) {
+
+	//called with loading_map_mutex locked, returns once the other thread removed the path from the map
+	Thread::ID caller = Thread::get_caller_id();
+	const LoadingMapKey *K = NULL;
+	while ((K = loading_map.next(K))) {
+		if (K->path == p_path && K->thread != caller) {
+			break;
+		}
+	}
+
+	if (!K) {
+		return;
+	}
+
+	LoadingMapWait *&entry = loading_map[*K];
+	if (!entry) {
+		entry = memnew(LoadingMapWait);
+		entry->semaphore = Semaphore::create();
+		entry->waiters = 0;
+	}
+
+	LoadingMapWait *wait = entry;
+	wait->waiters++;
+
+	loading_map_mutex->unlock();
+	wait->semaphore->wait();
+	loading_map_mutex->lock();
+
+	wait->waiters--;
+	if (wait->waiters == 0) {
+		memdelete(wait->semaphore);
+		memdelete(wait);
+	}
+}
+
+bool ResourceLoader::_is_waiting_for_caller(ThreadLoadTask *p_task) {
+
+	//follows the tasks the threads are blocked on, waiting would deadlock if it leads back to the caller
+	Thread::ID caller = Thread::get_caller_id();
+	ThreadLoadTask *task = p_task;
+	for (int i = 0; i <= thread_load_waits.size() && task->started; i++) {
+		if (task->thread == caller) {
+			return true;
+		}
+
+		ThreadLoadTask **W = thread_load_waits.getptr(task->thread);
+		if (!W) {
+			return false;
+		}
+		task = *W;
+	}
+
+	return false;
+}
+
+void ResourceLoader::_wait_for_task(ThreadLoadTask *p_task) {
+
+	//called with loading_map_mutex locked, returns once the task is done
+	Thread::ID caller = Thread::get_caller_id();
+	thread_load_waits[caller] = p_task;
+	p_task->waiters++;
+
+	loading_map_mutex->unlock();
+	p_task->done->wait();
+	loading_map_mutex->lock();
+
+	thread_load_waits.erase(caller);
+}
+
+bool ResourceLoader::_is_loading_in_other_thread(const String &p_path) {
+
+	Thread::ID caller = Thread::get_caller_id();
+	const LoadingMapKey *K = NULL;
+	while ((K = loading_map.next(K))) {
+		if (K->path == p_path && K->thread != caller) {
+			return true;
+		}
+	}
+	return false;
+}
+
+String ResourceLoader::_localize_path(const String &p_path) {
+
+	if (p_path.is_rel_path())
+		return "res://" + p_path;
+	return ProjectSettings::get_singleton()->localize_path(p_path);
+}
+
+void ResourceLoader::_start_thread_load_workers() {
+
+	if (thread_load_workers.size() || !thread_load_semaphore) {
+		return;
+	}
+
+	int thread_count = GLOBAL_GET("application/run/resource_loader_threads");
+	if (thread_count <= 0) {
+		thread_count = MAX(1, OS::get_singleton()->get_processor_count() - 1);
+	}
+
+	for (int i = 0; i < thread_count; i++) {
+		Thread *thread = Thread::create(_thread_load_function, NULL);
+		thread_load_workers.push_back(thread);
+		thread_load_worker_ids.push_back(thread->get_id());
+	}
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_pop_thread_load_task() {
+
+	//highest priority first, then in request order
+	List<ThreadLoadTask *>::Element *best = NULL;
+	for (List<ThreadLoadTask *>::Element *E = thread_load_queue.front(); E; E = E->next()) {
+		if (!best || E->get()->priority > best->get()->priority) {
+			best = E;
+		}
+	}
+
+	if (!best) {
+		return NULL;
+	}
+
+	ThreadLoadTask *task = best->get();
+	thread_load_queue.erase(best);
+	task->started = true;
+	task->thread = Thread::get_caller_id();
+	return task;
+}
+
+void ResourceLoader::_run_thread_load_task(ThreadLoadTask *p_task) {
+
+	{
+		//a thread loading it with load() got there first, once it's done it will be cached
+		MutexLock lock(loading_map_mutex);
+		while (_is_loading_in_other_thread(p_task->local_path)) {
+			_wait_for_other_thread(p_task->local_path);
+		}
+	}
+
+	Error err = OK;
+	RES res;
+	Ref<ResourceInteractiveLoader> ril = load_interactive(p_task->local_path, p_task->type_hint, false, &err);
+
+	if (ril.is_valid()) {
+
+		int stage_count = MAX(ril->get_stage_count(), 1);
+
+		while (true) {
+
+			err = ril->poll();
+
+			if (err == ERR_FILE_EOF) {
+				err = OK;
+				res = ril->get_resource();
+				break;
+			}
+
+			if (err != OK) {
+				break;
+			}
+
+			MutexLock lock(loading_map_mutex);
+			p_task->progress = MIN(float(ril->get_stage()) / stage_count, 1.0);
+			if (p_task->cancelled) {
+				err = ERR_SKIP;
+				break;
+			}
+		}
+
+		ril.unref(); //leave the loading map before waking up anyone
+	} else if (err == OK) {
+		err = ERR_CANT_OPEN;
+	}
+
+	MutexLock lock(loading_map_mutex);
+
+	if (err == ERR_SKIP && !p_task->cancelled) {
+		//requested again while it was being cancelled, start over
+		p_task->started = false;
+		p_task->thread = 0;
+		p_task->progress = 0;
+		thread_load_queue.push_back(p_task);
+		thread_load_semaphore->post();
+		return;
+	}
+
+	p_task->resource = res;
+	p_task->error = err;
+	p_task->status = res.is_valid() ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+	p_task->progress = 1.0;
+
+	while (p_task->waiters) {
+		p_task->waiters--;
+		p_task->done->post();
+	}
+
+	if (p_task->requests == 0) {
+		_free_thread_load_task(p_task);
+	}
+}
+
+void ResourceLoader::_free_thread_load_task(ThreadLoadTask *p_task) {
+
+	thread_load_tasks.erase(p_task->local_path);
+	if (!p_task->started) {
+		thread_load_queue.erase(p_task);
+	}
+	if (p_task->done) {
+		memdelete(p_task->done);
+	}
+	memdelete(p_task);
+}
+
+void ResourceLoader::_thread_load_function(void *p_userdata) {
+
+	while (true) {
+
+		thread_load_semaphore->wait();
+
+		ThreadLoadTask *task;
+		{
+			MutexLock lock(loading_map_mutex);
+			if (thread_load_exit) {
+				break;
+			}
+			task = _pop_thread_load_task();
+		}
+
+		if (task) {
+			_run_thread_load_task(task);
+		}
+	}
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, int p_priority) {
+
+	String local_path = _localize_path(p_path);
+
+	ThreadLoadTask *task;
+	{
+		MutexLock lock(loading_map_mutex);
+
+		ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+		if (E) {
+			//already requested, share it
+			task = *E;
+			task->requests++;
+			task->cancelled = false;
+			task->priority = MAX(task->priority, p_priority);
+			return OK;
+		}
+
+		task = memnew(ThreadLoadTask);
+		task->local_path = local_path;
+		task->type_hint = p_type_hint;
+		task->priority = p_priority;
+		task->status = THREAD_LOAD_IN_PROGRESS;
+		task->error = OK;
+		task->progress = 0;
+		task->requests = 1;
+		task->waiters = 0;
+		task->started = false;
+		task->cancelled = false;
+		task->thread = 0;
+		task->done = Semaphore::create();
+
+		thread_load_tasks[local_path] = task;
+
+		_start_thread_load_workers();
+
+		if (thread_load_workers.size()) {
+			thread_load_queue.push_back(task);
+			thread_load_semaphore->post();
+			return OK;
+		}
+
+		task->started = true;
+		task->thread = Thread::get_caller_id();
+	}
+
+	//no threads, load it right away
+	_run_thread_load_task(task);
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+
+	String local_path = _localize_path(p_path);
+
+	MutexLock lock(loading_map_mutex);
+
+	ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+	if (!E) {
+		if (r_progress)
+			*r_progress = 0;
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	if (r_progress)
+		*r_progress = (*E)->progress;
+
+	return (*E)->status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+
+	if (r_error)
+		*r_error = ERR_INVALID_PARAMETER;
+
+	String local_path = _localize_path(p_path);
+
+	ThreadLoadTask *task;
+	bool run_here = false;
+	{
+		MutexLock lock(loading_map_mutex);
+
+		ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+		ERR_FAIL_COND_V_MSG(!E, RES(), "Resource '" + local_path + "' was not requested with load_threaded_request().");
+
+		task = *E;
+
+		if (!task->started) {
+			//not picked up by a worker yet, load it here rather than waiting for one
+			thread_load_queue.erase(task);
+			task->started = true;
+			task->thread = Thread::get_caller_id();
+			run_here = true;
+		} else if (task->status == THREAD_LOAD_IN_PROGRESS) {
+			if (_is_waiting_for_caller(task)) {
+				//cyclic dependency, it's loaded by this thread further up or by one waiting for it
+				task->requests--;
+				if (r_error)
+					*r_error = ERR_CYCLIC_LINK;
+				ERR_FAIL_V_MSG(RES(), "Resource '" + local_path + "' depends on itself, can't wait for it to finish loading.");
+			}
+			_wait_for_task(task);
+		}
+	}
+
+	if (run_here) {
+		_run_thread_load_task(task);
+	}
+
+	MutexLock lock(loading_map_mutex);
+
+	RES res = task->resource;
+	if (r_error)
+		*r_error = task->error;
+
+	task->requests--;
+	if (task->requests == 0) {
+		_free_thread_load_task(task);
+	}
+
+	return res;
+}
+
+void ResourceLoader::load_threaded_cancel(const String &p_path) {
+
+	String local_path = _localize_path(p_path);
+
+	MutexLock lock(loading_map_mutex);
+
+	ThreadLoadTask **E = thread_load_tasks.getptr(local_path);
+	ERR_FAIL_COND_MSG(!E, "Resource '" + local_path + "' was not requested with load_threaded_request().");
+
+	ThreadLoadTask *task = *E;
+	task->requests--;
+	if (task->requests > 0) {
+		return;
+	}
+
+	if (task->started && task->status == THREAD_LOAD_IN_PROGRESS) {
+		//stopped and freed by the thread loading it
+		task->cancelled = true;
+	} else {
+		_free_thread_load_task(task);
+	}
+}
+
+bool ResourceLoader::is_load_thread() {
+
+	MutexLock lock(loading_map_mutex);
+	return thread_load_worker_ids.find(Thread::get_caller_id()) != -1;
+}
+
+void ResourceLoader::finish_threaded_loading() {
+
+	{
+		MutexLock lock(loading_map_mutex);
+		thread_load_exit = true;
+	}
+
+	for (int i = 0; i < thread_load_workers.size(); i++) {
+		thread_load_semaphore->post();
+	}
+	for (int i = 0; i < thread_load_workers.size(); i++) {
+		Thread::wait_to_finish(thread_load_workers[i]);
+		memdelete(thread_load_workers[i]);
+	}
+	thread_load_workers.clear();
+	thread_load_worker_ids.clear();
+	thread_load_exit = false;
+
+	//loaded but never retrieved
+	while (thread_load_tasks.size()) {
+		_free_thread_load_task(thread_load_tasks.get(*thread_load_tasks.next(NULL)));
+	}
+}
+
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
 	if (r_error)
@@ -351,8 +811,15 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	if (!p_no_cache) {
 
 		{
-			bool success = _add_to_loading_map(local_path);
+			RES loaded;
+			bool success = _add_to_loading_map(local_path, &loaded);
 			ERR_FAIL_COND_V_MSG(!success, RES(), "Resource: '" + local_path + "' is already being loaded. Cyclic reference?");
+
+			if (loaded.is_valid()) {
+				if (r_error)
+					*r_error = OK;
+				return loaded;
+			}
 		}
 
 		//lock first if possible
@@ -973,16 +1440,29 @@ void ResourceLoader::remove_custom_loaders() {
 }
 
 Mutex *ResourceLoader::loading_map_mutex = NULL;
-HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
+HashMap<ResourceLoader::LoadingMapKey, ResourceLoader::LoadingMapWait *, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
+
+HashMap<String, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_tasks;
+List<ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_queue;
+Vector<Thread *> ResourceLoader::thread_load_workers;
+Vector<Thread::ID> ResourceLoader::thread_load_worker_ids;
+HashMap<Thread::ID, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_waits;
+Semaphore *ResourceLoader::thread_load_semaphore = NULL;
+bool ResourceLoader::thread_load_exit = false;
 
 void ResourceLoader::initialize() {
 #ifndef NO_THREADS
 	loading_map_mutex = Mutex::create();
+	thread_load_semaphore = Semaphore::create();
 #endif
 }
 
 void ResourceLoader::finalize() {
 #ifndef NO_THREADS
+	finish_threaded_loading();
+	memdelete(thread_load_semaphore);
+	thread_load_semaphore = NULL;
+
 	const LoadingMapKey *K = NULL;
 	while ((K = loading_map.next(K))) {
 		ERR_PRINTS("Exited while resource is being loaded: " + K->path);
@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
 
@@ -91,6 +92,15 @@ typedef void (*ResourceLoadedCallback)(RES p_resource, const String &p_path);
 
 class ResourceLoader {
 
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
+private:
 	enum {
 		MAX_LOADERS = 64
 	};
@@ -135,17 +145,67 @@ class ResourceLoader {
 		static _FORCE_INLINE_ uint32_t hash(const LoadingMapKey &p_key) { return p_key.path.hash() + HashMapHasherDefault::hash(p_key.thread); }
 	};
 
-	static HashMap<LoadingMapKey, int, LoadingMapKeyHasher> loading_map;
+	//threads waiting for a path loaded by another thread sleep on its entry, created on demand
+	struct LoadingMapWait {
+		Semaphore *semaphore;
+		int waiters;
+	};
+
+	static HashMap<LoadingMapKey, LoadingMapWait *, LoadingMapKeyHasher> loading_map;
 
-	static bool _add_to_loading_map(const String &p_path);
+	static bool _add_to_loading_map(const String &p_path, RES *r_loaded = NULL);
 	static void _remove_from_loading_map(const String &p_path);
 	static void _remove_from_loading_map_and_thread(const String &p_path, Thread::ID p_thread);
+	static void _erase_from_loading_map(const LoadingMapKey &p_key);
+	static void _wait_for_other_thread(const String &p_path);
+
+	//background loads requested with load_threaded_request(), guarded by loading_map_mutex
+	struct ThreadLoadTask {
+		String local_path;
+		String type_hint;
+		int priority;
+		ThreadLoadStatus status;
+		Error error;
+		RES resource;
+		float progress;
+		int requests; //each request is balanced by a get or a cancel, the task is freed at zero
+		int waiters;
+		bool started;
+		bool cancelled;
+		Thread::ID thread; //the thread running it, which may be running other tasks it depends on inline
+		Semaphore *done;
+	};
+
+	static HashMap<String, ThreadLoadTask *> thread_load_tasks;
+	static List<ThreadLoadTask *> thread_load_queue;
+	static Vector<Thread *> thread_load_workers;
+	static Vector<Thread::ID> thread_load_worker_ids;
+	static HashMap<Thread::ID, ThreadLoadTask *> thread_load_waits; //the task each blocked thread waits for
+	static Semaphore *thread_load_semaphore;
+	static bool thread_load_exit;
+
+	static String _localize_path(const String &p_path);
+	static void _thread_load_function(void *p_userdata);
+	static void _start_thread_load_workers();
+	static ThreadLoadTask *_pop_thread_load_task();
+	static void _run_thread_load_task(ThreadLoadTask *p_task);
+	static void _free_thread_load_task(ThreadLoadTask *p_task);
+	static bool _is_loading_in_other_thread(const String &p_path);
+	static bool _is_waiting_for_caller(ThreadLoadTask *p_task);
+	static void _wait_for_task(ThreadLoadTask *p_task);
 
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", int p_priority = 0);
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = NULL);
+	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
+	static void load_threaded_cancel(const String &p_path);
+	static bool is_load_thread();
+	static void finish_threaded_loading();
+
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
 	static void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front = false);
 	static void remove_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader);
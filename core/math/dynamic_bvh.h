@@ -0,0 +1,976 @@
+/*************************************************************************/
+/*  dynamic_bvh.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef DYNAMIC_BVH_H
+#define DYNAMIC_BVH_H
+
+#include "core/math/aabb.h"
+#include "core/math/vector3.h"
+#include "core/os/memory.h"
+#include "core/vector.h"
+
+/**
+ * Dynamic AABB tree, usable in place of Octree (same create/move/cull/pairing API).
+ *
+ * Nodes live in a flat array and are referenced by index. Leaves are inserted
+ * using a surface area heuristic and the tree is kept balanced with rotations.
+ * Leaves store a fattened AABB, so elements that move a little stay where they
+ * are and only have their exact AABB updated.
+ *
+ * Element IDs are never 0, so 0 can keep meaning "not in the tree" for users.
+ */
+
+typedef uint32_t DynamicBVHElementID;
+
+template <class T, bool use_pairs = false>
+class DynamicBVH {
+public:
+	typedef void *(*PairCallback)(void *, DynamicBVHElementID, T *, int, DynamicBVHElementID, T *, int);
+	typedef void (*UnpairCallback)(void *, DynamicBVHElementID, T *, int, DynamicBVHElementID, T *, int, void *);
+
+private:
+	enum {
+		NULL_NODE = -1,
+		NULL_ELEMENT = 0xFFFFFFFF,
+		STACK_SIZE = 128, // the tree is balanced, its height stays far below this
+	};
+
+	struct Node {
+
+		AABB aabb; // fattened for leaves
+		int32_t parent; // next free node while in the free list
+		int32_t children[2];
+		int32_t height; // 0 for leaves, -1 while free
+		uint32_t element;
+
+		_FORCE_INLINE_ bool is_leaf() const { return children[0] == NULL_NODE; }
+	};
+
+	struct Pair {
+
+		uint32_t other; // element index of the other side
+		uint32_t other_index; // index of the mirrored entry in the other side's pair list
+		void *ud;
+	};
+
+	struct Element {
+
+		T *userdata;
+		AABB aabb;
+		int32_t node; // NULL_NODE while not in the tree (no surface)
+		int subindex;
+		bool in_use;
+		bool pairable;
+		uint32_t pairable_type;
+		uint32_t pairable_mask;
+		uint32_t next_free;
+		uint64_t last_pass;
+
+		Vector<Pair> pairs;
+	};
+
+	Node *nodes;
+	int32_t node_capacity;
+	int32_t node_count;
+	int32_t free_node;
+	int32_t root;
+
+	Element *elements;
+	uint32_t element_capacity;
+	uint32_t element_count;
+	uint32_t free_element;
+
+	uint64_t pass;
+	int pair_count;
+	int pairable_count; // when zero, non pairable elements have nothing to pair with
+	real_t fat_margin;
+
+	PairCallback pair_callback;
+	UnpairCallback unpair_callback;
+	void *pair_callback_userdata;
+	void *unpair_callback_userdata;
+
+	_FORCE_INLINE_ static real_t _get_area(const AABB &p_aabb) {
+		// half the surface area, good enough to compare costs
+		return p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x;
+	}
+
+	_FORCE_INLINE_ static AABB _merge(const AABB &p_a, const AABB &p_b) {
+
+		Vector3 min(MIN(p_a.position.x, p_b.position.x), MIN(p_a.position.y, p_b.position.y), MIN(p_a.position.z, p_b.position.z));
+		Vector3 end_a = p_a.position + p_a.size;
+		Vector3 end_b = p_b.position + p_b.size;
+		Vector3 max(MAX(end_a.x, end_b.x), MAX(end_a.y, end_b.y), MAX(end_a.z, end_b.z));
+		return AABB(min, max - min);
+	}
+
+	_FORCE_INLINE_ static uint32_t _id_to_index(DynamicBVHElementID p_id) { return p_id - 1; }
+	_FORCE_INLINE_ static DynamicBVHElementID _index_to_id(uint32_t p_index) { return p_index + 1; }
+
+	_FORCE_INLINE_ Element *_get_element(DynamicBVHElementID p_id) const {
+
+		uint32_t index = _id_to_index(p_id);
+		ERR_FAIL_COND_V(p_id == 0 || index >= element_count || !elements[index].in_use, NULL);
+		return &elements[index];
+	}
+
+	int32_t _allocate_node();
+	void _free_node(int32_t p_node);
+	void _insert_leaf(int32_t p_leaf);
+	void _remove_leaf(int32_t p_leaf);
+	int32_t _balance(int32_t p_node);
+
+	void _insert_element(uint32_t p_element);
+	void _remove_element(uint32_t p_element);
+
+	_FORCE_INLINE_ bool _can_pair(const Element &p_a, const Element &p_b) const {
+
+		if (&p_a == &p_b || (p_a.userdata == p_b.userdata && p_a.userdata))
+			return false;
+		if (!p_a.pairable && !p_b.pairable)
+			return false; // non pairable elements only pair against pairable ones
+		return (p_a.pairable_type & p_b.pairable_mask) || (p_b.pairable_type & p_a.pairable_mask);
+	}
+
+	void _pair_remove_entry(uint32_t p_element, int p_index);
+	void _unpair(uint32_t p_element, int p_index);
+	void _unpair_all(uint32_t p_element);
+	void _update_pairs(uint32_t p_element);
+
+	template <class Q>
+	int _cull(const Q &p_query, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const;
+	void _cull_subtree(int32_t p_node, T **p_result_array, int &r_count, int p_result_max, uint32_t p_mask) const;
+
+	struct _AABBQuery {
+		AABB aabb;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return aabb.intersects_inclusive(p_aabb); }
+	};
+
+	struct _SegmentQuery {
+		Vector3 from;
+		Vector3 to;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.intersects_segment(from, to); }
+	};
+
+	struct _PointQuery {
+		Vector3 point;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.has_point(point); }
+	};
+
+public:
+	DynamicBVHElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void move(DynamicBVHElementID p_id, const AABB &p_aabb);
+	void set_pairable(DynamicBVHElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void erase(DynamicBVHElementID p_id);
+
+	bool is_pairable(DynamicBVHElementID p_id) const;
+	T *get(DynamicBVHElementID p_id) const;
+	int get_subindex(DynamicBVHElementID p_id) const;
+
+	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+	void set_pair_callback(PairCallback p_callback, void *p_userdata);
+	void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+	void set_fat_margin(real_t p_margin) { fat_margin = p_margin; }
+	real_t get_fat_margin() const { return fat_margin; }
+
+	int get_node_count() const { return node_count; }
+	int get_pair_count() const { return pair_count; }
+	int get_height() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+	DynamicBVH(real_t p_fat_margin = 0.1);
+	~DynamicBVH();
+};
+
+/* TREE */
+
+template <class T, bool use_pairs>
+int32_t DynamicBVH<T, use_pairs>::_allocate_node() {
+
+	if (free_node == NULL_NODE) {
+
+		int32_t new_capacity = node_capacity ? node_capacity * 2 : 16;
+		nodes = (Node *)memrealloc(nodes, sizeof(Node) * new_capacity);
+
+		for (int32_t i = node_capacity; i < new_capacity; i++) {
+			nodes[i].parent = i + 1 < new_capacity ? i + 1 : (int32_t)NULL_NODE;
+			nodes[i].height = -1;
+		}
+		free_node = node_capacity;
+		node_capacity = new_capacity;
+	}
+
+	int32_t node = free_node;
+	free_node = nodes[node].parent;
+
+	Node &n = nodes[node];
+	n.parent = NULL_NODE;
+	n.children[0] = NULL_NODE;
+	n.children[1] = NULL_NODE;
+	n.height = 0;
+	n.element = NULL_ELEMENT;
+	node_count++;
+
+	return node;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_free_node(int32_t p_node) {
+
+	nodes[p_node].parent = free_node;
+	nodes[p_node].height = -1;
+	free_node = p_node;
+	node_count--;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_insert_leaf(int32_t p_leaf) {
+
+	if (root == NULL_NODE) {
+		root = p_leaf;
+		nodes[root].parent = NULL_NODE;
+		return;
+	}
+
+	// find the best sibling, descending where the cost of adding the leaf grows the least
+	AABB leaf_aabb = nodes[p_leaf].aabb;
+	int32_t index = root;
+
+	while (!nodes[index].is_leaf()) {
+
+		const Node &n = nodes[index];
+
+		real_t area = _get_area(n.aabb);
+		real_t combined_area = _get_area(_merge(n.aabb, leaf_aabb));
+
+		// cost of creating a new parent for this node and the new leaf
+		real_t cost = 2.0 * combined_area;
+		// minimum cost of pushing the leaf further down the tree
+		real_t inheritance_cost = 2.0 * (combined_area - area);
+
+		real_t child_cost[2];
+		for (int i = 0; i < 2; i++) {
+
+			const Node &child = nodes[n.children[i]];
+			real_t merged_area = _get_area(_merge(leaf_aabb, child.aabb));
+			if (child.is_leaf()) {
+				child_cost[i] = merged_area + inheritance_cost;
+			} else {
+				child_cost[i] = (merged_area - _get_area(child.aabb)) + inheritance_cost;
+			}
+		}
+
+		if (cost < child_cost[0] && cost < child_cost[1]) {
+			break;
+		}
+
+		index = child_cost[0] < child_cost[1] ? n.children[0] : n.children[1];
+	}
+
+	int32_t sibling = index;
+	int32_t old_parent = nodes[sibling].parent;
+	int32_t new_parent = _allocate_node(); // may reallocate nodes, don't keep references across this
+
+	nodes[new_parent].parent = old_parent;
+	nodes[new_parent].aabb = _merge(leaf_aabb, nodes[sibling].aabb);
+	nodes[new_parent].height = nodes[sibling].height + 1;
+	nodes[new_parent].children[0] = sibling;
+	nodes[new_parent].children[1] = p_leaf;
+	nodes[sibling].parent = new_parent;
+	nodes[p_leaf].parent = new_parent;
+
+	if (old_parent != NULL_NODE) {
+		if (nodes[old_parent].children[0] == sibling) {
+			nodes[old_parent].children[0] = new_parent;
+		} else {
+			nodes[old_parent].children[1] = new_parent;
+		}
+	} else {
+		root = new_parent;
+	}
+
+	// walk back up, fixing heights and bounds
+	index = nodes[p_leaf].parent;
+	while (index != NULL_NODE) {
+
+		index = _balance(index);
+
+		int32_t child0 = nodes[index].children[0];
+		int32_t child1 = nodes[index].children[1];
+
+		nodes[index].height = 1 + MAX(nodes[child0].height, nodes[child1].height);
+		nodes[index].aabb = _merge(nodes[child0].aabb, nodes[child1].aabb);
+
+		index = nodes[index].parent;
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_remove_leaf(int32_t p_leaf) {
+
+	if (p_leaf == root) {
+		root = NULL_NODE;
+		return;
+	}
+
+	int32_t parent = nodes[p_leaf].parent;
+	int32_t grand_parent = nodes[parent].parent;
+	int32_t sibling = nodes[parent].children[0] == p_leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	if (grand_parent != NULL_NODE) {
+
+		// the sibling takes the place of the parent
+		if (nodes[grand_parent].children[0] == parent) {
+			nodes[grand_parent].children[0] = sibling;
+		} else {
+			nodes[grand_parent].children[1] = sibling;
+		}
+		nodes[sibling].parent = grand_parent;
+		_free_node(parent);
+
+		int32_t index = grand_parent;
+		while (index != NULL_NODE) {
+
+			index = _balance(index);
+
+			int32_t child0 = nodes[index].children[0];
+			int32_t child1 = nodes[index].children[1];
+
+			nodes[index].aabb = _merge(nodes[child0].aabb, nodes[child1].aabb);
+			nodes[index].height = 1 + MAX(nodes[child0].height, nodes[child1].height);
+
+			index = nodes[index].parent;
+		}
+	} else {
+
+		root = sibling;
+		nodes[sibling].parent = NULL_NODE;
+		_free_node(parent);
+	}
+}
+
+// Rotates the tree at p_node if it is imbalanced, returns the node now in its place.
+template <class T, bool use_pairs>
+int32_t DynamicBVH<T, use_pairs>::_balance(int32_t p_node) {
+
+	Node *A = &nodes[p_node];
+	if (A->is_leaf() || A->height < 2) {
+		return p_node;
+	}
+
+	int32_t iB = A->children[0];
+	int32_t iC = A->children[1];
+	Node *B = &nodes[iB];
+	Node *C = &nodes[iC];
+
+	int32_t balance = C->height - B->height;
+
+	if (balance > 1) {
+
+		// rotate C up
+		int32_t iF = C->children[0];
+		int32_t iG = C->children[1];
+		Node *F = &nodes[iF];
+		Node *G = &nodes[iG];
+
+		C->children[0] = p_node;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		if (C->parent != NULL_NODE) {
+			if (nodes[C->parent].children[0] == p_node) {
+				nodes[C->parent].children[0] = iC;
+			} else {
+				nodes[C->parent].children[1] = iC;
+			}
+		} else {
+			root = iC;
+		}
+
+		if (F->height > G->height) {
+			C->children[1] = iF;
+			A->children[1] = iG;
+			G->parent = p_node;
+			A->aabb = _merge(B->aabb, G->aabb);
+			C->aabb = _merge(A->aabb, F->aabb);
+			A->height = 1 + MAX(B->height, G->height);
+			C->height = 1 + MAX(A->height, F->height);
+		} else {
+			C->children[1] = iG;
+			A->children[1] = iF;
+			F->parent = p_node;
+			A->aabb = _merge(B->aabb, F->aabb);
+			C->aabb = _merge(A->aabb, G->aabb);
+			A->height = 1 + MAX(B->height, F->height);
+			C->height = 1 + MAX(A->height, G->height);
+		}
+
+		return iC;
+	}
+
+	if (balance < -1) {
+
+		// rotate B up
+		int32_t iD = B->children[0];
+		int32_t iE = B->children[1];
+		Node *D = &nodes[iD];
+		Node *E = &nodes[iE];
+
+		B->children[0] = p_node;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		if (B->parent != NULL_NODE) {
+			if (nodes[B->parent].children[0] == p_node) {
+				nodes[B->parent].children[0] = iB;
+			} else {
+				nodes[B->parent].children[1] = iB;
+			}
+		} else {
+			root = iB;
+		}
+
+		if (D->height > E->height) {
+			B->children[1] = iD;
+			A->children[0] = iE;
+			E->parent = p_node;
+			A->aabb = _merge(C->aabb, E->aabb);
+			B->aabb = _merge(A->aabb, D->aabb);
+			A->height = 1 + MAX(C->height, E->height);
+			B->height = 1 + MAX(A->height, D->height);
+		} else {
+			B->children[1] = iE;
+			A->children[0] = iD;
+			D->parent = p_node;
+			A->aabb = _merge(C->aabb, D->aabb);
+			B->aabb = _merge(A->aabb, E->aabb);
+			A->height = 1 + MAX(C->height, D->height);
+			B->height = 1 + MAX(A->height, E->height);
+		}
+
+		return iB;
+	}
+
+	return p_node;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_insert_element(uint32_t p_element) {
+
+	int32_t leaf = _allocate_node();
+	Element &e = elements[p_element];
+
+	nodes[leaf].aabb = e.aabb.grow(fat_margin);
+	nodes[leaf].element = p_element;
+	e.node = leaf;
+
+	_insert_leaf(leaf);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_remove_element(uint32_t p_element) {
+
+	Element &e = elements[p_element];
+
+	_remove_leaf(e.node);
+	_free_node(e.node);
+	e.node = NULL_NODE;
+}
+
+/* PAIRS */
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_pair_remove_entry(uint32_t p_element, int p_index) {
+
+	Vector<Pair> &pairs = elements[p_element].pairs;
+	int last = pairs.size() - 1;
+
+	if (p_index != last) {
+		// move the last entry into the hole, and tell its mirror where it went
+		Pair moved = pairs[last];
+		pairs.write[p_index] = moved;
+		elements[moved.other].pairs.write[moved.other_index].other_index = p_index;
+	}
+
+	pairs.resize(last);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_unpair(uint32_t p_element, int p_index) {
+
+	Pair pair = elements[p_element].pairs[p_index];
+	const Element &a = elements[p_element];
+	const Element &b = elements[pair.other];
+
+	if (unpair_callback) {
+		unpair_callback(unpair_callback_userdata, _index_to_id(p_element), a.userdata, a.subindex, _index_to_id(pair.other), b.userdata, b.subindex, pair.ud);
+	}
+	pair_count--;
+
+	_pair_remove_entry(pair.other, pair.other_index);
+	_pair_remove_entry(p_element, p_index);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_unpair_all(uint32_t p_element) {
+
+	while (elements[p_element].pairs.size()) {
+		_unpair(p_element, elements[p_element].pairs.size() - 1);
+	}
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_update_pairs(uint32_t p_element) {
+
+	Element &e = elements[p_element];
+
+	// drop pairs that stopped overlapping (or can no longer pair at all)
+	pass++;
+	for (int i = 0; i < e.pairs.size();) {
+
+		Element &other = elements[e.pairs[i].other];
+		if (e.node == NULL_NODE || !_can_pair(e, other) || !e.aabb.intersects_inclusive(other.aabb)) {
+			_unpair(p_element, i);
+		} else {
+			other.last_pass = pass; // already paired, skip below
+			i++;
+		}
+	}
+
+	if (e.node == NULL_NODE || (!e.pairable && pairable_count == 0)) {
+		return;
+	}
+
+	// then find the new ones
+	int32_t stack[STACK_SIZE];
+	int sp = 0;
+	stack[sp++] = root;
+
+	while (sp) {
+
+		int32_t index = stack[--sp];
+		const Node &n = nodes[index];
+
+		if (!n.aabb.intersects_inclusive(e.aabb)) {
+			continue;
+		}
+
+		if (!n.is_leaf()) {
+			ERR_FAIL_COND(sp + 2 > STACK_SIZE);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+			continue;
+		}
+
+		Element &other = elements[n.element];
+		if (other.last_pass == pass || !_can_pair(e, other) || !e.aabb.intersects_inclusive(other.aabb)) {
+			continue;
+		}
+
+		Pair pair;
+		pair.ud = NULL;
+		if (pair_callback) {
+			pair.ud = pair_callback(pair_callback_userdata, _index_to_id(p_element), e.userdata, e.subindex, _index_to_id(n.element), other.userdata, other.subindex);
+		}
+		pair_count++;
+
+		pair.other = n.element;
+		pair.other_index = other.pairs.size();
+		e.pairs.push_back(pair);
+
+		pair.other = p_element;
+		pair.other_index = e.pairs.size() - 1;
+		other.pairs.push_back(pair);
+	}
+}
+
+/* CULLING */
+
+template <class T, bool use_pairs>
+template <class Q>
+int DynamicBVH<T, use_pairs>::_cull(const Q &p_query, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const {
+
+	if (root == NULL_NODE) {
+		return 0;
+	}
+
+	int count = 0;
+	int32_t stack[STACK_SIZE];
+	int sp = 0;
+	stack[sp++] = root;
+
+	while (sp && count < p_result_max) {
+
+		const Node &n = nodes[stack[--sp]];
+
+		if (!p_query.test(n.aabb)) {
+			continue;
+		}
+
+		if (!n.is_leaf()) {
+			ERR_FAIL_COND_V(sp + 2 > STACK_SIZE, count);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+			continue;
+		}
+
+		const Element &e = elements[n.element];
+		if ((use_pairs && !(e.pairable_type & p_mask)) || !p_query.test(e.aabb)) {
+			continue;
+		}
+
+		p_result_array[count] = e.userdata;
+		if (p_subindex_array) {
+			p_subindex_array[count] = e.subindex;
+		}
+		count++;
+	}
+
+	return count;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::_cull_subtree(int32_t p_node, T **p_result_array, int &r_count, int p_result_max, uint32_t p_mask) const {
+
+	int32_t stack[STACK_SIZE];
+	int sp = 0;
+	stack[sp++] = p_node;
+
+	while (sp && r_count < p_result_max) {
+
+		const Node &n = nodes[stack[--sp]];
+
+		if (!n.is_leaf()) {
+			ERR_FAIL_COND(sp + 2 > STACK_SIZE);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+			continue;
+		}
+
+		const Element &e = elements[n.element];
+		if (use_pairs && !(e.pairable_type & p_mask)) {
+			continue;
+		}
+
+		p_result_array[r_count++] = e.userdata;
+	}
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask) {
+
+	if (root == NULL_NODE) {
+		return 0;
+	}
+
+	const Plane *planes = p_convex.ptr();
+	int plane_count = p_convex.size();
+
+	int count = 0;
+	int32_t stack[STACK_SIZE];
+	int sp = 0;
+	stack[sp++] = root;
+
+	while (sp && count < p_result_max) {
+
+		int32_t index = stack[--sp];
+		const Node &n = nodes[index];
+
+		if (!n.aabb.intersects_convex_shape(planes, plane_count)) {
+			continue;
+		}
+
+		if (!n.is_leaf()) {
+
+			if (n.aabb.inside_convex_shape(planes, plane_count)) {
+				// everything below is inside, no need to test any further
+				_cull_subtree(index, p_result_array, count, p_result_max, p_mask);
+				continue;
+			}
+
+			ERR_FAIL_COND_V(sp + 2 > STACK_SIZE, count);
+			stack[sp++] = n.children[0];
+			stack[sp++] = n.children[1];
+			continue;
+		}
+
+		const Element &e = elements[n.element];
+		if ((use_pairs && !(e.pairable_type & p_mask)) || !e.aabb.intersects_convex_shape(planes, plane_count)) {
+			continue;
+		}
+
+		p_result_array[count++] = e.userdata;
+	}
+
+	return count;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_AABBQuery query;
+	query.aabb = p_aabb;
+	return _cull(query, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_SegmentQuery query;
+	query.from = p_from;
+	query.to = p_to;
+	return _cull(query, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_PointQuery query;
+	query.point = p_point;
+	return _cull(query, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+/* PUBLIC API */
+
+template <class T, bool use_pairs>
+DynamicBVHElementID DynamicBVH<T, use_pairs>::create(T *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+// check for AABB validity
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_V(p_aabb.size.x < 0.0 || p_aabb.size.y < 0.0 || p_aabb.size.z < 0.0, 0);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.x) || Math::is_nan(p_aabb.size.y) || Math::is_nan(p_aabb.size.z), 0);
+#endif
+
+	if (free_element == NULL_ELEMENT && element_count == element_capacity) {
+
+		// Element holds a Vector, so it can't be relocated with memrealloc.
+		uint32_t new_capacity = element_capacity ? element_capacity * 2 : 16;
+		Element *new_elements = (Element *)memalloc(sizeof(Element) * new_capacity);
+		for (uint32_t i = 0; i < element_count; i++) {
+			memnew_placement(&new_elements[i], Element(elements[i]));
+			elements[i].~Element();
+		}
+		if (elements) {
+			memfree(elements);
+		}
+		elements = new_elements;
+		element_capacity = new_capacity;
+	}
+
+	uint32_t index;
+	if (free_element != NULL_ELEMENT) {
+		index = free_element;
+		free_element = elements[index].next_free;
+	} else {
+		index = element_count++;
+		memnew_placement(&elements[index], Element);
+	}
+
+	Element &e = elements[index];
+	e.userdata = p_userdata;
+	e.aabb = p_aabb;
+	e.node = NULL_NODE;
+	e.subindex = p_subindex;
+	e.in_use = true;
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+	e.next_free = NULL_ELEMENT;
+	e.last_pass = 0;
+
+	if (p_pairable)
+		pairable_count++;
+
+	if (!p_aabb.has_no_surface()) {
+		_insert_element(index);
+		if (use_pairs)
+			_update_pairs(index);
+	}
+
+	return _index_to_id(index);
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::move(DynamicBVHElementID p_id, const AABB &p_aabb) {
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND(p_aabb.size.x < 0.0 || p_aabb.size.y < 0.0 || p_aabb.size.z < 0.0);
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.x) || Math::is_nan(p_aabb.size.y) || Math::is_nan(p_aabb.size.z));
+#endif
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND(!e);
+	uint32_t index = _id_to_index(p_id);
+
+	e->aabb = p_aabb;
+
+	if (p_aabb.has_no_surface()) {
+		if (e->node != NULL_NODE) {
+			_remove_element(index);
+		}
+	} else if (e->node == NULL_NODE) {
+		_insert_element(index);
+	} else if (!nodes[e->node].aabb.encloses(p_aabb)) {
+		// left its fat AABB, reinsert
+		_remove_element(index);
+		_insert_element(index);
+	}
+
+	if (use_pairs)
+		_update_pairs(index); // must check pairs anyway
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::set_pairable(DynamicBVHElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND(!e);
+
+	if (p_pairable == e->pairable && e->pairable_type == p_pairable_type && e->pairable_mask == p_pairable_mask)
+		return; // no changes, return
+
+	if (p_pairable != e->pairable)
+		pairable_count += p_pairable ? 1 : -1;
+
+	e->pairable = p_pairable;
+	e->pairable_type = p_pairable_type;
+	e->pairable_mask = p_pairable_mask;
+
+	if (use_pairs)
+		_update_pairs(_id_to_index(p_id));
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::erase(DynamicBVHElementID p_id) {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND(!e);
+	uint32_t index = _id_to_index(p_id);
+
+	if (use_pairs)
+		_unpair_all(index);
+
+	if (e->node != NULL_NODE) {
+		_remove_element(index);
+	}
+
+	if (e->pairable)
+		pairable_count--;
+
+	e->in_use = false;
+	e->userdata = NULL;
+	e->pairs.clear();
+	e->next_free = free_element;
+	free_element = index;
+}
+
+template <class T, bool use_pairs>
+bool DynamicBVH<T, use_pairs>::is_pairable(DynamicBVHElementID p_id) const {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND_V(!e, false);
+	return e->pairable;
+}
+
+template <class T, bool use_pairs>
+T *DynamicBVH<T, use_pairs>::get(DynamicBVHElementID p_id) const {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND_V(!e, NULL);
+	return e->userdata;
+}
+
+template <class T, bool use_pairs>
+int DynamicBVH<T, use_pairs>::get_subindex(DynamicBVHElementID p_id) const {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND_V(!e, -1);
+	return e->subindex;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+
+	pair_callback = p_callback;
+	pair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs>
+void DynamicBVH<T, use_pairs>::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+
+	unpair_callback = p_callback;
+	unpair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs>
+DynamicBVH<T, use_pairs>::DynamicBVH(real_t p_fat_margin) {
+
+	nodes = NULL;
+	node_capacity = 0;
+	node_count = 0;
+	free_node = NULL_NODE;
+	root = NULL_NODE;
+
+	elements = NULL;
+	element_capacity = 0;
+	element_count = 0;
+	free_element = NULL_ELEMENT;
+
+	pass = 1;
+	pair_count = 0;
+	pairable_count = 0;
+	fat_margin = p_fat_margin;
+
+	pair_callback = NULL;
+	unpair_callback = NULL;
+	pair_callback_userdata = NULL;
+	unpair_callback_userdata = NULL;
+}
+
+template <class T, bool use_pairs>
+DynamicBVH<T, use_pairs>::~DynamicBVH() {
+
+	if (nodes) {
+		memfree(nodes);
+	}
+
+	if (elements) {
+		for (uint32_t i = 0; i < element_count; i++) {
+			elements[i].~Element();
+		}
+		memfree(elements);
+	}
+}
+
+#endif // DYNAMIC_BVH_H
@@ -30,32 +30,171 @@
 
 #include "message_queue.h"
 
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 
 MessageQueue *MessageQueue::singleton = NULL;
 
+thread_local MessageQueue::ThreadQueueRef MessageQueue::thread_queue;
+uint32_t MessageQueue::last_epoch = 0;
+
 MessageQueue *MessageQueue::get_singleton() {
 
 	return singleton;
 }
 
-Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+void MessageQueue::thread_enter() {
+
+	// the queue itself is created on the first push, most threads never push anything
+	thread_queue.registered = true;
+}
+
+void MessageQueue::thread_exit() {
+
+	// the thread is exiting, its queue is freed by the next flush
+	ThreadQueueRef &ref = thread_queue;
+	if (ref.queue && singleton && ref.epoch == singleton->epoch && ref.queue != singleton->shared_queue) {
+		singleton->_orphan_thread_queue(ref.queue);
+	}
+	ref.queue = NULL;
+	ref.registered = false;
+}
+
+void MessageQueue::_assign_thread_queue(ThreadQueueRef &r_ref) {
+
+	if (r_ref.registered || Thread::get_caller_id() == Thread::get_main_id()) {
+		r_ref.queue = _create_thread_queue();
+	} else {
+		// not started by Thread (script, GDNative or audio threads), nothing would free its own queue when it exits
+		_THREAD_SAFE_LOCK_
+		if (!shared_queue) {
+			shared_queue = _create_thread_queue();
+		}
+		r_ref.queue = shared_queue;
+		_THREAD_SAFE_UNLOCK_
+	}
+	r_ref.epoch = epoch;
+}
+
+MessageQueue::ThreadQueue *MessageQueue::_create_thread_queue() {
 
 	_THREAD_SAFE_METHOD_
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	ThreadQueue *queue = memnew(ThreadQueue);
+	queue->first = NULL;
+	queue->last = NULL;
+	queue->used = 0;
+	queue->orphaned = false;
+	queue->next = NULL;
+
+	// keep them in creation order, so the main thread's messages go first
+	ThreadQueue **tail = &queues;
+	while (*tail) {
+		tail = &(*tail)->next;
+	}
+	*tail = queue;
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed method: " + type + ":" + p_method + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'message_queue_size_kb' in project settings.");
+	return queue;
+}
+
+void MessageQueue::_orphan_thread_queue(ThreadQueue *p_queue) {
+
+	_THREAD_SAFE_METHOD_
+
+	p_queue->orphaned = true;
+}
+
+uint8_t *MessageQueue::_allocate(ThreadQueue *p_queue, uint32_t p_size) {
+
+	Chunk *chunk = p_queue->last;
+
+	if (!chunk || chunk->end + p_size > chunk->size) {
+
+		chunk = NULL;
+		if (p_size <= CHUNK_SIZE_KB * 1024) {
+			chunk_lock.lock();
+			if (free_chunks) {
+				chunk = free_chunks;
+				free_chunks = chunk->next;
+				free_size -= chunk->size;
+			}
+			chunk_lock.unlock();
+		}
+
+		if (!chunk) {
+			uint32_t size = MAX((uint32_t)CHUNK_SIZE_KB * 1024, p_size);
+			chunk = (Chunk *)memalloc(Chunk::DATA_OFFSET + size);
+			chunk->size = size;
+		}
+
+		chunk->next = NULL;
+		chunk->end = 0;
+
+		if (p_queue->last) {
+			p_queue->last->next = chunk;
+		} else {
+			p_queue->first = chunk;
+		}
+		p_queue->last = chunk;
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	uint8_t *ptr = chunk->get_data() + chunk->end;
+	chunk->end += p_size;
+	p_queue->used += p_size;
+
+	return ptr;
+}
+
+void MessageQueue::_free_chunks(Chunk *p_chunks) {
+
+	chunk_lock.lock();
+
+	while (p_chunks) {
+
+		Chunk *chunk = p_chunks;
+		p_chunks = chunk->next;
+
+		// keep up to max_size_kb around for reuse
+		if (chunk->size == CHUNK_SIZE_KB * 1024 && free_size + chunk->size <= max_free_size) {
+			chunk->next = free_chunks;
+			free_chunks = chunk;
+			free_size += chunk->size;
+		} else {
+			memfree(chunk);
+		}
+	}
+
+	chunk_lock.unlock();
+}
+
+void MessageQueue::_destroy_messages(Chunk *p_chunk) {
+
+	uint8_t *data = p_chunk->get_data();
+	uint32_t read_pos = 0;
+
+	while (read_pos < p_chunk->end) {
+
+		Message *message = (Message *)&data[read_pos];
+
+		read_pos += sizeof(Message);
+		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			Variant *args = (Variant *)(message + 1);
+			for (int i = 0; i < message->args; i++)
+				args[i].~Variant();
+			read_pos += sizeof(Variant) * message->args;
+		}
+
+		message->~Message();
+	}
+}
+
+Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+
+	ThreadQueue *queue = _get_thread_queue();
+	queue->lock.lock();
+
+	Message *msg = memnew_placement(_allocate(queue, sizeof(Message) + sizeof(Variant) * p_argcount), Message);
 	msg->args = p_argcount;
 	msg->instance_id = p_id;
 	msg->target = p_method;
@@ -63,15 +202,14 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const V
 	if (p_show_error)
 		msg->type |= FLAG_SHOW_ERROR;
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
 
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
+		memnew_placement(&args[i], Variant(*p_args[i]));
 	}
 
+	queue->lock.unlock();
+
 	return OK;
 }
 
@@ -92,59 +230,37 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+	ThreadQueue *queue = _get_thread_queue();
+	queue->lock.lock();
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'message_queue_size_kb' in project settings.");
-	}
-
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(_allocate(queue, sizeof(Message) + sizeof(Variant)), Message);
 	msg->args = 1;
 	msg->instance_id = p_id;
 	msg->target = p_prop;
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
+	memnew_placement(msg + 1, Variant(p_value));
 
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
-	*v = p_value;
+	queue->lock.unlock();
 
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
 
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'message_queue_size_kb' in project settings.");
-	}
+	ThreadQueue *queue = _get_thread_queue();
+	queue->lock.lock();
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(_allocate(queue, sizeof(Message)), Message);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->instance_id = p_id;
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	queue->lock.unlock();
 
 	return OK;
 }
@@ -169,56 +285,73 @@ void MessageQueue::statistics() {
 	Map<int, int> notify_count;
 	Map<StringName, int> call_count;
 	int null_count = 0;
+	uint32_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	_THREAD_SAFE_LOCK_
 
-		Object *target = ObjectDB::get_instance(message->instance_id);
+	for (ThreadQueue *queue = queues; queue; queue = queue->next) {
 
-		if (target != NULL) {
+		queue->lock.lock();
+		total_bytes += queue->used;
 
-			switch (message->type & FLAG_MASK) {
+		for (Chunk *chunk = queue->first; chunk; chunk = chunk->next) {
 
-				case TYPE_CALL: {
+			uint8_t *data = chunk->get_data();
+			uint32_t read_pos = 0;
+			while (read_pos < chunk->end) {
+				Message *message = (Message *)&data[read_pos];
 
-					if (!call_count.has(message->target))
-						call_count[message->target] = 0;
+				Object *target = ObjectDB::get_instance(message->instance_id);
 
-					call_count[message->target]++;
+				if (target != NULL) {
 
-				} break;
-				case TYPE_NOTIFICATION: {
+					switch (message->type & FLAG_MASK) {
 
-					if (!notify_count.has(message->notification))
-						notify_count[message->notification] = 0;
+						case TYPE_CALL: {
 
-					notify_count[message->notification]++;
+							if (!call_count.has(message->target))
+								call_count[message->target] = 0;
 
-				} break;
-				case TYPE_SET: {
+							call_count[message->target]++;
 
-					if (!set_count.has(message->target))
-						set_count[message->target] = 0;
+						} break;
+						case TYPE_NOTIFICATION: {
 
-					set_count[message->target]++;
+							if (!notify_count.has(message->notification))
+								notify_count[message->notification] = 0;
 
-				} break;
-			}
+							notify_count[message->notification]++;
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+						} break;
+						case TYPE_SET: {
+
+							if (!set_count.has(message->target))
+								set_count[message->target] = 0;
+
+							set_count[message->target]++;
+
+						} break;
+					}
+
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
+
+					null_count++;
+				}
 
-			null_count++;
+				read_pos += sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+					read_pos += sizeof(Variant) * message->args;
+			}
 		}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		queue->lock.unlock();
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	_THREAD_SAFE_UNLOCK_
+
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -259,76 +392,128 @@ void MessageQueue::_call_function(Object *p_target, const StringName &p_func, co
 
 void MessageQueue::flush() {
 
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
-	}
+	_THREAD_SAFE_LOCK_
+	bool already_flushing = flushing;
+	flushing = true;
+	_THREAD_SAFE_UNLOCK_
 
-	uint32_t read_pos = 0;
+	ERR_FAIL_COND(already_flushing); //already flushing, you did something odd
 
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
+	uint32_t flushed = 0;
 
-	ERR_FAIL_COND(flushing); //already flushing, you did something odd
-	flushing = true;
+	while (true) {
+
+		if (flushed > max_flush_size) {
+			// likely a call deferring itself, leave what was pushed meanwhile for the next flush
+			ERR_PRINTS("Message queue flush exceeded " + itos(max_flush_size / 1024) + " KB, deferring the remaining messages to the next flush. Are deferred calls deferring themselves?");
+			break;
+		}
+
+		// take everything queued so far, messages pushed while running these are taken on the next round
+		Chunk *first = NULL;
+		Chunk *last = NULL;
+		uint32_t used = 0;
+
+		_THREAD_SAFE_LOCK_
 
-	while (read_pos < buffer_end) {
+		ThreadQueue **queue_ptr = &queues;
+		while (*queue_ptr) {
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+			ThreadQueue *queue = *queue_ptr;
 
-		Message *message = (Message *)&buffer[read_pos];
+			queue->lock.lock();
+			if (queue->first) {
+				if (last) {
+					last->next = queue->first;
+				} else {
+					first = queue->first;
+				}
+				last = queue->last;
+				used += queue->used;
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			advance += sizeof(Variant) * message->args;
+				queue->first = NULL;
+				queue->last = NULL;
+				queue->used = 0;
+			}
+			queue->lock.unlock();
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+			if (queue->orphaned) {
+				*queue_ptr = queue->next;
+				memdelete(queue);
+			} else {
+				queue_ptr = &queue->next;
+			}
+		}
 
 		_THREAD_SAFE_UNLOCK_
 
-		Object *target = ObjectDB::get_instance(message->instance_id);
+		if (!first) {
+			break;
+		}
 
-		if (target != NULL) {
+		if (used > buffer_max_used) {
+			buffer_max_used = used;
+		}
+		flushed += used;
 
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
+		for (Chunk *chunk = first; chunk; chunk = chunk->next) {
 
-					Variant *args = (Variant *)(message + 1);
+			uint8_t *data = chunk->get_data();
+			uint32_t read_pos = 0;
 
-					// messages don't expect a return value
+			while (read_pos < chunk->end) {
 
-					_call_function(target, message->target, args, message->args, message->type & FLAG_SHOW_ERROR);
+				Message *message = (Message *)&data[read_pos];
 
-				} break;
-				case TYPE_NOTIFICATION: {
+				read_pos += sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+					read_pos += sizeof(Variant) * message->args;
 
-					// messages don't expect a return value
-					target->notification(message->notification);
+				Object *target = ObjectDB::get_instance(message->instance_id);
 
-				} break;
-				case TYPE_SET: {
+				if (target != NULL) {
 
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->target, *arg);
+					switch (message->type & FLAG_MASK) {
+						case TYPE_CALL: {
 
-				} break;
-			}
-		}
+							Variant *args = (Variant *)(message + 1);
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
+							// messages don't expect a return value
+
+							_call_function(target, message->target, args, message->args, message->type & FLAG_SHOW_ERROR);
+
+						} break;
+						case TYPE_NOTIFICATION: {
+
+							// messages don't expect a return value
+							target->notification(message->notification);
+
+						} break;
+						case TYPE_SET: {
+
+							Variant *arg = (Variant *)(message + 1);
+							// messages don't expect a return value
+							target->set(message->target, *arg);
+
+						} break;
+					}
+				}
+
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+					Variant *args = (Variant *)(message + 1);
+					for (int i = 0; i < message->args; i++) {
+						args[i].~Variant();
+					}
+				}
+
+				message->~Message();
 			}
 		}
 
-		message->~Message();
-
-		_THREAD_SAFE_LOCK_
+		_free_chunks(first);
 	}
 
-	buffer_end = 0; // reset buffer
+	_THREAD_SAFE_LOCK_
 	flushing = false;
 	_THREAD_SAFE_UNLOCK_
 }
@@ -344,34 +529,40 @@ MessageQueue::MessageQueue() {
 	singleton = this;
 	flushing = false;
 
-	buffer_end = 0;
+	queues = NULL;
+	shared_queue = NULL;
+	free_chunks = NULL;
+	free_size = 0;
 	buffer_max_used = 0;
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	epoch = ++last_epoch;
+
+	max_free_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "0,2048,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	max_free_size *= 1024;
+	max_flush_size = MAX(max_free_size, (uint32_t)CHUNK_SIZE_KB * 1024);
 }
 
 MessageQueue::~MessageQueue() {
 
-	uint32_t read_pos = 0;
+	while (queues) {
 
-	while (read_pos < buffer_end) {
+		ThreadQueue *queue = queues;
+		queues = queue->next;
 
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++)
-				args[i].~Variant();
+		while (queue->first) {
+			Chunk *chunk = queue->first;
+			queue->first = chunk->next;
+			_destroy_messages(chunk);
+			memfree(chunk);
 		}
-		message->~Message();
+		memdelete(queue);
+	}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+	while (free_chunks) {
+		Chunk *chunk = free_chunks;
+		free_chunks = chunk->next;
+		memfree(chunk);
 	}
 
 	singleton = NULL;
-	memdelete_arr(buffer);
 }
@@ -40,7 +40,8 @@ class MessageQueue {
 
 	enum {
 
-		DEFAULT_QUEUE_SIZE_KB = 1024
+		DEFAULT_QUEUE_SIZE_KB = 1024,
+		CHUNK_SIZE_KB = 64
 	};
 
 	enum {
@@ -63,10 +64,67 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
+	// messages are appended to chunks, and never span two of them
+	struct Chunk {
+
+		Chunk *next;
+		uint32_t end;
+		uint32_t size;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return ((uint8_t *)this) + DATA_OFFSET; }
+
+		enum {
+			DATA_OFFSET = (sizeof(Chunk *) + sizeof(uint32_t) * 2 + 15) & ~15
+		};
+	};
+
+	// each thread pushes to its own queue, flush() splices them all
+	struct ThreadQueue {
+
+		ThreadSafe lock;
+		Chunk *first;
+		Chunk *last;
+		uint32_t used;
+		bool orphaned;
+		ThreadQueue *next;
+	};
+
+	// plain data, so it needs no TLS destructor, Thread implementations call thread_exit() instead
+	struct ThreadQueueRef {
+
+		ThreadQueue *queue;
+		uint32_t epoch;
+		bool registered; // set by thread_enter(), other threads share a queue since nothing frees theirs
+	};
+
+	static thread_local ThreadQueueRef thread_queue;
+	static uint32_t last_epoch;
+
+	ThreadQueue *queues;
+	ThreadQueue *shared_queue;
+	ThreadSafe chunk_lock; // guards the free chunks, taken after a queue lock
+	Chunk *free_chunks;
+	uint32_t free_size;
+	uint32_t max_free_size;
+	uint32_t max_flush_size;
 	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+	uint32_t epoch;
+
+	_FORCE_INLINE_ ThreadQueue *_get_thread_queue() {
+
+		ThreadQueueRef &ref = thread_queue;
+		if (unlikely(!ref.queue || ref.epoch != epoch)) {
+			_assign_thread_queue(ref);
+		}
+		return ref.queue;
+	}
+
+	void _assign_thread_queue(ThreadQueueRef &r_ref);
+	ThreadQueue *_create_thread_queue();
+	void _orphan_thread_queue(ThreadQueue *p_queue);
+	uint8_t *_allocate(ThreadQueue *p_queue, uint32_t p_size);
+	void _free_chunks(Chunk *p_chunks);
+	static void _destroy_messages(Chunk *p_chunk);
 
 	void _call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -86,6 +144,9 @@ public:
 	Error push_notification(Object *p_object, int p_notification);
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
 
+	static void thread_enter();
+	static void thread_exit();
+
 	void statistics();
 	void flush();
 
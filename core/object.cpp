@@ -33,9 +33,11 @@
 #include "core/class_db.h"
 #include "core/core_string_names.h"
 #include "core/message_queue.h"
+#include "core/os/copymem.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
 #include "core/resource.h"
+#include "core/safe_refcount.h"
 #include "core/script_language.h"
 #include "core/translation.h"
 
@@ -401,7 +403,7 @@ void Object::get_valid_parents_static(List<String> *p_parents) {
 void Object::_get_valid_parents_static(List<String> *p_parents) {
 }
 
-void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid) {
+void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid, PropertyCache *p_cache) {
 
 #ifdef TOOLS_ENABLED
 
@@ -419,7 +421,7 @@ void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid
 
 	//try built-in setgetter
 	{
-		if (ClassDB::set_property(this, p_name, p_value, r_valid)) {
+		if (ClassDB::set_property(this, p_name, p_value, r_valid, p_cache)) {
 			/*
 			if (r_valid)
 				*r_valid=true;
@@ -476,7 +478,7 @@ void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid
 		*r_valid = false;
 }
 
-Variant Object::get(const StringName &p_name, bool *r_valid) const {
+Variant Object::get(const StringName &p_name, bool *r_valid, PropertyCache *p_cache) const {
 
 	Variant ret;
 
@@ -491,7 +493,7 @@ Variant Object::get(const StringName &p_name, bool *r_valid) const {
 
 	//try built-in setgetter
 	{
-		if (ClassDB::get_property(const_cast<Object *>(this), p_name, ret)) {
+		if (ClassDB::get_property(const_cast<Object *>(this), p_name, ret, p_cache)) {
 			if (r_valid)
 				*r_valid = true;
 			return ret;
@@ -926,6 +928,35 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 	return ret;
 }
 
+Variant Object::call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error, MethodCache *p_cache) {
+
+	MethodBind *method = ClassDB::get_method(get_class_name(), p_method, p_cache);
+	if (!method) {
+		// free, script methods and classes overriding call()
+		return call(p_method, p_args, p_argcount, r_error);
+	}
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	OBJ_DEBUG_LOCK
+	if (script_instance) {
+		Variant ret = script_instance->call(p_method, p_args, p_argcount, r_error);
+		switch (r_error.error) {
+
+			case Variant::CallError::CALL_OK:
+			case Variant::CallError::CALL_ERROR_INVALID_ARGUMENT:
+			case Variant::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS:
+			case Variant::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS:
+				return ret;
+			default: {
+			}
+		}
+		r_error.error = Variant::CallError::CALL_OK;
+	}
+
+	return method->call(this, p_args, p_argcount, r_error);
+}
+
 void Object::notification(int p_notification, bool p_reversed) {
 
 	_notificationv(p_notification, p_reversed);
@@ -1171,13 +1202,25 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 	//copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
 	//this happens automatically and will not change the performance of calling.
 	//awesome, isn't it?
-	VMap<Signal::Target, Signal::Slot> slot_map = s->slot_map;
+	//the copy must stay const, a non-const access would copy the connections on every emission
+	const VMap<Signal::Target, Signal::Slot> slot_map = s->slot_map;
 
 	int ssize = slot_map.size();
 
 	OBJ_DEBUG_LOCK
 
-	Vector<const Variant *> bind_mem;
+	// room for the arguments followed by the binds of any connection, so emitting doesn't allocate
+	const Variant **bind_mem = NULL;
+	int max_binds = 0;
+	for (int i = 0; i < ssize; i++) {
+		max_binds = MAX(max_binds, slot_map.getv(i).conn.binds.size());
+	}
+	if (max_binds) {
+		bind_mem = (const Variant **)alloca(sizeof(Variant *) * (p_argcount + max_binds));
+		for (int j = 0; j < p_argcount; j++) {
+			bind_mem[j] = p_args[j];
+		}
+	}
 
 	Error err = OK;
 
@@ -1198,17 +1241,12 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 		if (c.binds.size()) {
 			//handle binds
-			bind_mem.resize(p_argcount + c.binds.size());
-
-			for (int j = 0; j < p_argcount; j++) {
-				bind_mem.write[j] = p_args[j];
-			}
 			for (int j = 0; j < c.binds.size(); j++) {
-				bind_mem.write[p_argcount + j] = &c.binds[j];
+				bind_mem[p_argcount + j] = &c.binds[j];
 			}
 
-			args = (const Variant **)bind_mem.ptr();
-			argc = bind_mem.size();
+			args = bind_mem;
+			argc = p_argcount + c.binds.size();
 		}
 
 		if (c.flags & CONNECT_DEFERRED) {
@@ -1992,17 +2030,49 @@ void postinitialize_handler(Object *p_object) {
 	p_object->_postinitialize();
 }
 
-HashMap<ObjectID, Object *> ObjectDB::instances;
-ObjectID ObjectDB::instance_counter = 1;
+ObjectDB::ObjectSlot *ObjectDB::slot_chunks[ObjectDB::SLOT_CHUNK_MAX] = {};
+uint32_t ObjectDB::slot_count = 0;
+uint32_t ObjectDB::free_slots = ObjectDB::SLOT_MASK;
+uint64_t ObjectDB::validator_counter = 0;
+int ObjectDB::object_count = 0;
 HashMap<Object *, ObjectID, ObjectDB::ObjectPtrHash> ObjectDB::instance_checks;
 ObjectID ObjectDB::add_instance(Object *p_object) {
 
 	ERR_FAIL_COND_V(p_object->get_instance_id() != 0, 0);
 
 	rw_lock->write_lock();
-	ObjectID instance_id = ++instance_counter;
-	instances[instance_id] = p_object;
+
+	uint32_t slot = free_slots;
+	ObjectSlot *s;
+	if (slot != SLOT_MASK) {
+		s = &slot_chunks[slot >> SLOT_CHUNK_BITS][slot & (SLOT_CHUNK_SIZE - 1)];
+		free_slots = s->next_free;
+	} else {
+		if (unlikely(slot_count == SLOT_MASK)) {
+			rw_lock->write_unlock();
+			CRASH_NOW_MSG("Maximum number of object slots exceeded.");
+		}
+		slot = slot_count;
+		ObjectSlot *&chunk = slot_chunks[slot >> SLOT_CHUNK_BITS];
+		if (!chunk) {
+			chunk = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * SLOT_CHUNK_SIZE);
+			zeromem(chunk, sizeof(ObjectSlot) * SLOT_CHUNK_SIZE);
+		}
+		s = &chunk[slot & (SLOT_CHUNK_SIZE - 1)];
+		atomic_increment(&slot_count);
+	}
+
+	validator_counter = (validator_counter + 1) & (((uint64_t)1 << (63 - SLOT_BITS)) - 1);
+	if (unlikely(validator_counter == 0))
+		validator_counter = 1;
+
+	// Publish the object before the validator that makes its ID resolve.
+	s->object = p_object;
+	atomic_compare_and_swap(&s->validator, (uint64_t)0, validator_counter);
+	ObjectID instance_id = (validator_counter << SLOT_BITS) | slot;
+
 	instance_checks[p_object] = instance_id;
+	object_count++;
 
 	rw_lock->write_unlock();
 
@@ -2013,30 +2083,30 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	rw_lock->write_lock();
 
-	instances.erase(p_object->get_instance_id());
-	instance_checks.erase(p_object);
+	ObjectID instance_id = p_object->get_instance_id();
+	uint32_t slot = instance_id & SLOT_MASK;
+	ObjectSlot *s = &slot_chunks[slot >> SLOT_CHUNK_BITS][slot & (SLOT_CHUNK_SIZE - 1)];
 
-	rw_lock->write_unlock();
-}
-Object *ObjectDB::get_instance(ObjectID p_instance_id) {
+	atomic_compare_and_swap(&s->validator, instance_id >> SLOT_BITS, (uint64_t)0);
+	s->object = NULL;
+	s->next_free = free_slots;
+	free_slots = slot;
 
-	rw_lock->read_lock();
-	Object **obj = instances.getptr(p_instance_id);
-	rw_lock->read_unlock();
+	instance_checks.erase(p_object);
+	object_count--;
 
-	if (!obj)
-		return NULL;
-	return *obj;
+	rw_lock->write_unlock();
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func) {
 
 	rw_lock->read_lock();
 
-	const ObjectID *K = NULL;
-	while ((K = instances.next(K))) {
-
-		p_func(instances[*K]);
+	for (uint32_t i = 0; i < slot_count; i++) {
+		const ObjectSlot &s = slot_chunks[i >> SLOT_CHUNK_BITS][i & (SLOT_CHUNK_SIZE - 1)];
+		if (s.validator) {
+			p_func(s.object);
+		}
 	}
 
 	rw_lock->read_unlock();
@@ -2047,11 +2117,7 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 int ObjectDB::get_object_count() {
 
-	rw_lock->read_lock();
-	int count = instances.size();
-	rw_lock->read_unlock();
-
-	return count;
+	return object_count;
 }
 
 RWLock *ObjectDB::rw_lock = NULL;
@@ -2064,23 +2130,35 @@ void ObjectDB::setup() {
 void ObjectDB::cleanup() {
 
 	rw_lock->write_lock();
-	if (instances.size()) {
+	if (object_count) {
 
 		WARN_PRINT("ObjectDB Instances still exist!");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			const ObjectID *K = NULL;
-			while ((K = instances.next(K))) {
+			for (uint32_t i = 0; i < slot_count; i++) {
+
+				const ObjectSlot &s = slot_chunks[i >> SLOT_CHUNK_BITS][i & (SLOT_CHUNK_SIZE - 1)];
+				if (!s.validator)
+					continue;
 
+				Object *obj = s.object;
 				String node_name;
-				if (instances[*K]->is_class("Node"))
-					node_name = " - Node name: " + String(instances[*K]->call("get_name"));
-				if (instances[*K]->is_class("Resource"))
-					node_name = " - Resource name: " + String(instances[*K]->call("get_name")) + " Path: " + String(instances[*K]->call("get_path"));
-				print_line("Leaked instance: " + String(instances[*K]->get_class()) + ":" + itos(*K) + node_name);
+				if (obj->is_class("Node"))
+					node_name = " - Node name: " + String(obj->call("get_name"));
+				if (obj->is_class("Resource"))
+					node_name = " - Resource name: " + String(obj->call("get_name")) + " Path: " + String(obj->call("get_path"));
+				print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(obj->get_instance_id()) + node_name);
 			}
 		}
 	}
-	instances.clear();
+	for (int i = 0; i < SLOT_CHUNK_MAX; i++) {
+		if (slot_chunks[i]) {
+			memfree(slot_chunks[i]);
+			slot_chunks[i] = NULL;
+		}
+	}
+	slot_count = 0;
+	free_slots = SLOT_MASK;
+	object_count = 0;
 	instance_checks.clear();
 	rw_lock->write_unlock();
 	memdelete(rw_lock);
@@ -35,6 +35,7 @@
 #include "core/list.h"
 #include "core/map.h"
 #include "core/os/rw_lock.h"
+#include "core/safe_refcount.h"
 #include "core/set.h"
 #include "core/variant.h"
 #include "core/vmap.h"
@@ -397,6 +398,8 @@ public:                                                        \
 private:
 
 class ScriptInstance;
+class MethodCache;
+class PropertyCache;
 typedef uint64_t ObjectID;
 
 class Object {
@@ -654,8 +657,8 @@ public:
 	//void set(const String& p_name, const Variant& p_value);
 	//Variant get(const String& p_name) const;
 
-	void set(const StringName &p_name, const Variant &p_value, bool *r_valid = NULL);
-	Variant get(const StringName &p_name, bool *r_valid = NULL) const;
+	void set(const StringName &p_name, const Variant &p_value, bool *r_valid = NULL, PropertyCache *p_cache = NULL);
+	Variant get(const StringName &p_name, bool *r_valid = NULL, PropertyCache *p_cache = NULL) const;
 	void set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = NULL);
 	Variant get_indexed(const Vector<StringName> &p_names, bool *r_valid = NULL) const;
 
@@ -665,6 +668,7 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Variant::CallError &r_error, MethodCache *p_cache);
 	virtual void call_multilevel(const StringName &p_method, const Variant **p_args, int p_argcount);
 	virtual void call_multilevel_reversed(const StringName &p_method, const Variant **p_args, int p_argcount);
 	Variant call(const StringName &p_name, VARIANT_ARG_LIST); // C++ helper
@@ -772,10 +776,32 @@ class ObjectDB {
 		}
 	};
 
-	static HashMap<ObjectID, Object *> instances;
+	// Instance IDs carry the index of the object's slot in their low bits and
+	// a validator in the high ones. Validators are never reused, so an ID
+	// outlives its object and simply stops resolving.
+	enum {
+		SLOT_BITS = 24,
+		SLOT_MASK = (1 << SLOT_BITS) - 1,
+		SLOT_CHUNK_BITS = 12,
+		SLOT_CHUNK_SIZE = 1 << SLOT_CHUNK_BITS,
+		SLOT_CHUNK_MAX = 1 << (SLOT_BITS - SLOT_CHUNK_BITS),
+	};
+
+	struct ObjectSlot {
+		volatile uint64_t validator; // zero while the slot is free
+		Object *volatile object;
+		uint32_t next_free;
+	};
+
+	// Chunks stay put until cleanup, so IDs are resolved without taking the lock.
+	static ObjectSlot *slot_chunks[SLOT_CHUNK_MAX];
+	static uint32_t slot_count;
+	static uint32_t free_slots;
+	static uint64_t validator_counter;
+	static int object_count;
+
 	static HashMap<Object *, ObjectID, ObjectPtrHash> instance_checks;
 
-	static ObjectID instance_counter;
 	friend class Object;
 	friend void unregister_core_types();
 
@@ -789,7 +815,25 @@ class ObjectDB {
 public:
 	typedef void (*DebugFunc)(Object *p_obj);
 
-	static Object *get_instance(ObjectID p_instance_id);
+	_FORCE_INLINE_ static Object *get_instance(ObjectID p_instance_id) {
+
+		uint32_t slot = p_instance_id & SLOT_MASK;
+		uint64_t validator = p_instance_id >> SLOT_BITS;
+		if (unlikely(slot >= atomic_load_acquire(&slot_count) || validator == 0))
+			return NULL;
+
+		// Acquire loads pair with the barriers add_instance() and remove_instance()
+		// publish with, and keep the object read between both validator checks.
+		ObjectSlot &s = slot_chunks[slot >> SLOT_CHUNK_BITS][slot & (SLOT_CHUNK_SIZE - 1)];
+		if (atomic_load_acquire(&s.validator) != validator)
+			return NULL;
+		Object *object = atomic_load_acquire(&s.object);
+		// The slot may have been released and reused while reading it.
+		if (atomic_load_acquire(&s.validator) != validator)
+			return NULL;
+		return object;
+	}
+
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
 
@@ -37,6 +37,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#if defined(SLAB_ALLOCATOR_ENABLED) && !defined(NO_THREADS)
+#include <thread>
+#endif
+
 void *operator new(size_t p_size, const char *p_description) {
 
 	return Memory::alloc_static(p_size, false);
@@ -71,15 +75,246 @@ uint64_t Memory::max_usage = 0;
 
 uint64_t Memory::alloc_count = 0;
 
+#ifdef SLAB_ALLOCATOR_ENABLED
+
+// Small blocks are carved from 64 KiB slabs, one set of slabs per size class.
+// Each thread keeps a free list per class and trades blocks with a shared depot
+// in batches, so most allocations and frees touch no shared state. Slabs are
+// never returned to the system. Every block carries the pad header, whose size
+// field tells free_static() which class (if any) the block belongs to.
+
+#define SLAB_SIZE 65536
+#define SLAB_BATCH 32
+#define SLAB_STATS_FLUSH 64
+#define SLAB_SPIN_MAX 64
+
+struct SlabBlock {
+	SlabBlock *next;
+	// Only meaningful on the first block of a batch in the depot.
+	SlabBlock *next_batch;
+	uint32_t batch_count;
+};
+
+struct SlabDepot {
+	volatile uint32_t lock;
+	SlabBlock *batches;
+	uint8_t *carve_pos;
+	uint8_t *carve_end;
+	uint64_t slab_bytes;
+};
+
+struct SlabThreadCache {
+	SlabBlock *head[Memory::SLAB_CLASS_COUNT];
+	uint32_t count[Memory::SLAB_CLASS_COUNT];
+	uint32_t allocs;
+};
+
+// Threads created by Thread release their cache when they exit, this catches
+// the ones created elsewhere. It's only touched when the cache is refilled, so
+// the fast paths don't pay for the TLS destructor guard.
+struct SlabThreadCacheReleaser {
+	bool armed;
+
+	~SlabThreadCacheReleaser() {
+		Memory::release_thread_cache();
+	}
+};
+
+static SlabDepot slab_depots[Memory::SLAB_CLASS_COUNT];
+static thread_local SlabThreadCache slab_cache;
+static thread_local SlabThreadCacheReleaser slab_cache_releaser;
+static uint64_t slab_allocs = 0;
+
+static _FORCE_INLINE_ int _slab_class(size_t p_block_size) {
+
+	return p_block_size <= 32 ? 0 : int((p_block_size - 1) / Memory::SLAB_CLASS_GRANULARITY) - 1;
+}
+
+static void _slab_lock_contended(SlabDepot &p_depot) {
+
+	// The owner only holds the depot for a few pointer swaps, so wait on plain
+	// reads with a growing spin, then start yielding in case it was preempted.
+	uint32_t spin = 1;
+	do {
+		while (atomic_load_acquire(&p_depot.lock)) {
+			if (spin <= SLAB_SPIN_MAX) {
+				for (uint32_t i = 0; i < spin; i++) {
+					atomic_load_acquire(&p_depot.lock);
+				}
+				spin <<= 1;
+			} else {
+#ifndef NO_THREADS
+				std::this_thread::yield();
+#endif
+			}
+		}
+	} while (atomic_compare_and_swap(&p_depot.lock, (uint32_t)0, (uint32_t)1) != 0);
+}
+
+static _FORCE_INLINE_ void _slab_lock(SlabDepot &p_depot) {
+
+	if (unlikely(atomic_compare_and_swap(&p_depot.lock, (uint32_t)0, (uint32_t)1) != 0)) {
+		_slab_lock_contended(p_depot);
+	}
+}
+
+static _FORCE_INLINE_ void _slab_unlock(SlabDepot &p_depot) {
+
+	atomic_store_release(&p_depot.lock, (uint32_t)0);
+}
+
+void *Memory::_slab_alloc(int p_class) {
+
+	SlabThreadCache &cache = slab_cache;
+
+	if (unlikely(++cache.allocs == SLAB_STATS_FLUSH)) {
+		atomic_add(&slab_allocs, (uint64_t)SLAB_STATS_FLUSH);
+		cache.allocs = 0;
+	}
+
+	SlabBlock *block = cache.head[p_class];
+	if (likely(block)) {
+		cache.head[p_class] = block->next;
+		cache.count[p_class]--;
+		return block;
+	}
+
+	// Refill from the depot, carving a new batch if it has none.
+	slab_cache_releaser.armed = true;
+
+	SlabDepot &depot = slab_depots[p_class];
+	_slab_lock(depot);
+
+	SlabBlock *batch = depot.batches;
+	if (batch) {
+		depot.batches = batch->next_batch;
+	} else {
+		size_t block_size = get_slab_class_size(p_class);
+		if (depot.carve_pos + block_size * SLAB_BATCH > depot.carve_end) {
+			uint8_t *slab = (uint8_t *)malloc(SLAB_SIZE);
+			if (!slab) {
+				_slab_unlock(depot);
+				return NULL;
+			}
+			depot.carve_pos = slab;
+			depot.carve_end = slab + SLAB_SIZE;
+			depot.slab_bytes += SLAB_SIZE;
+		}
+		batch = (SlabBlock *)depot.carve_pos;
+		for (int i = 0; i < SLAB_BATCH; i++) {
+			SlabBlock *b = (SlabBlock *)(depot.carve_pos + i * block_size);
+			b->next = i < SLAB_BATCH - 1 ? (SlabBlock *)(depot.carve_pos + (i + 1) * block_size) : NULL;
+		}
+		batch->batch_count = SLAB_BATCH;
+		depot.carve_pos += block_size * SLAB_BATCH;
+	}
+
+	_slab_unlock(depot);
+
+	cache.head[p_class] = batch->next;
+	cache.count[p_class] = batch->batch_count - 1;
+	return batch;
+}
+
+void Memory::_slab_free(void *p_block, int p_class) {
+
+	SlabThreadCache &cache = slab_cache;
+
+	SlabBlock *block = (SlabBlock *)p_block;
+	block->next = cache.head[p_class];
+	cache.head[p_class] = block;
+
+	if (likely(++cache.count[p_class] < SLAB_BATCH * 2)) {
+		return;
+	}
+
+	// Hand a batch back so blocks freed here can be reused by other threads.
+	SlabBlock *last = block;
+	for (int i = 1; i < SLAB_BATCH; i++) {
+		last = last->next;
+	}
+	cache.head[p_class] = last->next;
+	cache.count[p_class] -= SLAB_BATCH;
+	last->next = NULL;
+
+	SlabDepot &depot = slab_depots[p_class];
+	_slab_lock(depot);
+	block->next_batch = depot.batches;
+	block->batch_count = SLAB_BATCH;
+	depot.batches = block;
+	_slab_unlock(depot);
+}
+
+#endif
+
+void Memory::release_thread_cache() {
+
+#ifdef SLAB_ALLOCATOR_ENABLED
+	SlabThreadCache &cache = slab_cache;
+
+	atomic_add(&slab_allocs, (uint64_t)cache.allocs);
+	cache.allocs = 0;
+
+	for (int i = 0; i < SLAB_CLASS_COUNT; i++) {
+		// Batches in the depot don't need to be full, so the whole list goes back as one.
+		SlabBlock *block = cache.head[i];
+		if (!block)
+			continue;
+
+		SlabDepot &depot = slab_depots[i];
+		_slab_lock(depot);
+		block->next_batch = depot.batches;
+		block->batch_count = cache.count[i];
+		depot.batches = block;
+		_slab_unlock(depot);
+
+		cache.head[i] = NULL;
+		cache.count[i] = 0;
+	}
+#endif
+}
+
+uint64_t Memory::get_slab_allocs() {
+
+#ifdef SLAB_ALLOCATOR_ENABLED
+	return slab_allocs;
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_slab_usage() {
+
+	uint64_t usage = 0;
+	for (int i = 0; i < SLAB_CLASS_COUNT; i++) {
+		usage += get_slab_class_usage(i);
+	}
+	return usage;
+}
+
+uint64_t Memory::get_slab_class_usage(int p_class) {
+
+	ERR_FAIL_INDEX_V(p_class, SLAB_CLASS_COUNT, 0);
+#ifdef SLAB_ALLOCATOR_ENABLED
+	return slab_depots[p_class].slab_bytes;
+#else
+	return 0;
+#endif
+}
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SLAB_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef SLAB_ALLOCATOR_ENABLED
+	void *mem = p_bytes + PAD_ALIGN <= SLAB_MAX_BLOCK ? _slab_alloc(_slab_class(p_bytes + PAD_ALIGN)) : malloc(p_bytes + PAD_ALIGN);
+#else
 	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+#endif
 
 	ERR_FAIL_COND_V(!mem, NULL);
 
@@ -109,12 +344,41 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SLAB_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef SLAB_ALLOCATOR_ENABLED
+	uint64_t old_bytes = *(uint64_t *)(mem - PAD_ALIGN);
+	bool old_slab = old_bytes + PAD_ALIGN <= SLAB_MAX_BLOCK;
+	bool new_slab = p_bytes + PAD_ALIGN <= SLAB_MAX_BLOCK;
+	if (p_bytes == 0) {
+		free_static(p_memory, p_pad_align);
+		return NULL;
+	} else if (old_slab || new_slab) {
+		if (old_slab && new_slab && _slab_class(old_bytes + PAD_ALIGN) == _slab_class(p_bytes + PAD_ALIGN)) {
+#ifdef DEBUG_ENABLED
+			if (p_bytes > old_bytes) {
+				atomic_add(&mem_usage, p_bytes - old_bytes);
+				atomic_exchange_if_greater(&max_usage, mem_usage);
+			} else {
+				atomic_sub(&mem_usage, old_bytes - p_bytes);
+			}
+#endif
+			*(uint64_t *)(mem - PAD_ALIGN) = p_bytes;
+			return p_memory;
+		}
+		// Moving between a slab class and malloc (or another class) needs a copy.
+		void *new_mem = alloc_static(p_bytes, p_pad_align);
+		ERR_FAIL_COND_V(!new_mem, NULL);
+		copymem(new_mem, p_memory, MIN(old_bytes, (uint64_t)p_bytes));
+		free_static(p_memory, p_pad_align);
+		return new_mem;
+	}
+#endif
+
 	if (prepad) {
 		mem -= PAD_ALIGN;
 		uint64_t *s = (uint64_t *)mem;
@@ -159,7 +423,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SLAB_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -175,6 +439,13 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		atomic_sub(&mem_usage, *s);
 #endif
 
+#ifdef SLAB_ALLOCATOR_ENABLED
+		uint64_t bytes = *(uint64_t *)mem;
+		if (bytes + PAD_ALIGN <= SLAB_MAX_BLOCK) {
+			_slab_free(mem, _slab_class(bytes + PAD_ALIGN));
+			return;
+		}
+#endif
 		free(mem);
 	} else {
 
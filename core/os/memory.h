@@ -50,7 +50,18 @@ class Memory {
 
 	static uint64_t alloc_count;
 
+#ifdef SLAB_ALLOCATOR_ENABLED
+	static void *_slab_alloc(int p_class);
+	static void _slab_free(void *p_block, int p_class);
+#endif
+
 public:
+	enum {
+		SLAB_CLASS_GRANULARITY = 16,
+		SLAB_CLASS_COUNT = 15, // blocks of 32 to 256 bytes, pad header included
+		SLAB_MAX_BLOCK = SLAB_CLASS_GRANULARITY * (SLAB_CLASS_COUNT + 1),
+	};
+
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
@@ -58,6 +69,14 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	// Slab allocator statistics, zero unless built with slab_allocator=yes.
+	static uint64_t get_slab_allocs();
+	static uint64_t get_slab_usage();
+	static uint64_t get_slab_class_usage(int p_class);
+	_FORCE_INLINE_ static int get_slab_class_size(int p_class) { return (p_class + 2) * SLAB_CLASS_GRANULARITY; }
+
+	static void release_thread_cache();
 };
 
 class DefaultAllocator {
@@ -54,26 +54,46 @@ struct MemoryPool {
 		PoolAllocator::ID pool_id;
 		size_t size;
 
-		Alloc *free_list;
-
 		Alloc() :
 				lock(0),
 				mem(NULL),
 				pool_id(POOL_ALLOCATOR_INVALID_ID),
-				size(0),
-				free_list(NULL) {
+				size(0) {
 		}
 	};
 
-	static Alloc *allocs;
-	static Alloc *free_list;
-	static uint32_t alloc_count;
 	static uint32_t allocs_used;
-	static Mutex *alloc_mutex;
 	static size_t total_memory;
 	static size_t max_memory;
 
-	static void setup(uint32_t p_max_allocs = (1 << 16));
+	// allocs are created and freed on demand and only the statistics are shared, so no lock is needed
+
+	static _FORCE_INLINE_ Alloc *alloc_create() {
+
+		Alloc *alloc = memnew(Alloc);
+		alloc->refcount.init();
+		atomic_increment(&allocs_used);
+		return alloc;
+	}
+
+	static _FORCE_INLINE_ void alloc_free(Alloc *p_alloc) {
+
+		memdelete(p_alloc);
+		atomic_decrement(&allocs_used);
+	}
+
+	static _FORCE_INLINE_ void track_memory(size_t p_old_size, size_t p_new_size) {
+
+#ifdef DEBUG_ENABLED
+		if (p_new_size > p_old_size) {
+			atomic_exchange_if_greater(&max_memory, atomic_add(&total_memory, p_new_size - p_old_size));
+		} else if (p_new_size < p_old_size) {
+			atomic_sub(&total_memory, p_old_size - p_new_size);
+		}
+#endif
+	}
+
+	static void setup();
 	static void cleanup();
 };
 
@@ -95,34 +115,13 @@ class PoolVector {
 
 		//must allocate something
 
-		MemoryPool::alloc_mutex->lock();
-		if (MemoryPool::allocs_used == MemoryPool::alloc_count) {
-			MemoryPool::alloc_mutex->unlock();
-			ERR_FAIL_MSG("All memory pool allocations are in use, can't COW.");
-		}
-
 		MemoryPool::Alloc *old_alloc = alloc;
 
-		//take one from the free list
-		alloc = MemoryPool::free_list;
-		MemoryPool::free_list = alloc->free_list;
-		//increment the used counter
-		MemoryPool::allocs_used++;
+		alloc = MemoryPool::alloc_create();
 
 		//copy the alloc data
 		alloc->size = old_alloc->size;
-		alloc->refcount.init();
-		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
-		alloc->lock = 0;
-
-#ifdef DEBUG_ENABLED
-		MemoryPool::total_memory += alloc->size;
-		if (MemoryPool::total_memory > MemoryPool::max_memory) {
-			MemoryPool::max_memory = MemoryPool::total_memory;
-		}
-#endif
-
-		MemoryPool::alloc_mutex->unlock();
+		MemoryPool::track_memory(0, alloc->size);
 
 		if (MemoryPool::memory_pool) {
 
@@ -139,47 +138,48 @@ class PoolVector {
 			int cur_elements = alloc->size / sizeof(T);
 			T *dst = (T *)w.ptr();
 			const T *src = (const T *)r.ptr();
-			for (int i = 0; i < cur_elements; i++) {
-				memnew_placement(&dst[i], T(src[i]));
+			if (__has_trivial_copy(T)) {
+				memcpy(dst, src, alloc->size);
+			} else {
+				for (int i = 0; i < cur_elements; i++) {
+					memnew_placement(&dst[i], T(src[i]));
+				}
 			}
 		}
 
 		if (old_alloc->refcount.unref()) {
 			//this should never happen but..
+			_free_alloc(old_alloc);
+		}
+	}
 
-#ifdef DEBUG_ENABLED
-			MemoryPool::alloc_mutex->lock();
-			MemoryPool::total_memory -= old_alloc->size;
-			MemoryPool::alloc_mutex->unlock();
-#endif
+	static void _free_alloc(MemoryPool::Alloc *p_alloc) {
 
-			{
-				Write w;
-				w._ref(old_alloc);
+		if (!__has_trivial_destructor(T)) {
+			int cur_elements = p_alloc->size / sizeof(T);
 
-				int cur_elements = old_alloc->size / sizeof(T);
-				T *elems = (T *)w.ptr();
-				for (int i = 0; i < cur_elements; i++) {
-					elems[i].~T();
-				}
+			// Don't use write() here because it could otherwise provoke COW,
+			// which is not desirable here because we are destroying the last reference anyways
+			Write w;
+			// Reference to still prevent other threads from touching the alloc
+			w._ref(p_alloc);
+
+			for (int i = 0; i < cur_elements; i++) {
+
+				w[i].~T();
 			}
+		}
 
-			if (MemoryPool::memory_pool) {
-				//resize memory pool
-				//if none, create
-				//if some resize
-			} else {
+		MemoryPool::track_memory(p_alloc->size, 0);
 
-				memfree(old_alloc->mem);
-				old_alloc->mem = NULL;
-				old_alloc->size = 0;
+		if (MemoryPool::memory_pool) {
+			//resize memory pool
+			//if none, create
+			//if some resize
+		} else {
 
-				MemoryPool::alloc_mutex->lock();
-				old_alloc->free_list = MemoryPool::free_list;
-				MemoryPool::free_list = old_alloc;
-				MemoryPool::allocs_used--;
-				MemoryPool::alloc_mutex->unlock();
-			}
+			memfree(p_alloc->mem);
+			MemoryPool::alloc_free(p_alloc);
 		}
 	}
 
@@ -204,49 +204,9 @@ class PoolVector {
 		if (!alloc)
 			return;
 
-		if (!alloc->refcount.unref()) {
-			alloc = NULL;
-			return;
-		}
-
-		//must be disposed!
-
-		{
-			int cur_elements = alloc->size / sizeof(T);
-
-			// Don't use write() here because it could otherwise provoke COW,
-			// which is not desirable here because we are destroying the last reference anyways
-			Write w;
-			// Reference to still prevent other threads from touching the alloc
-			w._ref(alloc);
-
-			for (int i = 0; i < cur_elements; i++) {
-
-				w[i].~T();
-			}
-		}
-
-#ifdef DEBUG_ENABLED
-		MemoryPool::alloc_mutex->lock();
-		MemoryPool::total_memory -= alloc->size;
-		MemoryPool::alloc_mutex->unlock();
-#endif
-
-		if (MemoryPool::memory_pool) {
-			//resize memory pool
-			//if none, create
-			//if some resize
-		} else {
-
-			memfree(alloc->mem);
-			alloc->mem = NULL;
-			alloc->size = 0;
-
-			MemoryPool::alloc_mutex->lock();
-			alloc->free_list = MemoryPool::free_list;
-			MemoryPool::free_list = alloc;
-			MemoryPool::allocs_used--;
-			MemoryPool::alloc_mutex->unlock();
+		if (alloc->refcount.unref()) {
+			//must be disposed!
+			_free_alloc(alloc);
 		}
 
 		alloc = NULL;
@@ -293,7 +253,7 @@ public:
 		}
 
 	public:
-		virtual ~Access() {
+		~Access() {
 			_unref();
 		}
 
@@ -523,23 +483,7 @@ Error PoolVector<T>::resize(int p_size) {
 			return OK; //nothing to do here
 
 		//must allocate something
-		MemoryPool::alloc_mutex->lock();
-		if (MemoryPool::allocs_used == MemoryPool::alloc_count) {
-			MemoryPool::alloc_mutex->unlock();
-			ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "All memory pool allocations are in use.");
-		}
-
-		//take one from the free list
-		alloc = MemoryPool::free_list;
-		MemoryPool::free_list = alloc->free_list;
-		//increment the used counter
-		MemoryPool::allocs_used++;
-
-		//cleanup the alloc
-		alloc->size = 0;
-		alloc->refcount.init();
-		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
-		MemoryPool::alloc_mutex->unlock();
+		alloc = MemoryPool::alloc_create();
 
 	} else {
 
@@ -558,15 +502,7 @@ Error PoolVector<T>::resize(int p_size) {
 
 	_copy_on_write(); // make it unique
 
-#ifdef DEBUG_ENABLED
-	MemoryPool::alloc_mutex->lock();
-	MemoryPool::total_memory -= alloc->size;
-	MemoryPool::total_memory += new_size;
-	if (MemoryPool::total_memory > MemoryPool::max_memory) {
-		MemoryPool::max_memory = MemoryPool::total_memory;
-	}
-	MemoryPool::alloc_mutex->unlock();
-#endif
+	MemoryPool::track_memory(alloc->size, new_size);
 
 	int cur_elements = alloc->size / sizeof(T);
 
@@ -587,16 +523,18 @@ Error PoolVector<T>::resize(int p_size) {
 
 		alloc->size = new_size;
 
-		Write w = write();
+		if (!__has_trivial_constructor(T)) {
+			Write w = write();
 
-		for (int i = cur_elements; i < p_size; i++) {
+			for (int i = cur_elements; i < p_size; i++) {
 
-			memnew_placement(&w[i], T);
+				memnew_placement(&w[i], T);
+			}
 		}
 
 	} else {
 
-		{
+		if (!__has_trivial_destructor(T)) {
 			Write w = write();
 			for (int i = p_size; i < cur_elements; i++) {
 
@@ -610,21 +548,8 @@ Error PoolVector<T>::resize(int p_size) {
 			//if some resize
 		} else {
 
-			if (new_size == 0) {
-				memfree(alloc->mem);
-				alloc->mem = NULL;
-				alloc->size = 0;
-
-				MemoryPool::alloc_mutex->lock();
-				alloc->free_list = MemoryPool::free_list;
-				MemoryPool::free_list = alloc;
-				MemoryPool::allocs_used--;
-				MemoryPool::alloc_mutex->unlock();
-
-			} else {
-				alloc->mem = memrealloc(alloc->mem, new_size);
-				alloc->size = new_size;
-			}
+			alloc->mem = memrealloc(alloc->mem, new_size);
+			alloc->size = new_size;
 		}
 	}
 
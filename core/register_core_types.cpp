@@ -230,6 +230,9 @@ void register_core_settings() {
 
 	GLOBAL_DEF("network/ssl/certificates", "");
 	ProjectSettings::get_singleton()->set_custom_property_info("network/ssl/certificates", PropertyInfo(Variant::STRING, "network/ssl/certificates", PROPERTY_HINT_FILE, "*.crt"));
+
+	GLOBAL_DEF("application/run/resource_loader_threads", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("application/run/resource_loader_threads", PropertyInfo(Variant::INT, "application/run/resource_loader_threads", PROPERTY_HINT_RANGE, "0,64,1,or_greater"));
 }
 
 void register_core_singletons() {
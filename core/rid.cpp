@@ -33,9 +33,192 @@
 RID_Data::~RID_Data() {
 }
 
-SafeRefCount RID_OwnerBase::refcount;
+uint32_t RID_OwnerBase::validator_counter = 0;
 
 void RID_OwnerBase::init_rid() {
 
-	refcount.init();
+	validator_counter = 0;
+}
+
+// Caller holds the mutex.
+uint32_t RID_OwnerBase::_alloc_slot() {
+
+	uint32_t slot = free_slots;
+	if (slot != NO_SLOT) {
+		free_slots = chunks[slot >> CHUNK_BITS][slot & CHUNK_MASK].next_free;
+		return slot;
+	}
+
+	slot = slot_count;
+	uint32_t chunk = slot >> CHUNK_BITS;
+	if (chunk == chunk_capacity) {
+		// Grow the chunk table, the old one may still be read by a lookup.
+		uint32_t new_capacity = chunk_capacity ? chunk_capacity * 2 : 4;
+		Slot **new_chunks = (Slot **)memalloc(sizeof(Slot *) * new_capacity);
+		uint8_t **new_element_chunks = (uint8_t **)memalloc(sizeof(uint8_t *) * new_capacity);
+		for (uint32_t i = 0; i < chunk_capacity; i++) {
+			new_chunks[i] = chunks[i];
+			new_element_chunks[i] = element_chunks[i];
+		}
+		for (uint32_t i = chunk_capacity; i < new_capacity; i++) {
+			new_element_chunks[i] = NULL;
+		}
+		if (chunks) {
+			retired_chunks.push_back((Slot **)chunks);
+			memfree(element_chunks);
+		}
+		chunks = new_chunks;
+		element_chunks = new_element_chunks;
+		chunk_capacity = new_capacity;
+	}
+	if ((slot & CHUNK_MASK) == 0) {
+		Slot *new_chunk = (Slot *)memalloc(sizeof(Slot) * CHUNK_SIZE);
+		for (int i = 0; i < CHUNK_SIZE; i++) {
+			new_chunk[i].validator = 0;
+			new_chunk[i].next_free = NO_SLOT;
+			new_chunk[i].data = NULL;
+		}
+		chunks[chunk] = new_chunk;
+	}
+	atomic_increment(&slot_count);
+	return slot;
+}
+
+// Caller holds the mutex.
+RID RID_OwnerBase::_publish_slot(uint32_t p_slot, RID_Data *p_data) {
+
+	uint32_t validator = atomic_increment(&validator_counter) & 0x7FFFFFFF;
+	if (unlikely(validator == 0)) {
+		validator = atomic_increment(&validator_counter) & 0x7FFFFFFF;
+	}
+
+	// Publish the data before the validator that makes the RID resolve.
+	Slot *s = &chunks[p_slot >> CHUNK_BITS][p_slot & CHUNK_MASK];
+	s->data = p_data;
+	atomic_compare_and_swap(&s->validator, (uint32_t)0, validator);
+	owned_count++;
+
+	p_data->_id = validator;
+
+	RID rid;
+	rid._id = (uint64_t(validator) << 32) | p_slot;
+	return rid;
+}
+
+RID RID_OwnerBase::_make_rid(RID_Data *p_data) {
+
+	MutexLock lock(mutex);
+
+	return _publish_slot(_alloc_slot(), p_data);
+}
+
+void *RID_OwnerBase::_alloc_in_place(uint32_t &r_slot) {
+
+	MutexLock lock(mutex);
+
+	uint32_t slot = _alloc_slot();
+	uint32_t chunk = slot >> CHUNK_BITS;
+	if (!element_chunks[chunk]) {
+		element_chunks[chunk] = (uint8_t *)memalloc(element_size * CHUNK_SIZE);
+		if (!element_chunks[chunk]) {
+			chunks[chunk][slot & CHUNK_MASK].next_free = free_slots;
+			free_slots = slot;
+			return NULL;
+		}
+	}
+
+	// The slot is reserved but stays invalid until the object is made.
+	r_slot = slot;
+	return element_chunks[chunk] + (slot & CHUNK_MASK) * element_size;
+}
+
+RID RID_OwnerBase::_make_rid_in_place(uint32_t p_slot, RID_Data *p_data) {
+
+	MutexLock lock(mutex);
+
+	return _publish_slot(p_slot, p_data);
+}
+
+RID_Data *RID_OwnerBase::_free(const RID &p_rid, uint32_t &r_slot, bool &r_in_place) {
+
+	uint32_t slot = p_rid._id & 0xFFFFFFFF;
+	uint32_t validator = p_rid._id >> 32;
+
+	MutexLock lock(mutex);
+
+	ERR_FAIL_COND_V_MSG(slot >= slot_count || validator == 0, NULL, "Attempted to free an invalid RID.");
+
+	Slot *s = &chunks[slot >> CHUNK_BITS][slot & CHUNK_MASK];
+	ERR_FAIL_COND_V_MSG(atomic_compare_and_swap(&s->validator, validator, (uint32_t)0) != validator, NULL, "Attempted to free a RID that is not owned (already freed or from another owner).");
+	RID_Data *data = s->data;
+	s->data = NULL;
+	owned_count--;
+
+	uint8_t *elements = element_chunks[slot >> CHUNK_BITS];
+	r_slot = slot;
+	r_in_place = elements && (uint8_t *)data == elements + (slot & CHUNK_MASK) * element_size;
+	if (!r_in_place) {
+		s->next_free = free_slots;
+		free_slots = slot;
+	}
+	return data;
+}
+
+// Objects made in place keep their slot until they are destroyed, so it
+// can't be handed out again while the destructor runs.
+void RID_OwnerBase::_release_in_place(uint32_t p_slot) {
+
+	MutexLock lock(mutex);
+
+	chunks[p_slot >> CHUNK_BITS][p_slot & CHUNK_MASK].next_free = free_slots;
+	free_slots = p_slot;
+}
+
+void RID_OwnerBase::_get_owned_list(List<RID> *p_owned) const {
+
+	MutexLock lock(mutex);
+
+	for (uint32_t i = 0; i < slot_count; i++) {
+		const Slot &s = chunks[i >> CHUNK_BITS][i & CHUNK_MASK];
+		if (s.validator) {
+			RID rid;
+			rid._id = (uint64_t(s.validator) << 32) | i;
+			p_owned->push_back(rid);
+		}
+	}
+}
+
+RID_OwnerBase::RID_OwnerBase(uint32_t p_element_size) {
+
+	chunks = NULL;
+	element_chunks = NULL;
+	element_size = p_element_size;
+	chunk_capacity = 0;
+	slot_count = 0;
+	free_slots = NO_SLOT;
+	owned_count = 0;
+	mutex = Mutex::create();
+}
+
+RID_OwnerBase::~RID_OwnerBase() {
+
+	uint32_t chunk_count = (slot_count + CHUNK_MASK) >> CHUNK_BITS;
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		memfree(chunks[i]);
+		// Objects made in place that were never freed aren't destroyed,
+		// only their storage is released.
+		if (element_chunks[i]) {
+			memfree(element_chunks[i]);
+		}
+	}
+	if (chunks) {
+		memfree((Slot **)chunks);
+		memfree(element_chunks);
+	}
+	for (int i = 0; i < retired_chunks.size(); i++) {
+		memfree(retired_chunks[i]);
+	}
+	if (mutex) {
+		memdelete(mutex);
+	}
 }
@@ -33,9 +33,11 @@
 
 #include "core/list.h"
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
 #include "core/safe_refcount.h"
 #include "core/set.h"
 #include "core/typedefs.h"
+#include "core/vector.h"
 
 class RID_OwnerBase;
 
@@ -43,9 +45,6 @@ class RID_Data {
 
 	friend class RID_OwnerBase;
 
-#ifndef DEBUG_ENABLED
-	RID_OwnerBase *_owner;
-#endif
 	uint32_t _id;
 
 public:
@@ -54,151 +53,182 @@ public:
 	virtual ~RID_Data();
 };
 
+// A RID is a handle, the index of a slot in its owner plus the validator the
+// slot had when the RID was made. Owners hold the data pointers, so a RID
+// that was freed (or belongs to another owner) is detected without
+// dereferencing it.
 class RID {
 	friend class RID_OwnerBase;
 
-	mutable RID_Data *_data;
+	uint64_t _id;
 
 public:
-	_FORCE_INLINE_ RID_Data *get_data() const { return _data; }
-
 	_FORCE_INLINE_ bool operator==(const RID &p_rid) const {
 
-		return _data == p_rid._data;
+		return _id == p_rid._id;
 	}
 	_FORCE_INLINE_ bool operator<(const RID &p_rid) const {
 
-		return _data < p_rid._data;
+		return _id < p_rid._id;
 	}
 	_FORCE_INLINE_ bool operator<=(const RID &p_rid) const {
 
-		return _data <= p_rid._data;
+		return _id <= p_rid._id;
 	}
 	_FORCE_INLINE_ bool operator>(const RID &p_rid) const {
 
-		return _data > p_rid._data;
+		return _id > p_rid._id;
 	}
 	_FORCE_INLINE_ bool operator!=(const RID &p_rid) const {
 
-		return _data != p_rid._data;
+		return _id != p_rid._id;
 	}
-	_FORCE_INLINE_ bool is_valid() const { return _data != NULL; }
+	_FORCE_INLINE_ bool is_valid() const { return _id != 0; }
 
-	_FORCE_INLINE_ uint32_t get_id() const { return _data ? _data->get_id() : 0; }
+	_FORCE_INLINE_ uint32_t get_id() const { return _id >> 32; }
 
 	_FORCE_INLINE_ RID() {
-		_data = NULL;
+		_id = 0;
 	}
 };
 
 class RID_OwnerBase {
-protected:
-	static SafeRefCount refcount;
-	_FORCE_INLINE_ void _set_data(RID &p_rid, RID_Data *p_data) {
-		p_rid._data = p_data;
-		refcount.ref();
-		p_data->_id = refcount.get();
-#ifndef DEBUG_ENABLED
-		p_data->_owner = this;
-#endif
-	}
-
-#ifndef DEBUG_ENABLED
-
-	_FORCE_INLINE_ bool _is_owner(const RID &p_rid) const {
-
-		return this == p_rid._data->_owner;
-	}
 
-	_FORCE_INLINE_ void _remove_owner(RID &p_rid) {
+	enum {
+		CHUNK_BITS = 8,
+		CHUNK_SIZE = 1 << CHUNK_BITS,
+		CHUNK_MASK = CHUNK_SIZE - 1,
+		NO_SLOT = 0xFFFFFFFF,
+	};
+
+	struct Slot {
+		volatile uint32_t validator; // zero while the slot is free
+		uint32_t next_free;
+		RID_Data *volatile data;
+	};
+
+	// Chunks never move once allocated, and replaced chunk tables are only
+	// released with the owner, so lookups don't need to lock.
+	Slot *volatile *volatile chunks;
+	Vector<Slot **> retired_chunks;
+	// Storage for objects made in place, one block per chunk of slots,
+	// allocated the first time one is needed. Only used under the mutex.
+	uint8_t **element_chunks;
+	uint32_t element_size;
+	uint32_t chunk_capacity;
+	volatile uint32_t slot_count;
+	uint32_t free_slots;
+	uint32_t owned_count;
+	Mutex *mutex; // only taken to make and free RIDs
+
+	static uint32_t validator_counter;
+
+	uint32_t _alloc_slot();
+	RID _publish_slot(uint32_t p_slot, RID_Data *p_data);
 
-		p_rid._data->_owner = NULL;
+protected:
+	RID _make_rid(RID_Data *p_data);
+	void *_alloc_in_place(uint32_t &r_slot);
+	RID _make_rid_in_place(uint32_t p_slot, RID_Data *p_data);
+	RID_Data *_free(const RID &p_rid, uint32_t &r_slot, bool &r_in_place);
+	void _release_in_place(uint32_t p_slot);
+	void _get_owned_list(List<RID> *p_owned) const;
+
+	_FORCE_INLINE_ RID_Data *_get_data(const RID &p_rid) const {
+
+		uint32_t slot = p_rid._id & 0xFFFFFFFF;
+		uint32_t validator = p_rid._id >> 32;
+		if (unlikely(slot >= atomic_load_acquire(&slot_count) || validator == 0))
+			return NULL;
+
+		Slot &s = chunks[slot >> CHUNK_BITS][slot & CHUNK_MASK];
+		if (atomic_load_acquire(&s.validator) != validator)
+			return NULL;
+		RID_Data *data = atomic_load_acquire(&s.data);
+		// The slot may have been freed and reused while reading it.
+		if (atomic_load_acquire(&s.validator) != validator)
+			return NULL;
+		return data;
 	}
-#endif
 
 public:
 	virtual void get_owned_list(List<RID> *p_owned) = 0;
 
+	_FORCE_INLINE_ uint32_t get_rid_count() const { return owned_count; }
+
 	static void init_rid();
-	virtual ~RID_OwnerBase() {}
+
+	RID_OwnerBase(uint32_t p_element_size = 0);
+	virtual ~RID_OwnerBase();
 };
 
+// Objects are either allocated by the caller and handed over with
+// make_rid(T *), in which case the caller deletes them after free(), or made
+// by the owner in its own chunked storage with make_rid(), in which case
+// free() destroys them.
 template <class T>
 class RID_Owner : public RID_OwnerBase {
-public:
-#ifdef DEBUG_ENABLED
-	mutable Set<RID_Data *> id_map;
-#endif
 public:
 	_FORCE_INLINE_ RID make_rid(T *p_data) {
 
-		RID rid;
-		_set_data(rid, p_data);
+		return _make_rid(p_data);
+	}
 
-#ifdef DEBUG_ENABLED
-		id_map.insert(p_data);
-#endif
+	RID make_rid() {
 
-		return rid;
+		uint32_t slot;
+		void *mem = _alloc_in_place(slot);
+		ERR_FAIL_COND_V(!mem, RID());
+		return _make_rid_in_place(slot, memnew_placement(mem, T));
 	}
 
 	_FORCE_INLINE_ T *get(const RID &p_rid) {
 
-#ifdef DEBUG_ENABLED
-
 		ERR_FAIL_COND_V(!p_rid.is_valid(), NULL);
-		ERR_FAIL_COND_V(!id_map.has(p_rid.get_data()), NULL);
-#endif
-		return static_cast<T *>(p_rid.get_data());
+		RID_Data *data = _get_data(p_rid);
+		ERR_FAIL_COND_V(!data, NULL);
+		return static_cast<T *>(data);
 	}
 
 	_FORCE_INLINE_ T *getornull(const RID &p_rid) {
 
+		RID_Data *data = _get_data(p_rid);
 #ifdef DEBUG_ENABLED
-
-		if (p_rid.get_data()) {
-			ERR_FAIL_COND_V(!id_map.has(p_rid.get_data()), NULL);
+		if (p_rid.is_valid()) {
+			ERR_FAIL_COND_V(!data, NULL);
 		}
 #endif
-		return static_cast<T *>(p_rid.get_data());
+		return static_cast<T *>(data);
 	}
 
 	_FORCE_INLINE_ T *getptr(const RID &p_rid) {
 
-		return static_cast<T *>(p_rid.get_data());
+		return static_cast<T *>(_get_data(p_rid));
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
 
-		if (p_rid.get_data() == NULL)
-			return false;
-#ifdef DEBUG_ENABLED
-		return id_map.has(p_rid.get_data());
-#else
-		return _is_owner(p_rid);
-#endif
+		return _get_data(p_rid) != NULL;
 	}
 
 	void free(RID p_rid) {
 
-#ifdef DEBUG_ENABLED
-		id_map.erase(p_rid.get_data());
-#else
-		_remove_owner(p_rid);
-#endif
+		uint32_t slot;
+		bool in_place;
+		T *data = static_cast<T *>(_free(p_rid, slot, in_place));
+		if (data && in_place) {
+			data->~T();
+			_release_in_place(slot);
+		}
 	}
 
 	void get_owned_list(List<RID> *p_owned) {
 
-#ifdef DEBUG_ENABLED
-
-		for (typename Set<RID_Data *>::Element *E = id_map.front(); E; E = E->next()) {
-			RID r;
-			_set_data(r, static_cast<T *>(E->get()));
-			p_owned->push_back(r);
-		}
-#endif
+		_get_owned_list(p_owned);
 	}
+
+	RID_Owner() :
+			RID_OwnerBase(sizeof(T)) {}
 };
 
 #endif
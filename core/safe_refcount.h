@@ -93,6 +93,28 @@ static _ALWAYS_INLINE_ T atomic_exchange_if_greater(volatile T *pw, volatile V v
 	return *pw;
 }
 
+template <class T, class V>
+static _ALWAYS_INLINE_ T atomic_compare_and_swap(volatile T *pw, volatile V expected, volatile V val) {
+
+	T tmp = *pw;
+	if (tmp == expected)
+		*pw = val;
+
+	return tmp;
+}
+
+template <class T>
+static _ALWAYS_INLINE_ T atomic_load_acquire(volatile T *pw) {
+
+	return *pw;
+}
+
+template <class T, class V>
+static _ALWAYS_INLINE_ void atomic_store_release(volatile T *pw, volatile V val) {
+
+	*pw = val;
+}
+
 #elif defined(__GNUC__)
 
 /* Implementation for GCC & Clang */
@@ -148,6 +170,26 @@ static _ALWAYS_INLINE_ T atomic_exchange_if_greater(volatile T *pw, volatile V v
 	}
 }
 
+template <class T, class V>
+static _ALWAYS_INLINE_ T atomic_compare_and_swap(volatile T *pw, volatile V expected, volatile V val) {
+
+	return __sync_val_compare_and_swap(pw, expected, val);
+}
+
+// Later reads can't be moved before it, pairs with the full barrier of the functions above.
+template <class T>
+static _ALWAYS_INLINE_ T atomic_load_acquire(volatile T *pw) {
+
+	return __atomic_load_n(pw, __ATOMIC_ACQUIRE);
+}
+
+// Earlier writes can't be moved after it, pairs with atomic_load_acquire().
+template <class T, class V>
+static _ALWAYS_INLINE_ void atomic_store_release(volatile T *pw, volatile V val) {
+
+	__atomic_store_n(pw, val, __ATOMIC_RELEASE);
+}
+
 #elif defined(_MSC_VER)
 // For MSVC use a separate compilation unit to prevent windows.h from polluting
 // the global namespace.
@@ -157,6 +199,7 @@ uint32_t atomic_increment(volatile uint32_t *pw);
 uint32_t atomic_sub(volatile uint32_t *pw, volatile uint32_t val);
 uint32_t atomic_add(volatile uint32_t *pw, volatile uint32_t val);
 uint32_t atomic_exchange_if_greater(volatile uint32_t *pw, volatile uint32_t val);
+uint32_t atomic_compare_and_swap(volatile uint32_t *pw, volatile uint32_t expected, volatile uint32_t val);
 
 uint64_t atomic_conditional_increment(volatile uint64_t *pw);
 uint64_t atomic_decrement(volatile uint64_t *pw);
@@ -164,6 +207,19 @@ uint64_t atomic_increment(volatile uint64_t *pw);
 uint64_t atomic_sub(volatile uint64_t *pw, volatile uint64_t val);
 uint64_t atomic_add(volatile uint64_t *pw, volatile uint64_t val);
 uint64_t atomic_exchange_if_greater(volatile uint64_t *pw, volatile uint64_t val);
+uint64_t atomic_compare_and_swap(volatile uint64_t *pw, volatile uint64_t expected, volatile uint64_t val);
+
+uint32_t atomic_load_acquire(volatile uint32_t *pw);
+uint64_t atomic_load_acquire(volatile uint64_t *pw);
+void atomic_store_release(volatile uint32_t *pw, volatile uint32_t val);
+void atomic_store_release(volatile uint64_t *pw, volatile uint64_t val);
+void *atomic_load_acquire(void *volatile *pw);
+
+template <class T>
+static _ALWAYS_INLINE_ T *atomic_load_acquire(T *volatile *pw) {
+
+	return static_cast<T *>(atomic_load_acquire(reinterpret_cast<void *volatile *>(pw)));
+}
 
 #else
 //no threads supported?
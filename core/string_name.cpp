@@ -39,7 +39,244 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+/*
+ * Names are interned in an open addressing table of _Data pointers.
+ *
+ * Looking up a name that already exists takes no lock: the reader announces
+ * itself in one of the reader counters, probes the current table and takes a
+ * conditional reference on the match, which fails if the name is being released.
+ * Everything that changes the table (adding a name, removing the last reference
+ * to one, growing the table) happens under the mutex, and nothing a reader may
+ * still be looking at is freed right away: removed names and replaced tables are
+ * retired and freed once no reader is active. A reader that misses (because the
+ * name is new, or is being added or released concurrently) takes the locked path,
+ * which looks again before adding it.
+ */
+
+#define STRING_NAME_DELETED ((_Data *)1)
+
+struct StringName::_Table {
+
+	uint32_t mask;
+	uint32_t used; // live entries and deleted ones
+	_Data *volatile *slots;
+	_Table *next_retired;
+
+	// waiting for readers to leave, only touched under the lock
+	static _Data *retired_names;
+	static _Table *retired_tables;
+
+	static _Table *create(uint32_t p_size) {
+
+		_Table *table = memnew(_Table);
+		table->mask = p_size - 1;
+		table->used = 0;
+		table->slots = (_Data *volatile *)memalloc(sizeof(_Data *) * p_size);
+		for (uint32_t i = 0; i < p_size; i++) {
+			table->slots[i] = NULL;
+		}
+		table->next_retired = NULL;
+		return table;
+	}
+
+	static void destroy(_Table *p_table) {
+
+		memfree((void *)p_table->slots);
+		memdelete(p_table);
+	}
+};
+
+StringName::_Table *volatile StringName::_table = NULL;
+StringName::_Data *StringName::_Table::retired_names = NULL;
+StringName::_Table *StringName::_Table::retired_tables = NULL;
+
+enum {
+	READER_SHARDS = 16
+};
+
+// readers spread over padded counters, so concurrent lookups don't fight over a cache line
+struct _StringNameReaders {
+
+	volatile uint32_t count;
+	uint8_t padding[64 - sizeof(uint32_t)];
+};
+
+static _StringNameReaders _readers[READER_SHARDS];
+static volatile uint32_t _reader_shard_count = 0;
+static thread_local int _reader_shard = -1;
+
+static _FORCE_INLINE_ volatile uint32_t *_enter_read() {
+
+	if (unlikely(_reader_shard < 0)) {
+		_reader_shard = atomic_increment(&_reader_shard_count) % READER_SHARDS;
+	}
+
+	volatile uint32_t *count = &_readers[_reader_shard].count;
+	atomic_increment(count); // full barrier, the table is only read after this
+	return count;
+}
+
+static _FORCE_INLINE_ void _exit_read(volatile uint32_t *p_count) {
+
+	atomic_decrement(p_count);
+}
+
+static bool _readers_active() {
+
+	for (int i = 0; i < READER_SHARDS; i++) {
+		if (_readers[i].count) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool StringName::_Data::equals(const char *p_name) const {
+
+	if (cname) {
+		return strcmp(cname, p_name) == 0;
+	}
+	return name == p_name;
+}
+
+bool StringName::_Data::equals(const CharType *p_name) const {
+
+	if (cname) {
+		const char *c = cname;
+		while (*c && (CharType)(uint8_t)*c == *p_name) {
+			c++;
+			p_name++;
+		}
+		return (CharType)(uint8_t)*c == *p_name;
+	}
+	return name == p_name;
+}
+
+bool StringName::_Data::equals(const String &p_name) const {
+
+	if (cname) {
+		return p_name == cname;
+	}
+	return name == p_name;
+}
+
+// caller either holds the lock or is registered as a reader
+template <class T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash) {
+
+	_Table *table = _table;
+	uint32_t pos = p_hash & table->mask;
+
+	while (true) {
+
+		_Data *d = table->slots[pos];
+		if (!d) {
+			return NULL;
+		}
+		// compare hash first
+		if (d != STRING_NAME_DELETED && d->hash == p_hash && d->equals(p_name) && d->refcount.ref()) {
+			return d;
+		}
+		pos = (pos + 1) & table->mask;
+	}
+}
+
+template <class T>
+StringName::_Data *StringName::_search(const T &p_name, uint32_t p_hash) {
+
+	volatile uint32_t *reader = _enter_read();
+	_Data *d = _find(p_name, p_hash);
+	_exit_read(reader);
+	return d;
+}
+
+void StringName::_insert(_Data *p_data) {
+
+	_Table *table = _table;
+
+	if ((table->used + 1) * 2 > table->mask + 1) {
+
+		// count what survives, and make room for as much again
+		uint32_t live = 0;
+		for (uint32_t i = 0; i <= table->mask; i++) {
+			if (table->slots[i] && table->slots[i] != STRING_NAME_DELETED) {
+				live++;
+			}
+		}
+		uint32_t size = STRING_TABLE_LEN;
+		while (size < (live + 1) * 4) {
+			size <<= 1;
+		}
+
+		_Table *new_table = _Table::create(size);
+		for (uint32_t i = 0; i <= table->mask; i++) {
+			_Data *d = table->slots[i];
+			if (!d || d == STRING_NAME_DELETED) {
+				continue;
+			}
+			uint32_t pos = d->hash & new_table->mask;
+			while (new_table->slots[pos]) {
+				pos = (pos + 1) & new_table->mask;
+			}
+			new_table->slots[pos] = d;
+		}
+		new_table->used = live;
+
+		// publish the filled table, readers still on the old one keep it alive until they leave
+		atomic_compare_and_swap((volatile uintptr_t *)&_table, (uintptr_t)table, (uintptr_t)new_table);
+		table->next_retired = _Table::retired_tables;
+		_Table::retired_tables = table;
+		table = new_table;
+	}
+
+	uint32_t pos = p_data->hash & table->mask;
+	while (table->slots[pos] && table->slots[pos] != STRING_NAME_DELETED) {
+		pos = (pos + 1) & table->mask;
+	}
+
+	_Data *prev = table->slots[pos];
+	if (!prev) {
+		table->used++;
+	}
+	// the data must be complete before it becomes visible
+	atomic_compare_and_swap((volatile uintptr_t *)&table->slots[pos], (uintptr_t)prev, (uintptr_t)p_data);
+}
+
+void StringName::_remove(_Data *p_data) {
+
+	_Table *table = _table;
+	uint32_t pos = p_data->hash & table->mask;
+
+	while (table->slots[pos] != p_data) {
+
+		ERR_FAIL_COND(!table->slots[pos]);
+		pos = (pos + 1) & table->mask;
+	}
+
+	atomic_compare_and_swap((volatile uintptr_t *)&table->slots[pos], (uintptr_t)p_data, (uintptr_t)STRING_NAME_DELETED);
+
+	p_data->next_retired = _Table::retired_names;
+	_Table::retired_names = p_data;
+}
+
+void StringName::_reclaim() {
+
+	if ((!_Table::retired_names && !_Table::retired_tables) || _readers_active()) {
+		return;
+	}
+
+	while (_Table::retired_names) {
+		_Data *d = _Table::retired_names;
+		_Table::retired_names = d->next_retired;
+		memdelete(d);
+	}
+
+	while (_Table::retired_tables) {
+		_Table *t = _Table::retired_tables;
+		_Table::retired_tables = t->next_retired;
+		_Table::destroy(t);
+	}
+}
 
 StringName _scs_create(const char *p_chr) {
 
@@ -54,10 +291,7 @@ void StringName::setup() {
 	lock = Mutex::create();
 
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		_table[i] = NULL;
-	}
+	_table = _Table::create(STRING_TABLE_LEN);
 	configured = true;
 }
 
@@ -66,27 +300,31 @@ void StringName::cleanup() {
 	lock->lock();
 
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		while (_table[i]) {
-
-			_Data *d = _table[i];
-			lost_strings++;
-			if (OS::get_singleton()->is_stdout_verbose()) {
-				if (d->cname) {
-					print_line("Orphan StringName: " + String(d->cname));
-				} else {
-					print_line("Orphan StringName: " + String(d->name));
-				}
-			}
+	for (uint32_t i = 0; i <= _table->mask; i++) {
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+		_Data *d = _table->slots[i];
+		if (!d || d == STRING_NAME_DELETED) {
+			continue;
 		}
+
+		lost_strings++;
+		if (OS::get_singleton()->is_stdout_verbose()) {
+			if (d->cname) {
+				print_line("Orphan StringName: " + String(d->cname));
+			} else {
+				print_line("Orphan StringName: " + String(d->name));
+			}
+		}
+
+		memdelete(d);
 	}
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
+
+	_reclaim();
+	_Table::destroy(_table);
+	_table = NULL;
 	lock->unlock();
 
 	memdelete(lock);
@@ -99,20 +337,8 @@ void StringName::unref() {
 	if (_data && _data->refcount.unref()) {
 
 		lock->lock();
-
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		memdelete(_data);
+		_remove(_data);
+		_reclaim();
 		lock->unlock();
 	}
 
@@ -126,7 +352,7 @@ bool StringName::operator==(const String &p_name) const {
 		return (p_name.length() == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->equals(p_name);
 }
 
 bool StringName::operator==(const char *p_name) const {
@@ -136,7 +362,7 @@ bool StringName::operator==(const char *p_name) const {
 		return (p_name[0] == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->equals(p_name);
 }
 
 bool StringName::operator!=(const String &p_name) const {
@@ -184,41 +410,27 @@ StringName::StringName(const char *p_name) {
 	if (!p_name || p_name[0] == 0)
 		return; //empty, ignore
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
+	_data = _search(p_name, hash);
+	if (_data) {
+		return; // exists
 	}
 
+	lock->lock();
+
+	_data = _find(p_name, hash);
 	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock->unlock();
-			return;
-		}
+		lock->unlock();
+		return;
 	}
 
 	_data = memnew(_Data);
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(_data);
 
 	lock->unlock();
 }
@@ -231,41 +443,27 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr)
-			break;
-		_data = _data->next;
+	_data = _search(p_static_string.ptr, hash);
+	if (_data) {
+		return; // exists
 	}
 
+	lock->lock();
+
+	_data = _find(p_static_string.ptr, hash);
 	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock->unlock();
-			return;
-		}
+		lock->unlock();
+		return;
 	}
 
 	_data = memnew(_Data);
 
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(_data);
 
 	lock->unlock();
 }
@@ -279,40 +477,27 @@ StringName::StringName(const String &p_name) {
 	if (p_name == String())
 		return;
 
-	lock->lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
+	_data = _search(p_name, hash);
+	if (_data) {
+		return; // exists
 	}
 
+	lock->lock();
+
+	_data = _find(p_name, hash);
 	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock->unlock();
-			return;
-		}
+		lock->unlock();
+		return;
 	}
 
 	_data = memnew(_Data);
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(_data);
 
 	lock->unlock();
 }
@@ -325,29 +510,11 @@ StringName StringName::search(const char *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		lock->unlock();
-
+	_Data *_data = _search(p_name, String::hash(p_name));
+	if (_data) {
 		return StringName(_data);
 	}
 
-	lock->unlock();
 	return StringName(); //does not exist
 }
 
@@ -359,57 +526,43 @@ StringName StringName::search(const CharType *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+	_Data *_data = _search(p_name, String::hash(p_name));
+	if (_data) {
 		return StringName(_data);
 	}
 
-	lock->unlock();
 	return StringName(); //does not exist
 }
 StringName StringName::search(const String &p_name) {
 
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	lock->lock();
+	_Data *_data = _search(p_name, p_name.hash());
+	if (_data) {
+		return StringName(_data);
+	}
 
-	uint32_t hash = p_name.hash();
+	return StringName(); //does not exist
+}
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+uint32_t StringName::get_table_size() {
 
-	_Data *_data = _table[idx];
+	ERR_FAIL_COND_V(!configured, 0);
 
-	while (_data) {
+	lock->lock();
+	uint32_t size = _table->mask + 1;
+	lock->unlock();
+	return size;
+}
 
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name())
-			break;
-		_data = _data->next;
-	}
+uint32_t StringName::get_table_used() {
 
-	if (_data && _data->refcount.ref()) {
-		lock->unlock();
-		return StringName(_data);
-	}
+	ERR_FAIL_COND_V(!configured, 0);
 
+	lock->lock();
+	uint32_t used = _table->used;
 	lock->unlock();
-	return StringName(); //does not exist
+	return used;
 }
 
 StringName::StringName() {
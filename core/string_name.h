@@ -46,8 +46,7 @@ class StringName {
 	enum {
 
 		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS, // initial size of the table, it grows as needed
 	};
 
 	struct _Data {
@@ -56,19 +55,20 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
+		bool equals(const char *p_name) const;
+		bool equals(const CharType *p_name) const;
+		bool equals(const String &p_name) const;
 		uint32_t hash;
-		_Data *prev;
-		_Data *next;
+		_Data *next_retired;
 		_Data() {
 			cname = NULL;
-			next = prev = NULL;
-			idx = 0;
+			next_retired = NULL;
 			hash = 0;
 		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct _Table;
+	static _Table *volatile _table;
 
 	_Data *_data;
 
@@ -82,6 +82,14 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 
+	template <class T>
+	static _Data *_find(const T &p_name, uint32_t p_hash);
+	template <class T>
+	static _Data *_search(const T &p_name, uint32_t p_hash);
+	static void _insert(_Data *p_data);
+	static void _remove(_Data *p_data);
+	static void _reclaim();
+
 	static Mutex *lock;
 	static void setup();
 	static void cleanup();
@@ -132,6 +140,10 @@ public:
 	static StringName search(const CharType *p_name);
 	static StringName search(const String &p_name);
 
+	// Slots in the intern table, and how many of them hold a name or a tombstone.
+	static uint32_t get_table_size();
+	static uint32_t get_table_used();
+
 	struct AlphCompare {
 
 		_FORCE_INLINE_ bool operator()(const StringName &l, const StringName &r) const {
@@ -120,6 +120,7 @@ public:
 
 private:
 	friend struct _VariantCall;
+	friend class VariantInternal;
 	// Variant takes 20 bytes when real_t is float, and 36 if double
 	// it only allocates extra memory for aabb/matrix.
 
@@ -359,7 +360,12 @@ public:
 		Type expected;
 	};
 
+	// method of a built-in type, resolved once with get_builtin_method() and valid until the types are unregistered
+	struct BuiltinMethod;
+
 	void call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error);
+	void call_builtin(const BuiltinMethod *p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error);
+	static const BuiltinMethod *get_builtin_method(Variant::Type p_type, const StringName &p_method);
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, CallError &r_error);
 	Variant call(const StringName &p_method, const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant());
 
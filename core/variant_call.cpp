@@ -41,91 +41,154 @@
 typedef void (*VariantFunc)(Variant &r_ret, Variant &p_self, const Variant **p_args);
 typedef void (*VariantConstructFunc)(Variant &r_ret, const Variant **p_args);
 
-struct _VariantCall {
-
-	static void Vector3_dot(Variant &r_ret, Variant &p_self, const Variant **p_args) {
-
-		r_ret = reinterpret_cast<Vector3 *>(p_self._data._mem)->dot(*reinterpret_cast<const Vector3 *>(p_args[0]->_data._mem));
-	}
-
-	struct FuncData {
+struct Variant::BuiltinMethod {
 
-		int arg_count;
-		Vector<Variant> default_args;
-		Vector<Variant::Type> arg_types;
-		Vector<StringName> arg_names;
-		Variant::Type return_type;
+	StringName name;
+	Variant::Type type;
+	int arg_count;
+	Vector<Variant> default_args;
+	Vector<Variant::Type> arg_types;
+	Vector<StringName> arg_names;
+	Variant::Type return_type;
 
-		bool _const;
-		bool returns;
+	bool _const;
+	bool returns;
 
-		VariantFunc func;
+	VariantFunc func;
 
-		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Variant::CallError &r_error) {
+	_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Variant::CallError &r_error) const {
 
-			if (arg_count == 0)
-				return true;
+		if (arg_count == 0)
+			return true;
 
-			const Variant::Type *tptr = &arg_types[0];
+		const Variant::Type *tptr = &arg_types[0];
 
-			for (int i = 0; i < arg_count; i++) {
+		for (int i = 0; i < arg_count; i++) {
 
-				if (tptr[i] == Variant::NIL || tptr[i] == p_args[i]->type)
-					continue; // all good
-				if (!Variant::can_convert(p_args[i]->type, tptr[i])) {
-					r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
-					r_error.argument = i;
-					r_error.expected = tptr[i];
-					return false;
-				}
+			if (tptr[i] == Variant::NIL || tptr[i] == p_args[i]->type)
+				continue; // all good
+			if (!Variant::can_convert(p_args[i]->type, tptr[i])) {
+				r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+				r_error.argument = i;
+				r_error.expected = tptr[i];
+				return false;
 			}
-			return true;
 		}
+		return true;
+	}
 
-		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+	_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Variant::CallError &r_error) const {
 #ifdef DEBUG_ENABLED
-			if (p_argcount > arg_count) {
-				r_error.error = Variant::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
-				r_error.argument = arg_count;
-				return;
-			} else
+		if (p_argcount > arg_count) {
+			r_error.error = Variant::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
+			r_error.argument = arg_count;
+			return;
+		} else
 #endif
-					if (p_argcount < arg_count) {
-				int def_argcount = default_args.size();
+				if (p_argcount < arg_count) {
+			int def_argcount = default_args.size();
 #ifdef DEBUG_ENABLED
-				if (p_argcount < (arg_count - def_argcount)) {
-					r_error.error = Variant::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
-					r_error.argument = arg_count - def_argcount;
-					return;
-				}
+			if (p_argcount < (arg_count - def_argcount)) {
+				r_error.error = Variant::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+				r_error.argument = arg_count - def_argcount;
+				return;
+			}
 
 #endif
-				ERR_FAIL_COND(p_argcount > VARIANT_ARG_MAX);
-				const Variant *newargs[VARIANT_ARG_MAX];
-				for (int i = 0; i < p_argcount; i++)
-					newargs[i] = p_args[i];
-				// fill in any remaining parameters with defaults
-				int first_default_arg = arg_count - def_argcount;
-				for (int i = p_argcount; i < arg_count; i++)
-					newargs[i] = &default_args[i - first_default_arg];
+			ERR_FAIL_COND(p_argcount > VARIANT_ARG_MAX);
+			const Variant *newargs[VARIANT_ARG_MAX];
+			for (int i = 0; i < p_argcount; i++)
+				newargs[i] = p_args[i];
+			// fill in any remaining parameters with defaults
+			int first_default_arg = arg_count - def_argcount;
+			for (int i = p_argcount; i < arg_count; i++)
+				newargs[i] = &default_args[i - first_default_arg];
 #ifdef DEBUG_ENABLED
-				if (!verify_arguments(newargs, r_error))
-					return;
+			if (!verify_arguments(newargs, r_error))
+				return;
 #endif
-				func(r_ret, p_self, newargs);
-			} else {
+			func(r_ret, p_self, newargs);
+		} else {
 #ifdef DEBUG_ENABLED
-				if (!verify_arguments(p_args, r_error))
-					return;
+			if (!verify_arguments(p_args, r_error))
+				return;
 #endif
-				func(r_ret, p_self, p_args);
-			}
+			func(r_ret, p_self, p_args);
 		}
-	};
+	}
+};
 
+struct _VariantCall {
+
+	static void Vector3_dot(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+
+		r_ret = reinterpret_cast<Vector3 *>(p_self._data._mem)->dot(*reinterpret_cast<const Vector3 *>(p_args[0]->_data._mem));
+	}
+
+	typedef Variant::BuiltinMethod FuncData;
+
+	// functions are kept in registration order, lookups go through an open-addressing index on the
+	// name hash (StringNames are unique, so probing only compares pointers)
 	struct TypeFunc {
 
-		Map<StringName, FuncData> functions;
+		Vector<FuncData *> functions;
+		FuncData **index;
+		uint32_t index_mask;
+
+		_FORCE_INLINE_ FuncData *find(const StringName &p_name) const {
+
+			if (!index)
+				return NULL;
+
+			uint32_t pos = p_name.hash() & index_mask;
+			while (index[pos]) {
+				if (index[pos]->name == p_name)
+					return index[pos];
+				pos = (pos + 1) & index_mask;
+			}
+			return NULL;
+		}
+
+		void insert(FuncData *p_func) {
+
+			// keep the index at most half full so probe sequences stay short
+			uint32_t capacity = index ? index_mask + 1 : 0;
+			if ((uint32_t)(functions.size() + 1) * 2 > capacity) {
+
+				uint32_t new_capacity = MAX(capacity * 2, 16u);
+				if (index)
+					memfree(index);
+				index = (FuncData **)memalloc(sizeof(FuncData *) * new_capacity);
+				zeromem(index, sizeof(FuncData *) * new_capacity);
+				index_mask = new_capacity - 1;
+
+				for (int i = 0; i < functions.size(); i++)
+					_insert_index(functions[i]);
+			}
+
+			functions.push_back(p_func);
+			_insert_index(p_func);
+		}
+
+		_FORCE_INLINE_ void _insert_index(FuncData *p_func) {
+
+			uint32_t pos = p_func->name.hash() & index_mask;
+			while (index[pos])
+				pos = (pos + 1) & index_mask;
+			index[pos] = p_func;
+		}
+
+		TypeFunc() {
+			index = NULL;
+			index_mask = 0;
+		}
+
+		~TypeFunc() {
+			for (int i = 0; i < functions.size(); i++)
+				memdelete(functions[i]);
+			if (index)
+				memfree(index);
+		}
 	};
 
 	static TypeFunc *type_funcs;
@@ -145,13 +208,17 @@ struct _VariantCall {
 	static void make_func_return_variant(Variant::Type p_type, const StringName &p_name) {
 
 #ifdef DEBUG_ENABLED
-		type_funcs[p_type].functions[p_name].returns = true;
+		FuncData *funcdata = type_funcs[p_type].find(p_name);
+		ERR_FAIL_COND(!funcdata);
+		funcdata->returns = true;
 #endif
 	}
 
 	static void addfunc(bool p_const, Variant::Type p_type, Variant::Type p_return, bool p_has_return, const StringName &p_name, VariantFunc p_func, const Vector<Variant> &p_defaultarg, const Arg &p_argtype1 = Arg(), const Arg &p_argtype2 = Arg(), const Arg &p_argtype3 = Arg(), const Arg &p_argtype4 = Arg(), const Arg &p_argtype5 = Arg()) {
 
 		FuncData funcdata;
+		funcdata.name = p_name;
+		funcdata.type = p_type;
 		funcdata.func = p_func;
 		funcdata.default_args = p_defaultarg;
 		funcdata._const = p_const;
@@ -204,7 +271,13 @@ struct _VariantCall {
 	end:
 
 		funcdata.arg_count = funcdata.arg_types.size();
-		type_funcs[p_type].functions[p_name] = funcdata;
+
+		FuncData *existing = type_funcs[p_type].find(p_name);
+		if (existing) {
+			*existing = funcdata;
+		} else {
+			type_funcs[p_type].insert(memnew(FuncData(funcdata)));
+		}
 	}
 
 #define VCALL_LOCALMEM0(m_type, m_method) \
@@ -717,6 +790,192 @@ struct _VariantCall {
 	VCALL_LOCALMEM1(PoolColorArray, append_array);
 	VCALL_LOCALMEM0(PoolColorArray, invert);
 
+	// bulk math on pooled arrays, the kernels run over the flat components so compilers can vectorize them
+
+	template <class T>
+	static void _components_add(T *r_dst, const T *p_src, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			r_dst[i] += p_src[i];
+		}
+	}
+
+	template <class T>
+	static void _components_multiply(T *r_dst, const T *p_src, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			r_dst[i] *= p_src[i];
+		}
+	}
+
+	template <class T>
+	static void _components_scale(T *r_dst, T p_scale, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			r_dst[i] *= p_scale;
+		}
+	}
+
+	template <class T>
+	static void _components_lerp(T *r_dst, const T *p_to, T p_weight, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			r_dst[i] += (p_to[i] - r_dst[i]) * p_weight;
+		}
+	}
+
+	template <class T>
+	static T _components_dot(const T *p_a, const T *p_b, int p_count) {
+		// four independent sums, so the additions don't wait on each other
+		T sum[4] = { 0, 0, 0, 0 };
+		int i = 0;
+		for (; i + 4 <= p_count; i += 4) {
+			sum[0] += p_a[i + 0] * p_b[i + 0];
+			sum[1] += p_a[i + 1] * p_b[i + 1];
+			sum[2] += p_a[i + 2] * p_b[i + 2];
+			sum[3] += p_a[i + 3] * p_b[i + 3];
+		}
+		for (; i < p_count; i++) {
+			sum[0] += p_a[i] * p_b[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+	}
+
+#define VCALL_POOL_COMPONENT_OPS(m_type, m_scalar, m_components)                                                                     \
+	static void _call_##m_type##_add(Variant &r_ret, Variant &p_self, const Variant **p_args) {                                      \
+		m_type *self = reinterpret_cast<m_type *>(p_self._data._mem);                                                                \
+		m_type other = *p_args[0];                                                                                                   \
+		ERR_FAIL_COND_MSG(other.size() != self->size(), "Arrays must have the same size.");                                          \
+		if (self->size() == 0)                                                                                                       \
+			return;                                                                                                                  \
+		m_type::Write w = self->write();                                                                                             \
+		m_type::Read r = other.read();                                                                                               \
+		_components_add((m_scalar *)w.ptr(), (const m_scalar *)r.ptr(), self->size() * m_components);                                \
+	}                                                                                                                                \
+	static void _call_##m_type##_multiply(Variant &r_ret, Variant &p_self, const Variant **p_args) {                                 \
+		m_type *self = reinterpret_cast<m_type *>(p_self._data._mem);                                                                \
+		m_type other = *p_args[0];                                                                                                   \
+		ERR_FAIL_COND_MSG(other.size() != self->size(), "Arrays must have the same size.");                                          \
+		if (self->size() == 0)                                                                                                       \
+			return;                                                                                                                  \
+		m_type::Write w = self->write();                                                                                             \
+		m_type::Read r = other.read();                                                                                               \
+		_components_multiply((m_scalar *)w.ptr(), (const m_scalar *)r.ptr(), self->size() * m_components);                           \
+	}                                                                                                                                \
+	static void _call_##m_type##_scale(Variant &r_ret, Variant &p_self, const Variant **p_args) {                                    \
+		m_type *self = reinterpret_cast<m_type *>(p_self._data._mem);                                                                \
+		if (self->size() == 0)                                                                                                       \
+			return;                                                                                                                  \
+		m_type::Write w = self->write();                                                                                             \
+		_components_scale((m_scalar *)w.ptr(), (m_scalar)(real_t)*p_args[0], self->size() * m_components);                           \
+	}                                                                                                                                \
+	static void _call_##m_type##_lerp(Variant &r_ret, Variant &p_self, const Variant **p_args) {                                     \
+		m_type *self = reinterpret_cast<m_type *>(p_self._data._mem);                                                                \
+		m_type to = *p_args[0];                                                                                                      \
+		ERR_FAIL_COND_MSG(to.size() != self->size(), "Arrays must have the same size.");                                             \
+		if (self->size() == 0)                                                                                                       \
+			return;                                                                                                                  \
+		m_type::Write w = self->write();                                                                                             \
+		m_type::Read r = to.read();                                                                                                  \
+		_components_lerp((m_scalar *)w.ptr(), (const m_scalar *)r.ptr(), (m_scalar)(real_t)*p_args[1], self->size() * m_components); \
+	}
+
+	VCALL_POOL_COMPONENT_OPS(PoolRealArray, real_t, 1);
+	VCALL_POOL_COMPONENT_OPS(PoolVector2Array, real_t, 2);
+	VCALL_POOL_COMPONENT_OPS(PoolVector3Array, real_t, 3);
+	VCALL_POOL_COMPONENT_OPS(PoolColorArray, float, 4);
+
+	static void _call_PoolRealArray_dot(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+		PoolRealArray *self = reinterpret_cast<PoolRealArray *>(p_self._data._mem);
+		PoolRealArray other = *p_args[0];
+		r_ret = 0.0;
+		ERR_FAIL_COND_MSG(other.size() != self->size(), "Arrays must have the same size.");
+		if (self->size() == 0)
+			return;
+		PoolRealArray::Read a = self->read();
+		PoolRealArray::Read b = other.read();
+		r_ret = _components_dot(a.ptr(), b.ptr(), self->size());
+	}
+
+	static void _call_PoolVector2Array_dot(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+		PoolVector2Array *self = reinterpret_cast<PoolVector2Array *>(p_self._data._mem);
+		PoolVector2Array other = *p_args[0];
+		PoolRealArray dots;
+		r_ret = dots;
+		ERR_FAIL_COND_MSG(other.size() != self->size(), "Arrays must have the same size.");
+		int count = self->size();
+		dots.resize(count);
+		if (count) {
+			PoolVector2Array::Read a = self->read();
+			PoolVector2Array::Read b = other.read();
+			PoolRealArray::Write w = dots.write();
+			const real_t *pa = (const real_t *)a.ptr();
+			const real_t *pb = (const real_t *)b.ptr();
+			real_t *dst = w.ptr();
+			for (int i = 0; i < count; i++) {
+				dst[i] = pa[i * 2 + 0] * pb[i * 2 + 0] + pa[i * 2 + 1] * pb[i * 2 + 1];
+			}
+		}
+		r_ret = dots;
+	}
+
+	static void _call_PoolVector3Array_dot(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+		PoolVector3Array *self = reinterpret_cast<PoolVector3Array *>(p_self._data._mem);
+		PoolVector3Array other = *p_args[0];
+		PoolRealArray dots;
+		r_ret = dots;
+		ERR_FAIL_COND_MSG(other.size() != self->size(), "Arrays must have the same size.");
+		int count = self->size();
+		dots.resize(count);
+		if (count) {
+			PoolVector3Array::Read a = self->read();
+			PoolVector3Array::Read b = other.read();
+			PoolRealArray::Write w = dots.write();
+			const real_t *pa = (const real_t *)a.ptr();
+			const real_t *pb = (const real_t *)b.ptr();
+			real_t *dst = w.ptr();
+			for (int i = 0; i < count; i++) {
+				dst[i] = pa[i * 3 + 0] * pb[i * 3 + 0] + pa[i * 3 + 1] * pb[i * 3 + 1] + pa[i * 3 + 2] * pb[i * 3 + 2];
+			}
+		}
+		r_ret = dots;
+	}
+
+	static void _call_PoolVector2Array_transform(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+		PoolVector2Array *self = reinterpret_cast<PoolVector2Array *>(p_self._data._mem);
+		Transform2D xform = *p_args[0];
+		int count = self->size();
+		if (count == 0)
+			return;
+		PoolVector2Array::Write w = self->write();
+		real_t *v = (real_t *)w.ptr();
+		const real_t xx = xform.elements[0].x, xy = xform.elements[0].y;
+		const real_t yx = xform.elements[1].x, yy = xform.elements[1].y;
+		const real_t ox = xform.elements[2].x, oy = xform.elements[2].y;
+		for (int i = 0; i < count; i++) {
+			real_t x = v[i * 2 + 0];
+			real_t y = v[i * 2 + 1];
+			v[i * 2 + 0] = xx * x + yx * y + ox;
+			v[i * 2 + 1] = xy * x + yy * y + oy;
+		}
+	}
+
+	static void _call_PoolVector3Array_transform(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+		PoolVector3Array *self = reinterpret_cast<PoolVector3Array *>(p_self._data._mem);
+		Transform xform = *p_args[0];
+		int count = self->size();
+		if (count == 0)
+			return;
+		PoolVector3Array::Write w = self->write();
+		real_t *v = (real_t *)w.ptr();
+		const Basis &b = xform.basis;
+		const Vector3 &o = xform.origin;
+		for (int i = 0; i < count; i++) {
+			real_t x = v[i * 3 + 0];
+			real_t y = v[i * 3 + 1];
+			real_t z = v[i * 3 + 2];
+			v[i * 3 + 0] = b.elements[0][0] * x + b.elements[0][1] * y + b.elements[0][2] * z + o.x;
+			v[i * 3 + 1] = b.elements[1][0] * x + b.elements[1][1] * y + b.elements[1][2] * z + o.y;
+			v[i * 3 + 2] = b.elements[2][0] * x + b.elements[2][1] * y + b.elements[2][2] * z + o.z;
+		}
+	}
+
 #define VCALL_PTR0(m_type, m_method) \
 	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(); }
 #define VCALL_PTR0R(m_type, m_method) \
@@ -1117,21 +1376,43 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 
 		r_error.error = Variant::CallError::CALL_OK;
 
-		Map<StringName, _VariantCall::FuncData>::Element *E = _VariantCall::type_funcs[type].functions.find(p_method);
+		_VariantCall::FuncData *funcdata = _VariantCall::type_funcs[type].find(p_method);
 #ifdef DEBUG_ENABLED
-		if (!E) {
+		if (!funcdata) {
 			r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
 			return;
 		}
 #endif
-		_VariantCall::FuncData &funcdata = E->get();
-		funcdata.call(ret, *this, p_args, p_argcount, r_error);
+		funcdata->call(ret, *this, p_args, p_argcount, r_error);
 	}
 
 	if (r_error.error == Variant::CallError::CALL_OK && r_ret)
 		*r_ret = ret;
 }
 
+void Variant::call_builtin(const BuiltinMethod *p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error) {
+
+	ERR_FAIL_COND(!p_method);
+	if (p_method->type != type) {
+		r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
+		return;
+	}
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	Variant ret;
+	p_method->call(ret, *this, p_args, p_argcount, r_error);
+
+	if (r_error.error == Variant::CallError::CALL_OK && r_ret)
+		*r_ret = ret;
+}
+
+const Variant::BuiltinMethod *Variant::get_builtin_method(Variant::Type p_type, const StringName &p_method) {
+
+	ERR_FAIL_INDEX_V(p_type, VARIANT_MAX, NULL);
+	return _VariantCall::type_funcs[p_type].find(p_method);
+}
+
 #define VCALL(m_type, m_method) _VariantCall::_call_##m_type##_##m_method
 
 Variant Variant::construct(const Variant::Type p_type, const Variant **p_args, int p_argcount, CallError &r_error, bool p_strict) {
@@ -1291,77 +1572,77 @@ bool Variant::has_method(const StringName &p_method) const {
 	}
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[type];
-	return tf.functions.has(p_method);
+	return tf.find(p_method) != NULL;
 }
 
 Vector<Variant::Type> Variant::get_method_argument_types(Variant::Type p_type, const StringName &p_method) {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = tf.find(p_method);
+	if (!fd)
 		return Vector<Variant::Type>();
 
-	return E->get().arg_types;
+	return fd->arg_types;
 }
 
 bool Variant::is_method_const(Variant::Type p_type, const StringName &p_method) {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = tf.find(p_method);
+	if (!fd)
 		return false;
 
-	return E->get()._const;
+	return fd->_const;
 }
 
 Vector<StringName> Variant::get_method_argument_names(Variant::Type p_type, const StringName &p_method) {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = tf.find(p_method);
+	if (!fd)
 		return Vector<StringName>();
 
-	return E->get().arg_names;
+	return fd->arg_names;
 }
 
 Variant::Type Variant::get_method_return_type(Variant::Type p_type, const StringName &p_method, bool *r_has_return) {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = tf.find(p_method);
+	if (!fd)
 		return Variant::NIL;
 
 	if (r_has_return)
-		*r_has_return = E->get().returns;
+		*r_has_return = fd->returns;
 
-	return E->get().return_type;
+	return fd->return_type;
 }
 
 Vector<Variant> Variant::get_method_default_arguments(Variant::Type p_type, const StringName &p_method) {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
 
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = tf.find(p_method);
+	if (!fd)
 		return Vector<Variant>();
 
-	return E->get().default_args;
+	return fd->default_args;
 }
 
 void Variant::get_method_list(List<MethodInfo> *p_list) const {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[type];
 
-	for (const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.front(); E; E = E->next()) {
+	for (int f = 0; f < tf.functions.size(); f++) {
 
-		const _VariantCall::FuncData &fd = E->get();
+		const _VariantCall::FuncData &fd = *tf.functions[f];
 
 		MethodInfo mi;
-		mi.name = E->key();
+		mi.name = fd.name;
 
 		if (fd._const) {
 			mi.flags |= METHOD_FLAG_CONST;
@@ -1842,6 +2123,11 @@ void register_variant_methods() {
 	ADDFUNC2R(POOL_REAL_ARRAY, INT, PoolRealArray, insert, INT, "idx", REAL, "value", varray());
 	ADDFUNC1(POOL_REAL_ARRAY, NIL, PoolRealArray, resize, INT, "idx", varray());
 	ADDFUNC0(POOL_REAL_ARRAY, NIL, PoolRealArray, invert, varray());
+	ADDFUNC1(POOL_REAL_ARRAY, NIL, PoolRealArray, add, POOL_REAL_ARRAY, "array", varray());
+	ADDFUNC1(POOL_REAL_ARRAY, NIL, PoolRealArray, multiply, POOL_REAL_ARRAY, "array", varray());
+	ADDFUNC1(POOL_REAL_ARRAY, NIL, PoolRealArray, scale, REAL, "scale", varray());
+	ADDFUNC2(POOL_REAL_ARRAY, NIL, PoolRealArray, lerp, POOL_REAL_ARRAY, "to", REAL, "weight", varray());
+	ADDFUNC1R(POOL_REAL_ARRAY, REAL, PoolRealArray, dot, POOL_REAL_ARRAY, "array", varray());
 
 	ADDFUNC0R(POOL_STRING_ARRAY, INT, PoolStringArray, size, varray());
 	ADDFUNC0R(POOL_STRING_ARRAY, BOOL, PoolStringArray, empty, varray());
@@ -1865,6 +2151,12 @@ void register_variant_methods() {
 	ADDFUNC2R(POOL_VECTOR2_ARRAY, INT, PoolVector2Array, insert, INT, "idx", VECTOR2, "vector2", varray());
 	ADDFUNC1(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, resize, INT, "idx", varray());
 	ADDFUNC0(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, invert, varray());
+	ADDFUNC1(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, add, POOL_VECTOR2_ARRAY, "array", varray());
+	ADDFUNC1(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, multiply, POOL_VECTOR2_ARRAY, "array", varray());
+	ADDFUNC1(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, scale, REAL, "scale", varray());
+	ADDFUNC2(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, lerp, POOL_VECTOR2_ARRAY, "to", REAL, "weight", varray());
+	ADDFUNC1R(POOL_VECTOR2_ARRAY, POOL_REAL_ARRAY, PoolVector2Array, dot, POOL_VECTOR2_ARRAY, "array", varray());
+	ADDFUNC1(POOL_VECTOR2_ARRAY, NIL, PoolVector2Array, transform, TRANSFORM2D, "transform", varray());
 
 	ADDFUNC0R(POOL_VECTOR3_ARRAY, INT, PoolVector3Array, size, varray());
 	ADDFUNC0R(POOL_VECTOR3_ARRAY, BOOL, PoolVector3Array, empty, varray());
@@ -1876,6 +2168,12 @@ void register_variant_methods() {
 	ADDFUNC2R(POOL_VECTOR3_ARRAY, INT, PoolVector3Array, insert, INT, "idx", VECTOR3, "vector3", varray());
 	ADDFUNC1(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, resize, INT, "idx", varray());
 	ADDFUNC0(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, invert, varray());
+	ADDFUNC1(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, add, POOL_VECTOR3_ARRAY, "array", varray());
+	ADDFUNC1(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, multiply, POOL_VECTOR3_ARRAY, "array", varray());
+	ADDFUNC1(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, scale, REAL, "scale", varray());
+	ADDFUNC2(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, lerp, POOL_VECTOR3_ARRAY, "to", REAL, "weight", varray());
+	ADDFUNC1R(POOL_VECTOR3_ARRAY, POOL_REAL_ARRAY, PoolVector3Array, dot, POOL_VECTOR3_ARRAY, "array", varray());
+	ADDFUNC1(POOL_VECTOR3_ARRAY, NIL, PoolVector3Array, transform, TRANSFORM, "transform", varray());
 
 	ADDFUNC0R(POOL_COLOR_ARRAY, INT, PoolColorArray, size, varray());
 	ADDFUNC0R(POOL_COLOR_ARRAY, BOOL, PoolColorArray, empty, varray());
@@ -1887,6 +2185,10 @@ void register_variant_methods() {
 	ADDFUNC2R(POOL_COLOR_ARRAY, INT, PoolColorArray, insert, INT, "idx", COLOR, "color", varray());
 	ADDFUNC1(POOL_COLOR_ARRAY, NIL, PoolColorArray, resize, INT, "idx", varray());
 	ADDFUNC0(POOL_COLOR_ARRAY, NIL, PoolColorArray, invert, varray());
+	ADDFUNC1(POOL_COLOR_ARRAY, NIL, PoolColorArray, add, POOL_COLOR_ARRAY, "array", varray());
+	ADDFUNC1(POOL_COLOR_ARRAY, NIL, PoolColorArray, multiply, POOL_COLOR_ARRAY, "array", varray());
+	ADDFUNC1(POOL_COLOR_ARRAY, NIL, PoolColorArray, scale, REAL, "scale", varray());
+	ADDFUNC2(POOL_COLOR_ARRAY, NIL, PoolColorArray, lerp, POOL_COLOR_ARRAY, "to", REAL, "weight", varray());
 
 	//pointerbased
 
@@ -0,0 +1,131 @@
+/*************************************************************************/
+/*  variant_internal.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef VARIANT_INTERNAL_H
+#define VARIANT_INTERNAL_H
+
+#include "core/variant.h"
+
+// Raw access to the value stored in a Variant, for hot paths (like the script VMs) that already
+// know its type. None of these check the type, so the caller is responsible for it.
+class VariantInternal {
+
+public:
+	_FORCE_INLINE_ static bool *get_bool(Variant *v) { return &v->_data._bool; }
+	_FORCE_INLINE_ static const bool *get_bool(const Variant *v) { return &v->_data._bool; }
+	_FORCE_INLINE_ static int64_t *get_int(Variant *v) { return &v->_data._int; }
+	_FORCE_INLINE_ static const int64_t *get_int(const Variant *v) { return &v->_data._int; }
+	_FORCE_INLINE_ static double *get_real(Variant *v) { return &v->_data._real; }
+	_FORCE_INLINE_ static const double *get_real(const Variant *v) { return &v->_data._real; }
+	_FORCE_INLINE_ static Vector2 *get_vector2(Variant *v) { return reinterpret_cast<Vector2 *>(v->_data._mem); }
+	_FORCE_INLINE_ static const Vector2 *get_vector2(const Variant *v) { return reinterpret_cast<const Vector2 *>(v->_data._mem); }
+	_FORCE_INLINE_ static Vector3 *get_vector3(Variant *v) { return reinterpret_cast<Vector3 *>(v->_data._mem); }
+	_FORCE_INLINE_ static const Vector3 *get_vector3(const Variant *v) { return reinterpret_cast<const Vector3 *>(v->_data._mem); }
+	_FORCE_INLINE_ static String *get_string(Variant *v) { return reinterpret_cast<String *>(v->_data._mem); }
+	_FORCE_INLINE_ static const String *get_string(const Variant *v) { return reinterpret_cast<const String *>(v->_data._mem); }
+	// Generic version of the getters above, only valid for types stored in place (Vector2, Vector3, String...).
+	template <class T>
+	_FORCE_INLINE_ static T *get_value(Variant *v) { return reinterpret_cast<T *>(v->_data._mem); }
+	template <class T>
+	_FORCE_INLINE_ static const T *get_value(const Variant *v) { return reinterpret_cast<const T *>(v->_data._mem); }
+	_FORCE_INLINE_ static Object *get_object(const Variant *v) { return v->_get_obj().obj; }
+	_FORCE_INLINE_ static bool is_object_ref(const Variant *v) { return !v->_get_obj().ref.is_null(); }
+
+	// Number of a INT or REAL variant, as a real.
+	_FORCE_INLINE_ static double get_number(const Variant *v) { return v->type == Variant::INT ? (double)v->_data._int : v->_data._real; }
+
+	// Makes the variant hold the default value of the given type, unless it already holds a value of that type.
+	// Meant to be followed by one of the setters above, so results of the same type can be written over and over
+	// without going through the Variant constructors.
+	_FORCE_INLINE_ static void initialize(Variant *v, Variant::Type p_type) {
+
+		if (v->type == p_type) {
+			return;
+		}
+
+		switch (p_type) {
+			case Variant::BOOL:
+			case Variant::INT:
+			case Variant::REAL: {
+				if (v->type != Variant::NIL) {
+					v->clear();
+				}
+				v->type = p_type;
+				v->_data._int = 0; // also zeroes bool and real
+			} break;
+			case Variant::VECTOR2: {
+				if (v->type != Variant::NIL) {
+					v->clear();
+				}
+				v->type = p_type;
+				memnew_placement(v->_data._mem, Vector2);
+			} break;
+			case Variant::VECTOR3: {
+				if (v->type != Variant::NIL) {
+					v->clear();
+				}
+				v->type = p_type;
+				memnew_placement(v->_data._mem, Vector3);
+			} break;
+			default: {
+				Variant::CallError ce;
+				*v = Variant::construct(p_type, NULL, 0, ce);
+			}
+		}
+	}
+
+	// Pointer to the value in the format expected by MethodBind::ptrcall(), or NULL for types that can't be passed that way.
+	_FORCE_INLINE_ static void *get_opaque_pointer(Variant *v) {
+
+		switch (v->type) {
+			case Variant::NIL:
+			case Variant::OBJECT:
+				return NULL;
+			case Variant::BOOL:
+				return &v->_data._bool;
+			case Variant::INT:
+				return &v->_data._int;
+			case Variant::REAL:
+				return &v->_data._real;
+			case Variant::TRANSFORM2D:
+				return v->_data._transform2d;
+			case Variant::AABB:
+				return v->_data._aabb;
+			case Variant::BASIS:
+				return v->_data._basis;
+			case Variant::TRANSFORM:
+				return v->_data._transform;
+			default:
+				return v->_data._mem; // everything else is stored in place
+		}
+	}
+};
+
+#endif // VARIANT_INTERNAL_H
@@ -483,12 +483,7 @@ static const GLenum gl_primitive[] = {
 
 void RasterizerCanvasGLES2::_canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip, RasterizerStorageGLES2::Material *p_material) {
 
-	int command_count = p_item->commands.size();
-	Item::Command **commands = p_item->commands.ptrw();
-
-	for (int i = 0; i < command_count; i++) {
-
-		Item::Command *command = commands[i];
+	for (Item::Command *command = p_item->commands; command; command = command->next) {
 
 		switch (command->type) {
 
@@ -3262,6 +3262,32 @@ void RasterizerStorageGLES2::multimesh_set_as_bulk_array(RID p_multimesh, const
 	}
 }
 
+void RasterizerStorageGLES2::multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(!multimesh->data.ptr());
+
+	int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+	int count = p_array.size() / stride;
+
+	ERR_FAIL_COND(p_array.size() != count * stride);
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->size);
+
+	if (count == 0)
+		return;
+
+	PoolVector<float>::Read r = p_array.read();
+	ERR_FAIL_COND(!r.ptr());
+	copymem(multimesh->data.ptrw() + p_from_instance * stride, r.ptr(), count * stride * sizeof(float));
+
+	multimesh->dirty_data = true;
+	multimesh->dirty_aabb = true;
+
+	if (!multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&multimesh->update_list);
+	}
+}
+
 void RasterizerStorageGLES2::multimesh_set_visible_instances(RID p_multimesh, int p_visible) {
 	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
 	ERR_FAIL_COND(!multimesh);
@@ -546,12 +546,7 @@ static const GLenum gl_primitive[] = {
 
 void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip) {
 
-	int cc = p_item->commands.size();
-	Item::Command **commands = p_item->commands.ptrw();
-
-	for (int i = 0; i < cc; i++) {
-
-		Item::Command *c = commands[i];
+	for (Item::Command *c = p_item->commands; c; c = c->next) {
 
 		switch (c->type) {
 			case Item::Command::TYPE_LINE: {
@@ -1608,7 +1603,7 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 						}
 					}
 
-					glBindBufferBase(GL_UNIFORM_BUFFER, 1, static_cast<LightInternal *>(light->light_internal.get_data())->ubo);
+					glBindBufferBase(GL_UNIFORM_BUFFER, 1, light_internal_owner.getptr(light->light_internal)->ubo);
 
 					if (has_shadow) {
 
@@ -456,7 +456,7 @@ RasterizerGLES3::RasterizerGLES3() {
 
 RasterizerGLES3::~RasterizerGLES3() {
 
-	memdelete(storage);
-	memdelete(canvas);
 	memdelete(scene);
+	memdelete(canvas);
+	memdelete(storage);
 }
@@ -4572,6 +4572,8 @@ void RasterizerStorageGLES3::multimesh_allocate(RID p_multimesh, int p_instances
 	}
 
 	multimesh->dirty_data = true;
+	multimesh->dirty_from = 0;
+	multimesh->dirty_to = multimesh->size;
 	multimesh->dirty_aabb = true;
 
 	if (!multimesh->update_list.in_list()) {
@@ -4638,7 +4640,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_transform(RID p_multimesh, i
 	dataptr[10] = p_transform.basis.elements[2][2];
 	dataptr[11] = p_transform.origin.z;
 
-	multimesh->dirty_data = true;
+	multimesh->mark_dirty(p_index, p_index + 1);
 	multimesh->dirty_aabb = true;
 
 	if (!multimesh->update_list.in_list()) {
@@ -4665,7 +4667,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_transform_2d(RID p_multimesh
 	dataptr[6] = 0;
 	dataptr[7] = p_transform.elements[2][1];
 
-	multimesh->dirty_data = true;
+	multimesh->mark_dirty(p_index, p_index + 1);
 	multimesh->dirty_aabb = true;
 
 	if (!multimesh->update_list.in_list()) {
@@ -4697,7 +4699,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_color(RID p_multimesh, int p
 		dataptr[3] = p_color.a;
 	}
 
-	multimesh->dirty_data = true;
+	multimesh->mark_dirty(p_index, p_index + 1);
 	multimesh->dirty_aabb = true;
 
 	if (!multimesh->update_list.in_list()) {
@@ -4730,7 +4732,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_custom_data(RID p_multimesh,
 		dataptr[3] = p_custom_data.a;
 	}
 
-	multimesh->dirty_data = true;
+	multimesh->mark_dirty(p_index, p_index + 1);
 	multimesh->dirty_aabb = true;
 
 	if (!multimesh->update_list.in_list()) {
@@ -4872,7 +4874,33 @@ void RasterizerStorageGLES3::multimesh_set_as_bulk_array(RID p_multimesh, const
 	PoolVector<float>::Read r = p_array.read();
 	copymem(multimesh->data.ptrw(), r.ptr(), dsize * sizeof(float));
 
-	multimesh->dirty_data = true;
+	multimesh->mark_dirty(0, multimesh->size);
+	multimesh->dirty_aabb = true;
+
+	if (!multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&multimesh->update_list);
+	}
+}
+
+void RasterizerStorageGLES3::multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {
+
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(!multimesh->data.ptr());
+
+	int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+	int count = p_array.size() / stride;
+
+	ERR_FAIL_COND(p_array.size() != count * stride);
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->size);
+
+	if (count == 0)
+		return;
+
+	PoolVector<float>::Read r = p_array.read();
+	copymem(multimesh->data.ptrw() + p_from_instance * stride, r.ptr(), count * stride * sizeof(float));
+
+	multimesh->mark_dirty(p_from_instance, p_from_instance + count);
 	multimesh->dirty_aabb = true;
 
 	if (!multimesh->update_list.in_list()) {
@@ -4913,8 +4941,12 @@ void RasterizerStorageGLES3::update_dirty_multimeshes() {
 
 		if (multimesh->size && multimesh->dirty_data) {
 
+			int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+			int from = multimesh->dirty_from * stride;
+			int count = (multimesh->dirty_to - multimesh->dirty_from) * stride;
+
 			glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, multimesh->data.size() * sizeof(float), multimesh->data.ptr());
+			glBufferSubData(GL_ARRAY_BUFFER, from * sizeof(float), count * sizeof(float), multimesh->data.ptr() + from);
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
 		}
 
@@ -787,6 +787,21 @@ public:
 		bool dirty_aabb;
 		bool dirty_data;
 
+		// only the instances in [dirty_from, dirty_to) are uploaded again
+		int dirty_from;
+		int dirty_to;
+
+		_FORCE_INLINE_ void mark_dirty(int p_from, int p_to) {
+			if (dirty_data) {
+				dirty_from = MIN(dirty_from, p_from);
+				dirty_to = MAX(dirty_to, p_to);
+			} else {
+				dirty_from = p_from;
+				dirty_to = p_to;
+				dirty_data = true;
+			}
+		}
+
 		MultiMesh() :
 				size(0),
 				transform_format(VS::MULTIMESH_TRANSFORM_2D),
@@ -800,7 +815,9 @@ public:
 				color_floats(0),
 				custom_data_floats(0),
 				dirty_aabb(true),
-				dirty_data(true) {
+				dirty_data(true),
+				dirty_from(0),
+				dirty_to(0) {
 		}
 	};
 
@@ -829,6 +846,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array);
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array);
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const;
@@ -41,6 +41,8 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -347,6 +349,34 @@ Error FileAccessUnix::_set_unix_permissions(const String &p_file, uint32_t p_per
 	return FAILED;
 }
 
+#if defined(UNIX_ENABLED)
+const uint8_t *FileAccessUnix::map_file(const String &p_path, uint64_t *r_size) {
+
+	int fd = ::open(p_path.utf8().get_data(), O_RDONLY);
+	if (fd == -1)
+		return NULL;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+		::close(fd);
+		return NULL;
+	}
+
+	void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // The mapping keeps its own reference to the file.
+	if (data == MAP_FAILED)
+		return NULL;
+
+	*r_size = st.st_size;
+	return (const uint8_t *)data;
+}
+
+void FileAccessUnix::unmap_file(const uint8_t *p_data, uint64_t p_size) {
+
+	munmap((void *)p_data, p_size);
+}
+#endif
+
 FileAccess *FileAccessUnix::create_libc() {
 
 	return memnew(FileAccessUnix);
@@ -84,6 +84,11 @@ public:
 	virtual uint32_t _get_unix_permissions(const String &p_file);
 	virtual Error _set_unix_permissions(const String &p_file, uint32_t p_permissions);
 
+#if defined(UNIX_ENABLED)
+	static const uint8_t *map_file(const String &p_path, uint64_t *r_size); ///< map a whole file read-only, NULL on failure
+	static void unmap_file(const uint8_t *p_data, uint64_t p_size);
+#endif
+
 	FileAccessUnix();
 	virtual ~FileAccessUnix();
 };
@@ -32,6 +32,7 @@
 
 #ifdef UNIX_ENABLED
 
+#include "core/io/file_access_pack.h"
 #include "core/os/thread_dummy.h"
 #include "core/project_settings.h"
 #include "drivers/unix/dir_access_unix.h"
@@ -139,6 +140,7 @@ void OS_Unix::initialize_core() {
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_RESOURCES);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_USERDATA);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_FILESYSTEM);
+	PackedSourcePCK::set_map_funcs(FileAccessUnix::map_file, FileAccessUnix::unmap_file);
 
 #ifndef NO_NETWORK
 	NetSocketPosix::make_default();
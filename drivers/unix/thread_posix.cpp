@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "thread_posix.h"
+#include "core/message_queue.h"
 #include "core/script_language.h"
 
 #if (defined(UNIX_ENABLED) || defined(PTHREAD_ENABLED)) && !defined(NO_THREADS)
@@ -70,11 +71,15 @@ void *ThreadPosix::thread_callback(void *userdata) {
 	pthread_setspecific(thread_id_key, (void *)memnew(ID(t->id)));
 
 	ScriptServer::thread_enter(); //scripts may need to attach a stack
+	MessageQueue::thread_enter();
 
 	t->callback(t->user);
 
+	MessageQueue::thread_exit();
 	ScriptServer::thread_exit();
 
+	Memory::release_thread_cache();
+
 	return NULL;
 }
 
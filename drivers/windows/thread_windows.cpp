@@ -32,6 +32,7 @@
 
 #if defined(WINDOWS_ENABLED) && !defined(UWP_ENABLED)
 
+#include "core/message_queue.h"
 #include "core/os/memory.h"
 
 Thread::ID ThreadWindows::get_id() const {
@@ -49,13 +50,17 @@ DWORD ThreadWindows::thread_callback(LPVOID userdata) {
 	ThreadWindows *t = reinterpret_cast<ThreadWindows *>(userdata);
 
 	ScriptServer::thread_enter(); //scripts may need to attach a stack
+	MessageQueue::thread_enter();
 
 	t->id = (ID)GetCurrentThreadId(); // must implement
 	t->callback(t->user);
 	SetEvent(t->handle);
 
+	MessageQueue::thread_exit();
 	ScriptServer::thread_exit();
 
+	Memory::release_thread_cache();
+
 	return 0;
 }
 
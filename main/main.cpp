@@ -2090,6 +2090,7 @@ void Main::cleanup() {
 
 	ERR_FAIL_COND(!_start_success);
 
+	ResourceLoader::finish_threaded_loading();
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
 
@@ -30,6 +30,7 @@
 
 #include "performance.h"
 
+#include "core/command_queue_mt.h"
 #include "core/message_queue.h"
 #include "core/os/os.h"
 #include "scene/main/node.h"
@@ -44,6 +45,7 @@ Performance *Performance::singleton = NULL;
 void Performance::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_monitor", "monitor"), &Performance::get_monitor);
+	ClassDB::bind_method(D_METHOD("get_memory_slab_usage"), &Performance::get_memory_slab_usage);
 
 	BIND_ENUM_CONSTANT(TIME_FPS);
 	BIND_ENUM_CONSTANT(TIME_PROCESS);
@@ -74,6 +76,14 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_CONTENDED_PUSHES);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_STALLS);
+	BIND_ENUM_CONSTANT(MEMORY_SLAB);
+	BIND_ENUM_CONSTANT(MEMORY_SLAB_ALLOCS_PER_SECOND);
+	BIND_ENUM_CONSTANT(RENDER_2D_ITEMS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_2D_BATCH_VERTICES_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_3D_DIRTY_INSTANCES_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -86,6 +96,19 @@ float Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+float Performance::_get_slab_allocs_per_second() const {
+
+	// Sampled over at least a quarter second, as monitors are read every frame.
+	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+	if (ticks - _slab_allocs_ticks >= 250000) {
+		uint64_t allocs = Memory::get_slab_allocs();
+		_slab_allocs_per_second = (allocs - _slab_allocs_last) * 1000000.0 / (ticks - _slab_allocs_ticks);
+		_slab_allocs_last = allocs;
+		_slab_allocs_ticks = ticks;
+	}
+	return _slab_allocs_per_second;
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
@@ -120,6 +143,14 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"command_queue/contended_pushes",
+		"command_queue/stalls",
+		"memory/slab",
+		"memory/slab_allocs_per_sec",
+		"raster/2d_items_drawn",
+		"raster/2d_batches",
+		"raster/2d_batch_vertices",
+		"raster/3d_dirty_instances",
 
 	};
 
@@ -158,6 +189,14 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY: return AudioServer::get_singleton()->get_output_latency();
+		case COMMAND_QUEUE_CONTENDED_PUSHES: return CommandQueueMT::get_contended_pushes();
+		case COMMAND_QUEUE_STALLS: return CommandQueueMT::get_stalls();
+		case MEMORY_SLAB: return Memory::get_slab_usage();
+		case MEMORY_SLAB_ALLOCS_PER_SECOND: return _get_slab_allocs_per_second();
+		case RENDER_2D_ITEMS_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_2D_ITEMS_IN_FRAME);
+		case RENDER_2D_BATCHES_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_2D_BATCHES_IN_FRAME);
+		case RENDER_2D_BATCH_VERTICES_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_2D_BATCH_VERTICES_IN_FRAME);
+		case RENDER_3D_DIRTY_INSTANCES_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_3D_DIRTY_INSTANCES_IN_FRAME);
 
 		default: {
 		}
@@ -200,12 +239,32 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
 	return types[p_monitor];
 }
 
+Dictionary Performance::get_memory_slab_usage() const {
+
+	Dictionary usage;
+	for (int i = 0; i < Memory::SLAB_CLASS_COUNT; i++) {
+		uint64_t bytes = Memory::get_slab_class_usage(i);
+		if (bytes) {
+			usage[Memory::get_slab_class_size(i)] = bytes;
+		}
+	}
+	return usage;
+}
+
 void Performance::set_process_time(float p_pt) {
 
 	_process_time = p_pt;
@@ -220,5 +279,8 @@ Performance::Performance() {
 
 	_process_time = 0;
 	_physics_process_time = 0;
+	_slab_allocs_last = 0;
+	_slab_allocs_ticks = 0;
+	_slab_allocs_per_second = 0;
 	singleton = this;
 }
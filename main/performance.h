@@ -48,6 +48,11 @@ class Performance : public Object {
 	float _process_time;
 	float _physics_process_time;
 
+	mutable uint64_t _slab_allocs_last;
+	mutable uint64_t _slab_allocs_ticks;
+	mutable float _slab_allocs_per_second;
+	float _get_slab_allocs_per_second() const;
+
 public:
 	enum Monitor {
 
@@ -81,6 +86,14 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		COMMAND_QUEUE_CONTENDED_PUSHES,
+		COMMAND_QUEUE_STALLS,
+		MEMORY_SLAB,
+		MEMORY_SLAB_ALLOCS_PER_SECOND,
+		RENDER_2D_ITEMS_IN_FRAME,
+		RENDER_2D_BATCHES_IN_FRAME,
+		RENDER_2D_BATCH_VERTICES_IN_FRAME,
+		RENDER_3D_DIRTY_INSTANCES_IN_FRAME,
 		MONITOR_MAX
 	};
 
@@ -95,6 +108,8 @@ public:
 
 	MonitorType get_monitor_type(Monitor p_monitor) const;
 
+	Dictionary get_memory_slab_usage() const;
+
 	void set_process_time(float p_pt);
 	void set_physics_process_time(float p_pt);
 
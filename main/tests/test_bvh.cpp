@@ -0,0 +1,289 @@
+/*************************************************************************/
+/*  test_bvh.cpp                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_bvh.h"
+
+#include "core/math/camera_matrix.h"
+#include "core/math/dynamic_bvh.h"
+#include "core/math/octree.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/set.h"
+
+namespace TestBVH {
+
+struct Item {
+	int id;
+};
+
+static AABB random_aabb(RandomPCG &p_rng, real_t p_extent, real_t p_size) {
+
+	Vector3 pos(p_rng.randf() * 2.0 - 1.0, p_rng.randf() * 2.0 - 1.0, p_rng.randf() * 2.0 - 1.0);
+	Vector3 size(p_rng.randf(), p_rng.randf(), p_rng.randf());
+	return AABB(pos * p_extent, size * p_size);
+}
+
+static Vector<Plane> frustum_planes(const Vector3 &p_origin) {
+
+	CameraMatrix cm;
+	cm.set_perspective(70, 1.5, 0.1, 100);
+	return cm.get_projection_planes(Transform(Basis(), p_origin));
+}
+
+/* CORRECTNESS, AGAINST OCTREE */
+
+static Set<uint64_t> pairs[2];
+
+static uint64_t pair_key(Item *p_a, Item *p_b) {
+
+	uint64_t a = p_a->id;
+	uint64_t b = p_b->id;
+	return a < b ? (a << 32) | b : (b << 32) | a;
+}
+
+static void *pair_func(void *p_self, uint32_t, Item *p_a, int, uint32_t, Item *p_b, int) {
+
+	pairs[(intptr_t)p_self].insert(pair_key(p_a, p_b));
+	return NULL;
+}
+
+static void unpair_func(void *p_self, uint32_t, Item *p_a, int, uint32_t, Item *p_b, int, void *) {
+
+	pairs[(intptr_t)p_self].erase(pair_key(p_a, p_b));
+}
+
+template <class C>
+static Set<int> cull_set(C &p_tree, int p_which, const AABB &p_aabb, const Vector<Plane> &p_planes, Item **r_buf, int p_max) {
+
+	int count = 0;
+	switch (p_which) {
+		case 0: count = p_tree.cull_aabb(p_aabb, r_buf, p_max, NULL, 2); break;
+		case 1: count = p_tree.cull_convex(p_planes, r_buf, p_max); break;
+		case 2: count = p_tree.cull_segment(p_aabb.position, p_aabb.position + p_aabb.size, r_buf, p_max); break;
+	}
+
+	Set<int> result;
+	for (int i = 0; i < count; i++) {
+		result.insert(r_buf[i]->id);
+	}
+	return result;
+}
+
+static bool same(const Set<int> &p_a, const Set<int> &p_b) {
+
+	if (p_a.size() != p_b.size())
+		return false;
+	for (Set<int>::Element *E = p_a.front(); E; E = E->next()) {
+		if (!p_b.has(E->get()))
+			return false;
+	}
+	return true;
+}
+
+bool test_matches_octree() {
+
+	const int count = 2000;
+	RandomPCG rng(1234);
+
+	Octree<Item, true> octree;
+	DynamicBVH<Item, true> bvh;
+	octree.set_pair_callback(pair_func, (void *)0);
+	octree.set_unpair_callback(unpair_func, (void *)0);
+	bvh.set_pair_callback(pair_func, (void *)1);
+	bvh.set_unpair_callback(unpair_func, (void *)1);
+	pairs[0].clear();
+	pairs[1].clear();
+
+	Vector<Item> items;
+	items.resize(count);
+	Vector<uint32_t> octree_ids;
+	octree_ids.resize(count);
+	Vector<uint32_t> bvh_ids;
+	bvh_ids.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		items.write[i].id = i;
+		octree_ids.write[i] = 0;
+		bvh_ids.write[i] = 0;
+	}
+
+	Vector<Item *> buf;
+	buf.resize(count);
+
+	for (int step = 0; step < 20000; step++) {
+
+		int i = rng.rand() % count;
+		Item *item = &items.write[i];
+		bool pairable = (i % 3) == 0;
+		uint32_t type = 1 << (i % 3);
+
+		if (!octree_ids[i]) {
+			AABB aabb = random_aabb(rng, 100, 5);
+			octree_ids.write[i] = octree.create(item, aabb, 0, pairable, type, pairable ? 6 : 0);
+			bvh_ids.write[i] = bvh.create(item, aabb, 0, pairable, type, pairable ? 6 : 0);
+		} else {
+			int op = rng.rand() % 10;
+			if (op < 7) {
+				AABB aabb = random_aabb(rng, op < 4 ? 1 : 100, 5);
+				if (op == 6)
+					aabb = AABB(); // leaves the tree
+				octree.move(octree_ids[i], aabb);
+				bvh.move(bvh_ids[i], aabb);
+			} else if (op == 7) {
+				bool p = !bvh.is_pairable(bvh_ids[i]);
+				octree.set_pairable(octree_ids[i], p, type, p ? 7 : 0);
+				bvh.set_pairable(bvh_ids[i], p, type, p ? 7 : 0);
+			} else {
+				octree.erase(octree_ids[i]);
+				bvh.erase(bvh_ids[i]);
+				octree_ids.write[i] = 0;
+				bvh_ids.write[i] = 0;
+			}
+		}
+
+		if (pairs[0].size() != pairs[1].size()) {
+			OS::get_singleton()->print("\tpair count differs at step %d: octree %d, bvh %d\n", step, pairs[0].size(), pairs[1].size());
+			return false;
+		}
+
+		if (step % 500 == 0) {
+			AABB aabb = random_aabb(rng, 100, 50);
+			Vector<Plane> planes = frustum_planes(aabb.position);
+			for (int j = 0; j < 3; j++) {
+				if (!same(cull_set(octree, j, aabb, planes, buf.ptrw(), count), cull_set(bvh, j, aabb, planes, buf.ptrw(), count))) {
+					OS::get_singleton()->print("\tcull %d differs at step %d\n", j, step);
+					return false;
+				}
+			}
+		}
+	}
+
+	for (Set<uint64_t>::Element *E = pairs[0].front(); E; E = E->next()) {
+		if (!pairs[1].has(E->get())) {
+			OS::get_singleton()->print("\tpairs differ\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* BENCHMARK */
+
+template <class C>
+static void benchmark(const char *p_name, int p_count) {
+
+	RandomPCG rng(4321);
+	const real_t extent = Math::sqrt((real_t)p_count) * 4.0;
+
+	C *tree = memnew(C);
+
+	Vector<Item> items;
+	items.resize(p_count);
+	Vector<uint32_t> ids;
+	ids.resize(p_count);
+	Vector<AABB> aabbs;
+	aabbs.resize(p_count);
+	Vector<Item *> buf;
+	buf.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+		items.write[i].id = i;
+		aabbs.write[i] = random_aabb(rng, extent, 2);
+	}
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		ids.write[i] = tree->create(&items.write[i], aabbs[i], 0, false, 1, 0);
+	}
+	uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < 10; frame++) {
+		for (int i = 0; i < p_count; i++) {
+			aabbs.write[i].position += Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5) * 0.05;
+			tree->move(ids[i], aabbs[i]);
+		}
+	}
+	uint64_t move_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	int culled = 0;
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 100; i++) {
+		Vector3 origin(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0);
+		culled += tree->cull_convex(frustum_planes(origin * extent), buf.ptrw(), p_count);
+	}
+	uint64_t cull_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	OS::get_singleton()->print("\t%-8s %7d elements: insert %8.0f/ms, move %8.0f/ms, cull %8.3f ms/frustum (%d avg. results)\n",
+			p_name, p_count,
+			p_count / MAX(insert_usec / 1000.0, 0.001),
+			p_count * 10 / MAX(move_usec / 1000.0, 0.001),
+			cull_usec / 100000.0,
+			culled / 100);
+
+	memdelete(tree);
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_matches_octree,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	OS::get_singleton()->print("\nBenchmark:\n");
+	for (int n = 1000; n <= 100000; n *= 10) {
+		benchmark<Octree<Item, true> >("octree", n);
+		benchmark<DynamicBVH<Item, true> >("bvh", n);
+	}
+
+	return NULL;
+}
+
+} // namespace TestBVH
@@ -0,0 +1,295 @@
+/*************************************************************************/
+/*  test_canvas_commands.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_canvas_commands.h"
+
+#include "core/os/os.h"
+#include "servers/visual/rasterizer.h"
+#include "servers/visual/visual_server_canvas_batcher.h"
+
+namespace TestCanvasCommands {
+
+typedef RasterizerCanvas::Item Item;
+
+static int _count_blocks(const Item &p_item) {
+
+	int count = 0;
+	for (Item::CommandBlock *b = p_item.command_blocks; b; b = b->next) {
+		count++;
+	}
+	return count;
+}
+
+static void _setup_command(Item::Command *p_command, int p_index) {
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+			Item::CommandRect *rect = static_cast<Item::CommandRect *>(p_command);
+			rect->rect = Rect2(p_index, 0, 10, 10);
+			rect->modulate = Color(1, 1, 1);
+		} break;
+		case Item::Command::TYPE_LINE: {
+			Item::CommandLine *line = static_cast<Item::CommandLine *>(p_command);
+			line->from = Point2(p_index, 0);
+			line->to = Point2(p_index, 20);
+			line->width = 1;
+		} break;
+		case Item::Command::TYPE_CIRCLE: {
+			Item::CommandCircle *circle = static_cast<Item::CommandCircle *>(p_command);
+			circle->pos = Point2(p_index, 0);
+			circle->radius = 5;
+		} break;
+		default: {
+		}
+	}
+}
+
+static void _add_commands(Item &p_item, int p_count) {
+
+	for (int i = 0; i < p_count; i++) {
+		Item::Command *c;
+		switch (i % 3) {
+			case 0: c = p_item.alloc_command<Item::CommandRect>(); break;
+			case 1: c = p_item.alloc_command<Item::CommandLine>(); break;
+			default: c = p_item.alloc_command<Item::CommandCircle>();
+		}
+		_setup_command(c, i);
+	}
+}
+
+static bool test_order() {
+
+	OS::get_singleton()->print("\n\nTest 1: Commands keep their order and bounds\n");
+
+	Item item;
+	_add_commands(item, 3000);
+
+	bool pass = true;
+	int count = 0;
+	for (const Item::Command *c = item.commands; c; c = c->next) {
+		static const Item::Command::Type types[3] = { Item::Command::TYPE_RECT, Item::Command::TYPE_LINE, Item::Command::TYPE_CIRCLE };
+		if (c->type != types[count % 3]) {
+			pass = false;
+		}
+		count++;
+	}
+
+	Rect2 rect = item.get_rect();
+	OS::get_singleton()->print("\t%d commands in %d blocks, rect %s\n", count, _count_blocks(item), String(rect).utf8().get_data());
+	pass = pass && count == 3000 && item.last_command->type == Item::Command::TYPE_CIRCLE;
+	pass = pass && rect.position.is_equal_approx(Point2(-3, -5)) && rect.size.is_equal_approx(Size2(3010, 25));
+	return pass;
+}
+
+static bool test_reuse() {
+
+	OS::get_singleton()->print("\n\nTest 2: Clearing keeps the blocks for the next redraw\n");
+
+	Item item;
+	_add_commands(item, 3000);
+	Item::CommandBlock *first = item.command_blocks;
+	int blocks = _count_blocks(item);
+
+	bool pass = true;
+	for (int i = 0; i < 10; i++) {
+		item.clear();
+		pass = pass && !item.commands && !item.last_command && item.get_rect() == Rect2();
+		_add_commands(item, 3000 - i * 100);
+	}
+
+	OS::get_singleton()->print("\t%d blocks before, %d after\n", blocks, _count_blocks(item));
+	return pass && item.command_blocks == first && _count_blocks(item) == blocks;
+}
+
+static bool test_batching() {
+
+	OS::get_singleton()->print("\n\nTest 3: Batching merges runs of rects\n");
+
+	Item items[5];
+	for (int i = 0; i < 5; i++) {
+		for (int j = 0; j < 2; j++) {
+			Item::CommandRect *rect = items[i].alloc_command<Item::CommandRect>();
+			rect->rect = Rect2(j * 5, 0, 4, 4);
+			rect->modulate = Color(1, 0, 0);
+		}
+		items[i].final_transform = Transform2D(0, Vector2(i * 10, 0));
+		items[i].final_modulate = Color(1, 1, 1, 0.5);
+		items[i].next = i < 4 ? &items[i + 1] : NULL;
+	}
+	// a distance field item can't be merged and splits the run
+	items[3].distance_field = true;
+
+	VisualServerCanvasBatcher batcher;
+	batcher.enabled = true;
+	batcher.begin_frame();
+
+	Item *list = batcher.batch_items(&items[0], 0, NULL);
+
+	bool pass = list && list->next == &items[3] && items[3].next && !items[3].next->next;
+	if (pass) {
+		const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(list->commands);
+		pass = polygon->type == Item::Command::TYPE_POLYGON && polygon->count == 36 && polygon->points.size() == 24;
+		pass = pass && polygon->points[0] == Point2(0, 0) && polygon->points[2] == Point2(4, 4) && polygon->points[8] == Point2(10, 0) && polygon->points[22] == Point2(29, 4);
+		pass = pass && polygon->colors[23] == Color(1, 0, 0, 0.5) && polygon->indices[35] == 23;
+		pass = pass && list->final_transform == Transform2D() && list->final_modulate == Color(1, 1, 1, 1);
+	}
+
+	batcher.begin_frame();
+	int items_drawn = batcher.get_render_info(VS::INFO_2D_ITEMS_IN_FRAME);
+	int batches = batcher.get_render_info(VS::INFO_2D_BATCHES_IN_FRAME);
+	int vertices = batcher.get_render_info(VS::INFO_2D_BATCH_VERTICES_IN_FRAME);
+	OS::get_singleton()->print("\t%d items in %d batches with %d vertices\n", items_drawn, batches, vertices);
+
+	return pass && items_drawn == 5 && batches == 2 && vertices == 32;
+}
+
+static real_t _draw(const Item::Command *p_command) {
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+			return static_cast<const Item::CommandRect *>(p_command)->rect.position.x;
+		}
+		case Item::Command::TYPE_LINE: {
+			return static_cast<const Item::CommandLine *>(p_command)->width;
+		}
+		case Item::Command::TYPE_CIRCLE: {
+			return static_cast<const Item::CommandCircle *>(p_command)->radius;
+		}
+		default: {
+			return 0;
+		}
+	}
+}
+
+static void benchmark() {
+
+	const int items = 64;
+	const int per_item = 256;
+	const int frames = 200;
+
+	// each frame every item is cleared and redrawn, like a canvas where everything updates
+	Item *canvas = memnew_arr(Item, items);
+	real_t sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int f = 0; f < frames; f++) {
+		for (int i = 0; i < items; i++) {
+			canvas[i].clear();
+			_add_commands(canvas[i], per_item);
+		}
+		for (int i = 0; i < items; i++) {
+			for (const Item::Command *c = canvas[i].commands; c; c = c->next) {
+				sum += _draw(c);
+			}
+		}
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	memdelete_arr(canvas);
+
+	// the same work with one heap allocation per command, as the items used to do
+	Vector<Item::Command *> *lists = memnew_arr(Vector<Item::Command *>, items);
+
+	uint64_t heap_begin = OS::get_singleton()->get_ticks_usec();
+	for (int f = 0; f < frames; f++) {
+		for (int i = 0; i < items; i++) {
+			for (int j = 0; j < lists[i].size(); j++) {
+				memdelete(lists[i][j]);
+			}
+			lists[i].clear();
+			for (int j = 0; j < per_item; j++) {
+				Item::Command *c;
+				switch (j % 3) {
+					case 0: c = memnew(Item::CommandRect); break;
+					case 1: c = memnew(Item::CommandLine); break;
+					default: c = memnew(Item::CommandCircle);
+				}
+				_setup_command(c, j);
+				lists[i].push_back(c);
+			}
+		}
+		for (int i = 0; i < items; i++) {
+			for (int j = 0; j < lists[i].size(); j++) {
+				sum += _draw(lists[i][j]);
+			}
+		}
+	}
+	uint64_t heap_end = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < items; i++) {
+		for (int j = 0; j < lists[i].size(); j++) {
+			memdelete(lists[i][j]);
+		}
+	}
+	memdelete_arr(lists);
+
+	double commands = double(items) * per_item * frames;
+	OS::get_singleton()->print("\tblocks %8.0f commands/ms, heap %8.0f commands/ms\n", commands * 1000.0 / MAX(1, end - begin), commands * 1000.0 / MAX(1, heap_end - heap_begin));
+
+	// keep the loops from being optimized away
+	if (sum < 0) {
+		OS::get_singleton()->print("%f\n", sum);
+	}
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_order,
+	test_reuse,
+	test_batching,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	OS::get_singleton()->print("\nBenchmark:\n");
+	benchmark();
+
+	return NULL;
+}
+
+} // namespace TestCanvasCommands
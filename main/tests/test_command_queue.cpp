@@ -0,0 +1,208 @@
+/*************************************************************************/
+/*  test_command_queue.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_command_queue.h"
+
+#include "core/command_queue_mt.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+namespace TestCommandQueue {
+
+#define PRODUCERS 8
+// Several megabytes of commands in total, so the ring wraps around many times.
+#define COMMANDS_PER_PRODUCER 50000
+#define SYNC_EVERY 1000
+
+// Only ever called from the flushing thread.
+struct Receiver {
+	int received[PRODUCERS];
+	int total;
+	int errors;
+
+	void receive(int p_producer, int p_seq) {
+		// Out of order, repeated and missing commands all break the sequence.
+		if (p_seq != received[p_producer]) {
+			errors++;
+		}
+		received[p_producer] = p_seq + 1;
+		total++;
+	}
+
+	void receive_sync(int p_producer, int p_seq) {
+		receive(p_producer, p_seq);
+	}
+
+	int receive_ret(int p_producer, int p_seq) {
+		receive(p_producer, p_seq);
+		return received[p_producer];
+	}
+
+	Receiver() {
+		for (int i = 0; i < PRODUCERS; i++) {
+			received[i] = 0;
+		}
+		total = 0;
+		errors = 0;
+	}
+};
+
+struct Producer {
+	CommandQueueMT *queue;
+	Receiver *receiver;
+	int index;
+	volatile uint32_t *done;
+	volatile uint32_t *errors;
+};
+
+static void _producer_thread(void *p_userdata) {
+
+	Producer *p = (Producer *)p_userdata;
+	for (int i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+		if (i % SYNC_EVERY == SYNC_EVERY - 1) {
+			p->queue->push_and_sync(p->receiver, &Receiver::receive_sync, p->index, i);
+		} else if (i % SYNC_EVERY == SYNC_EVERY / 2) {
+			// Everything pushed before must have run by the time the result is back.
+			int ret = 0;
+			p->queue->push_and_ret(p->receiver, &Receiver::receive_ret, p->index, i, &ret);
+			if (ret != i + 1) {
+				atomic_increment(p->errors);
+			}
+		} else {
+			p->queue->push(p->receiver, &Receiver::receive, p->index, i);
+		}
+	}
+	atomic_increment(p->done);
+}
+
+static bool _run(bool p_sync) {
+
+	CommandQueueMT queue(p_sync);
+	Receiver receiver;
+	volatile uint32_t done = 0;
+	volatile uint32_t ret_errors = 0;
+
+	Producer producers[PRODUCERS];
+	Thread *threads[PRODUCERS];
+	for (int i = 0; i < PRODUCERS; i++) {
+		producers[i].queue = &queue;
+		producers[i].receiver = &receiver;
+		producers[i].index = i;
+		producers[i].done = &done;
+		producers[i].errors = &ret_errors;
+		threads[i] = Thread::create(_producer_thread, &producers[i]);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	if (p_sync) {
+		// Every push posts once, so this flushes exactly one command per call.
+		for (int i = 0; i < PRODUCERS * COMMANDS_PER_PRODUCER; i++) {
+			queue.wait_and_flush_one();
+		}
+	} else {
+		while (done < PRODUCERS) {
+			queue.flush_all();
+		}
+		queue.flush_all();
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	bool pass = true;
+	if (receiver.errors) {
+		OS::get_singleton()->print("\t%d commands ran out of order\n", receiver.errors);
+		pass = false;
+	}
+	if (ret_errors) {
+		OS::get_singleton()->print("\t%d results were returned before earlier commands ran\n", ret_errors);
+		pass = false;
+	}
+	if (receiver.total != PRODUCERS * COMMANDS_PER_PRODUCER) {
+		OS::get_singleton()->print("\t%d commands ran, expected %d\n", receiver.total, PRODUCERS * COMMANDS_PER_PRODUCER);
+		pass = false;
+	}
+	for (int i = 0; i < PRODUCERS; i++) {
+		if (receiver.received[i] != COMMANDS_PER_PRODUCER) {
+			OS::get_singleton()->print("\tproducer %d: %d commands ran\n", i, receiver.received[i]);
+			pass = false;
+		}
+	}
+
+	OS::get_singleton()->print("\t%d commands in %d ms\n", receiver.total, int((end - begin) / 1000));
+	return pass;
+}
+
+static bool test_flush_all() {
+
+	OS::get_singleton()->print("\n\nTest 1: %d producers, flushing everything\n", PRODUCERS);
+	return _run(false);
+}
+
+static bool test_wait_and_flush_one() {
+
+	OS::get_singleton()->print("\n\nTest 2: %d producers, flushing one at a time\n", PRODUCERS);
+	return _run(true);
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_flush_all,
+	test_wait_and_flush_one,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+
+} // namespace TestCommandQueue
@@ -564,10 +564,15 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 			switch (code[ip]) {
 
-				case GDScriptFunction::OPCODE_OPERATOR: {
+				case GDScriptFunction::OPCODE_OPERATOR:
+				case GDScriptFunction::OPCODE_OPERATOR_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_REAL:
+				case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+				case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
 
+					static const char *op_prefixes[] = { " op ", " op-int ", " op-real ", " op-vector2 ", " op-vector3 " };
 					int op = code[ip + 1];
-					txt += " op ";
+					txt += op_prefixes[code[ip] - GDScriptFunction::OPCODE_OPERATOR];
 
 					String opname = Variant::get_operator_name(Variant::Operator(op));
 
@@ -624,6 +629,22 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += "\"]";
 					incr += 4;
 
+				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_SCRIPT_MEMBER: {
+
+					txt += " get_named_script_member ";
+					txt += DADDR(5);
+					txt += "=";
+					txt += DADDR(1);
+					txt += "[\"";
+					txt += func.get_global_name(code[ip + 2]);
+					txt += "\"] (slot ";
+					txt += itos(code[ip + 4]);
+					txt += " of ";
+					txt += DADDR(3);
+					txt += ")";
+					incr += 6;
+
 				} break;
 				case GDScriptFunction::OPCODE_SET_MEMBER: {
 
@@ -645,6 +666,18 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += "\"]";
 					incr += 3;
 
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_MEMBER: {
+
+					txt += " op_member ";
+					txt += "[\"";
+					txt += func.get_global_name(code[ip + 2]);
+					txt += "\"] ";
+					txt += Variant::get_operator_name(Variant::Operator(code[ip + 1]));
+					txt += "= ";
+					txt += DADDR(3);
+					incr += 4;
+
 				} break;
 				case GDScriptFunction::OPCODE_ASSIGN: {
 
@@ -770,6 +803,64 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					incr = 5 + argc;
 
+				} break;
+				case GDScriptFunction::OPCODE_CALL_NATIVE:
+				case GDScriptFunction::OPCODE_CALL_NATIVE_RETURN: {
+
+					bool ret = code[ip] == GDScriptFunction::OPCODE_CALL_NATIVE_RETURN;
+
+					if (ret)
+						txt += " call-native-ret ";
+					else
+						txt += " call-native ";
+
+					int argc = code[ip + 1];
+					if (ret) {
+						txt += DADDR(5 + argc) + "=";
+					}
+
+					txt += DADDR(2) + ".";
+					txt += String(func.get_global_name(code[ip + 3]));
+					txt += "(";
+
+					for (int i = 0; i < argc; i++) {
+						if (i > 0)
+							txt += ", ";
+						txt += DADDR(5 + i);
+					}
+					txt += ")";
+
+					incr = 6 + argc;
+
+				} break;
+				case GDScriptFunction::OPCODE_CALL_VARIANT:
+				case GDScriptFunction::OPCODE_CALL_VARIANT_RETURN: {
+
+					bool ret = code[ip] == GDScriptFunction::OPCODE_CALL_VARIANT_RETURN;
+
+					if (ret)
+						txt += " call-variant-ret ";
+					else
+						txt += " call-variant ";
+
+					int argc = code[ip + 1];
+					if (ret) {
+						txt += DADDR(5 + argc) + "=";
+					}
+
+					txt += DADDR(2) + ".";
+					txt += String(func.get_global_name(code[ip + 3]));
+					txt += "(";
+
+					for (int i = 0; i < argc; i++) {
+						if (i > 0)
+							txt += ", ";
+						txt += DADDR(5 + i);
+					}
+					txt += ")";
+
+					incr = 6 + argc;
+
 				} break;
 				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
 
@@ -857,6 +948,17 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					incr = 3;
 				} break;
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR: {
+
+					txt += " jump-if-not ";
+					txt += DADDR(2);
+					txt += " " + Variant::get_operator_name(Variant::Operator(code[ip + 1])) + " ";
+					txt += DADDR(3);
+					txt += " to ";
+					txt += itos(code[ip + 4]);
+
+					incr = 5;
+				} break;
 				case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
 
 					txt += " jump-to-default-argument ";
@@ -870,17 +972,40 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					incr = 2;
 
 				} break;
-				case GDScriptFunction::OPCODE_ITERATE_BEGIN: {
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT: {
 
-					txt += " for-init " + DADDR(4) + " in " + DADDR(2) + " counter " + DADDR(1) + " end " + itos(code[ip + 3]);
+					txt += code[ip] == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT ? " for-init-int " : " for-init ";
+					txt += DADDR(4) + " in " + DADDR(2) + " counter " + DADDR(1) + " end " + itos(code[ip + 3]);
 					incr += 5;
 
 				} break;
-				case GDScriptFunction::OPCODE_ITERATE: {
+				case GDScriptFunction::OPCODE_ITERATE:
+				case GDScriptFunction::OPCODE_ITERATE_INT: {
 
-					txt += " for-loop " + DADDR(4) + " in " + DADDR(2) + " counter " + DADDR(1) + " end " + itos(code[ip + 3]);
+					txt += code[ip] == GDScriptFunction::OPCODE_ITERATE_INT ? " for-loop-int " : " for-loop ";
+					txt += DADDR(4) + " in " + DADDR(2) + " counter " + DADDR(1) + " end " + itos(code[ip + 3]);
 					incr += 5;
 
+				} break;
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+
+					int argc = code[ip + 6];
+					txt += " for-init-range " + DADDR(5) + " in range(";
+					for (int i = 0; i < argc; i++) {
+						if (i > 0)
+							txt += ", ";
+						txt += DADDR(7 + i);
+					}
+					txt += ") counter " + DADDR(1) + " end " + itos(code[ip + 4]);
+					incr += 10;
+
+				} break;
+				case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+
+					txt += " for-loop-range " + DADDR(5) + " to " + DADDR(2) + " step " + DADDR(3) + " counter " + DADDR(1) + " end " + itos(code[ip + 4]);
+					incr += 6;
+
 				} break;
 				case GDScriptFunction::OPCODE_LINE: {
 
@@ -917,8 +1042,106 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 	}
 }
 
+// Micro-benchmarks for the bytecode VM, each function runs its loop body n times.
+static const char *benchmark_code =
+		"extends Reference\n"
+		"\n"
+		"func loop_for(n):\n"
+		"\tvar count = 0\n"
+		"\tfor i in n:\n"
+		"\t\tcount += 1\n"
+		"\treturn count\n"
+		"\n"
+		"func loop_range(n):\n"
+		"\tvar count = 0\n"
+		"\tfor i in range(0, n, 1):\n"
+		"\t\tcount += 1\n"
+		"\treturn count\n"
+		"\n"
+		"func loop_while(n):\n"
+		"\tvar i = 0\n"
+		"\twhile i < n:\n"
+		"\t\ti += 1\n"
+		"\treturn i\n"
+		"\n"
+		"func math_int(n: int) -> int:\n"
+		"\tvar acc := 0\n"
+		"\tfor i in n:\n"
+		"\t\tacc = (acc + 3) * 7 % 1000\n"
+		"\treturn acc\n"
+		"\n"
+		"func math_real(n: int) -> float:\n"
+		"\tvar acc := 0.0\n"
+		"\tfor i in n:\n"
+		"\t\tacc = acc * 0.5 + 1.5\n"
+		"\treturn acc\n"
+		"\n"
+		"func math_vector(n: int) -> Vector3:\n"
+		"\tvar v := Vector3()\n"
+		"\tvar step := Vector3(1, 2, 3)\n"
+		"\tfor i in n:\n"
+		"\t\tv = v * 0.5 + step\n"
+		"\treturn v\n"
+		"\n"
+		"func _add(a, b):\n"
+		"\treturn a + b\n"
+		"\n"
+		"func call_script(n: int) -> int:\n"
+		"\tvar acc := 0\n"
+		"\tfor i in n:\n"
+		"\t\tacc = _add(acc, 1)\n"
+		"\treturn acc\n"
+		"\n"
+		"func call_native(n: int) -> int:\n"
+		"\tvar acc := 0\n"
+		"\tfor i in n:\n"
+		"\t\tif get_instance_id() != 0:\n"
+		"\t\t\tacc += 1\n"
+		"\treturn acc\n";
+
+static const char *benchmark_functions[] = {
+	"loop_for",
+	"loop_range",
+	"loop_while",
+	"math_int",
+	"math_real",
+	"math_vector",
+	"call_script",
+	"call_native",
+	NULL
+};
+
+static void _run_benchmarks() {
+
+	Ref<GDScript> script;
+	script.instance();
+	script->set_source_code(benchmark_code);
+	Error err = script->reload();
+	ERR_FAIL_COND_MSG(err != OK, "Could not compile the benchmark script.");
+
+	Ref<Reference> instance = memnew(Reference);
+	instance->set_script(script.get_ref_ptr());
+
+	const int iterations = 1000000;
+
+	for (int i = 0; benchmark_functions[i]; i++) {
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		Variant ret = instance->call(benchmark_functions[i], iterations);
+		uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - from, 1);
+
+		print_line(String(benchmark_functions[i]) + ": " + itos(uint64_t(iterations) * 1000000 / usec) + " ops/sec (returned " + String(ret) + ")");
+	}
+}
+
 MainLoop *test(TestType p_type) {
 
+	if (p_type == TEST_BENCHMARK) {
+
+		_run_benchmarks();
+		return NULL;
+	}
+
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
 	if (cmdlargs.empty()) {
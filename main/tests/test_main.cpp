@@ -34,16 +34,26 @@
 #ifdef DEBUG_ENABLED
 
 #include "test_astar.h"
+#include "test_bvh.h"
+#include "test_canvas_commands.h"
+#include "test_command_queue.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
+#include "test_memory.h"
 #include "test_oa_hash_map.h"
+#include "test_object_db.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
+#include "test_pool_vector.h"
 #include "test_render.h"
+#include "test_resource_loader.h"
+#include "test_rid.h"
 #include "test_shader_lang.h"
+#include "test_signals.h"
 #include "test_string.h"
+#include "test_string_name.h"
 
 const char **tests_get_names() {
 
@@ -60,8 +70,19 @@ const char **tests_get_names() {
 		"gd_parser",
 		"gd_compiler",
 		"gd_bytecode",
+		"gd_benchmark",
 		"ordered_hash_map",
 		"astar",
+		"bvh",
+		"object_db",
+		"signals",
+		"pool_vector",
+		"canvas_commands",
+		"resource_loader",
+		"memory",
+		"command_queue",
+		"string_name",
+		"rid",
 		NULL
 	};
 
@@ -132,6 +153,11 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_benchmark") {
+
+		return TestGDScript::test(TestGDScript::TEST_BENCHMARK);
+	}
+
 	if (p_test == "ordered_hash_map") {
 
 		return TestOrderedHashMap::test();
@@ -142,6 +168,56 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "bvh") {
+
+		return TestBVH::test();
+	}
+
+	if (p_test == "object_db") {
+
+		return TestObjectDB::test();
+	}
+
+	if (p_test == "signals") {
+
+		return TestSignals::test();
+	}
+
+	if (p_test == "pool_vector") {
+
+		return TestPoolVector::test();
+	}
+
+	if (p_test == "canvas_commands") {
+
+		return TestCanvasCommands::test();
+	}
+
+	if (p_test == "resource_loader") {
+
+		return TestResourceLoader::test();
+	}
+
+	if (p_test == "memory") {
+
+		return TestMemory::test();
+	}
+
+	if (p_test == "command_queue") {
+
+		return TestCommandQueue::test();
+	}
+
+	if (p_test == "string_name") {
+
+		return TestStringName::test();
+	}
+
+	if (p_test == "rid") {
+
+		return TestRID::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
@@ -0,0 +1,294 @@
+/*************************************************************************/
+/*  test_memory.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_memory.h"
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+namespace TestMemory {
+
+#ifdef SLAB_ALLOCATOR_ENABLED
+
+static void _fill(uint8_t *p_mem, size_t p_bytes, uint32_t p_tag) {
+
+	for (size_t i = 0; i < p_bytes; i++) {
+		p_mem[i] = uint8_t(p_tag + i);
+	}
+}
+
+static bool _check(const uint8_t *p_mem, size_t p_bytes, uint32_t p_tag) {
+
+	for (size_t i = 0; i < p_bytes; i++) {
+		if (p_mem[i] != uint8_t(p_tag + i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool test_size_classes() {
+
+	OS::get_singleton()->print("\n\nTest 1: Size class selection\n");
+
+	// Block sizes include the pad header, -1 means the block must come from malloc.
+	const int block_sizes[] = { 32, 33, 256, 257 };
+	const int expected[] = { 0, 1, Memory::SLAB_CLASS_COUNT - 1, -1 };
+
+	if (Memory::get_slab_class_size(0) != 32 || Memory::get_slab_class_size(1) != 48 || Memory::get_slab_class_size(Memory::SLAB_CLASS_COUNT - 1) != Memory::SLAB_MAX_BLOCK) {
+		OS::get_singleton()->print("\tunexpected class sizes\n");
+		return false;
+	}
+
+	bool pass = true;
+	for (int i = 0; i < 4; i++) {
+		size_t bytes = block_sizes[i] - PAD_ALIGN;
+		// Enough blocks to need more than one fresh slab in any class.
+		const int count = 4 * 65536 / Memory::get_slab_class_size(0);
+		uint8_t **blocks = (uint8_t **)memalloc(count * sizeof(uint8_t *));
+
+		uint64_t before[Memory::SLAB_CLASS_COUNT];
+		for (int j = 0; j < Memory::SLAB_CLASS_COUNT; j++) {
+			before[j] = Memory::get_slab_class_usage(j);
+		}
+
+		for (int j = 0; j < count; j++) {
+			blocks[j] = (uint8_t *)memalloc(bytes);
+			_fill(blocks[j], bytes, j);
+		}
+
+		for (int j = 0; j < Memory::SLAB_CLASS_COUNT; j++) {
+			bool grew = Memory::get_slab_class_usage(j) > before[j];
+			if (grew != (j == expected[i])) {
+				OS::get_singleton()->print("\t%d byte blocks %s class %d\n", block_sizes[i], grew ? "grew" : "did not grow", j);
+				pass = false;
+			}
+		}
+
+		for (int j = 0; j < count; j++) {
+			if (!_check(blocks[j], bytes, j)) {
+				OS::get_singleton()->print("\t%d byte block %d was overwritten\n", block_sizes[i], j);
+				pass = false;
+				break;
+			}
+		}
+		for (int j = 0; j < count; j++) {
+			memfree(blocks[j]);
+		}
+		memfree(blocks);
+	}
+
+	return pass;
+}
+
+static bool test_realloc() {
+
+	OS::get_singleton()->print("\n\nTest 2: Realloc across the slab and malloc boundary\n");
+
+	uint64_t usage = Memory::get_mem_usage();
+
+	// Start in the smallest class, move up through the classes into malloc and back down.
+	const size_t sizes[] = { 8, 20, 100, 240, 241, 5000, 241, 240, 200, 17, 1 };
+	uint8_t *mem = (uint8_t *)memalloc(sizes[0]);
+	_fill(mem, sizes[0], 7);
+
+	bool pass = true;
+	for (int i = 1; i < 11; i++) {
+		mem = (uint8_t *)memrealloc(mem, sizes[i]);
+		size_t kept = MIN(sizes[i - 1], sizes[i]);
+		if (!_check(mem, kept, 7)) {
+			OS::get_singleton()->print("\tcontents lost going from %d to %d bytes\n", int(sizes[i - 1]), int(sizes[i]));
+			pass = false;
+		}
+		_fill(mem, sizes[i], 7);
+	}
+
+	// Staying in the same class keeps the block.
+	uint8_t *same = (uint8_t *)memrealloc(mem, 16);
+	if (same != mem) {
+		OS::get_singleton()->print("\trealloc within a class moved the block\n");
+		pass = false;
+	}
+	memfree(same);
+
+	if (Memory::get_mem_usage() != usage) {
+		OS::get_singleton()->print("\tmemory usage off by %d bytes\n", int(Memory::get_mem_usage() - usage));
+		pass = false;
+	}
+
+	return pass;
+}
+
+#define CROSS_THREADS 4
+#define CROSS_BLOCKS 4096
+
+struct CrossThread {
+	uint8_t **own;
+	uint8_t **other;
+	uint32_t tag;
+	volatile uint32_t *errors;
+};
+
+static size_t _cross_size(int p_index) {
+
+	return 1 + (p_index * 37) % (Memory::SLAB_MAX_BLOCK + 64);
+}
+
+static void _cross_thread(void *p_userdata) {
+
+	CrossThread *ct = (CrossThread *)p_userdata;
+
+	// Free what another thread allocated, then allocate a new set for the next thread.
+	for (int i = 0; i < CROSS_BLOCKS; i++) {
+		if (!ct->other[i]) {
+			continue;
+		}
+		if (!_check(ct->other[i], _cross_size(i), ct->tag - 1)) {
+			atomic_increment(ct->errors);
+		}
+		memfree(ct->other[i]);
+		ct->other[i] = NULL;
+	}
+	for (int i = 0; i < CROSS_BLOCKS; i++) {
+		ct->own[i] = (uint8_t *)memalloc(_cross_size(i));
+		_fill(ct->own[i], _cross_size(i), ct->tag);
+	}
+}
+
+static bool test_cross_thread_free() {
+
+	OS::get_singleton()->print("\n\nTest 3: Blocks freed by other threads\n");
+
+	volatile uint32_t errors = 0;
+	// Two generations of sets, one is freed while the other is refilled.
+	uint8_t **sets[2][CROSS_THREADS];
+	for (int g = 0; g < 2; g++) {
+		for (int i = 0; i < CROSS_THREADS; i++) {
+			sets[g][i] = (uint8_t **)memalloc(CROSS_BLOCKS * sizeof(uint8_t *));
+			for (int j = 0; j < CROSS_BLOCKS; j++) {
+				sets[g][i][j] = NULL;
+			}
+		}
+	}
+
+	const int rounds = 20;
+	uint64_t first_usage = 0;
+	for (int r = 0; r < rounds; r++) {
+		CrossThread ct[CROSS_THREADS];
+		Thread *threads[CROSS_THREADS];
+		for (int i = 0; i < CROSS_THREADS; i++) {
+			// Never the set this thread's slot filled last round.
+			ct[i].other = sets[r & 1][(i + 1 + r % (CROSS_THREADS - 1)) % CROSS_THREADS];
+			ct[i].own = sets[(r + 1) & 1][i];
+			ct[i].tag = r;
+			ct[i].errors = &errors;
+		}
+		for (int i = 0; i < CROSS_THREADS; i++) {
+			threads[i] = Thread::create(_cross_thread, &ct[i]);
+		}
+		for (int i = 0; i < CROSS_THREADS; i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+		if (r == 1) {
+			first_usage = Memory::get_slab_usage();
+		}
+	}
+
+	for (int g = 0; g < 2; g++) {
+		for (int i = 0; i < CROSS_THREADS; i++) {
+			for (int j = 0; j < CROSS_BLOCKS; j++) {
+				if (sets[g][i][j]) {
+					memfree(sets[g][i][j]);
+				}
+			}
+			memfree(sets[g][i]);
+		}
+	}
+
+	bool pass = errors == 0;
+	if (errors) {
+		OS::get_singleton()->print("\t%d blocks were handed out twice\n", errors);
+	}
+
+	// Blocks freed away from their thread go back through the depot, so the
+	// steady state must not keep carving new slabs.
+	uint64_t usage = Memory::get_slab_usage();
+	if (usage > first_usage * 2) {
+		OS::get_singleton()->print("\tslab usage grew from %d to %d KiB\n", int(first_usage / 1024), int(usage / 1024));
+		pass = false;
+	}
+
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_size_classes,
+	test_realloc,
+	test_cross_thread_free,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+
+#else
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("Not built with slab_allocator=yes, nothing to test.\n");
+	return NULL;
+}
+
+#endif
+
+} // namespace TestMemory
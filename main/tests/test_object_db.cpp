@@ -0,0 +1,240 @@
+/*************************************************************************/
+/*  test_object_db.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_object_db.h"
+
+#include "core/object.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+namespace TestObjectDB {
+
+static bool test_lookup() {
+
+	OS::get_singleton()->print("\n\nTest 1: Lookup and stale IDs\n");
+
+	const int count = 10000;
+	Vector<Object *> objects;
+	Vector<ObjectID> ids;
+	for (int i = 0; i < count; i++) {
+		Object *obj = memnew(Object);
+		objects.push_back(obj);
+		ids.push_back(obj->get_instance_id());
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (ObjectDB::get_instance(ids[i]) != objects[i] || !ObjectDB::instance_validate(objects[i])) {
+			OS::get_singleton()->print("\tobject %d does not resolve\n", i);
+			return false;
+		}
+	}
+
+	for (int i = 0; i < count; i += 2) {
+		memdelete(objects[i]);
+	}
+
+	// Freed slots are reused, the IDs pointing at them must stay dead.
+	Vector<Object *> reused;
+	for (int i = 0; i < count / 2; i++) {
+		reused.push_back(memnew(Object));
+	}
+
+	bool pass = true;
+	for (int i = 0; i < count; i++) {
+		Object *expected = (i & 1) ? objects[i] : NULL;
+		if (ObjectDB::get_instance(ids[i]) != expected) {
+			OS::get_singleton()->print("\tID %d resolves to the wrong object\n", i);
+			pass = false;
+			break;
+		}
+	}
+	for (int i = 0; i < reused.size() && pass; i++) {
+		if (ObjectDB::get_instance(reused[i]->get_instance_id()) != reused[i]) {
+			OS::get_singleton()->print("\treused slot %d does not resolve\n", i);
+			pass = false;
+		}
+	}
+	if (ObjectDB::get_instance(0) != NULL) {
+		OS::get_singleton()->print("\tnull ID resolves\n");
+		pass = false;
+	}
+
+	for (int i = 1; i < count; i += 2) {
+		memdelete(objects[i]);
+	}
+	for (int i = 0; i < reused.size(); i++) {
+		memdelete(reused[i]);
+	}
+
+	return pass;
+}
+
+struct ThreadedLookup {
+	Vector<Object *> objects;
+	Vector<ObjectID> ids;
+	volatile uint32_t done;
+	volatile uint32_t errors;
+};
+
+static void _lookup_thread(void *p_userdata) {
+
+	ThreadedLookup *tl = (ThreadedLookup *)p_userdata;
+	while (!tl->done) {
+		for (int i = 0; i < tl->ids.size(); i++) {
+			if (ObjectDB::get_instance(tl->ids[i]) != tl->objects[i]) {
+				atomic_increment(&tl->errors);
+			}
+		}
+	}
+}
+
+static bool test_threaded() {
+
+	OS::get_singleton()->print("\n\nTest 2: Lookups racing object churn\n");
+
+	ThreadedLookup tl;
+	tl.done = 0;
+	tl.errors = 0;
+	for (int i = 0; i < 1000; i++) {
+		Object *obj = memnew(Object);
+		tl.objects.push_back(obj);
+		tl.ids.push_back(obj->get_instance_id());
+	}
+
+	Thread *threads[4];
+	for (int i = 0; i < 4; i++) {
+		threads[i] = Thread::create(_lookup_thread, &tl);
+	}
+
+	Vector<Object *> churn;
+	for (int i = 0; i < 200000; i++) {
+		churn.push_back(memnew(Object));
+		if (churn.size() > 500) {
+			memdelete(churn[i % churn.size()]);
+			churn.remove(i % churn.size());
+		}
+	}
+
+	tl.done = 1;
+	for (int i = 0; i < 4; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+	for (int i = 0; i < churn.size(); i++) {
+		memdelete(churn[i]);
+	}
+	for (int i = 0; i < tl.objects.size(); i++) {
+		memdelete(tl.objects[i]);
+	}
+
+	if (tl.errors) {
+		OS::get_singleton()->print("\t%d lookups failed\n", tl.errors);
+	}
+	return tl.errors == 0;
+}
+
+static void benchmark(int p_count) {
+
+	Vector<Object *> objects;
+	objects.resize(p_count);
+	Vector<ObjectID> ids;
+	ids.resize(p_count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		objects.write[i] = memnew(Object);
+		ids.write[i] = objects[i]->get_instance_id();
+	}
+	uint64_t created = OS::get_singleton()->get_ticks_usec();
+
+	const int rounds = 10;
+	int found = 0;
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < p_count; i++) {
+			found += ObjectDB::get_instance(ids[i]) != NULL;
+		}
+	}
+	uint64_t looked_up = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < p_count; i++) {
+		found += ObjectDB::instance_validate(objects[i]);
+	}
+	uint64_t validated = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < p_count; i++) {
+		memdelete(objects[i]);
+	}
+	uint64_t destroyed = OS::get_singleton()->get_ticks_usec();
+
+	OS::get_singleton()->print("\t%7d objects: create %8.0f/ms, destroy %8.0f/ms, lookup %8.0f/ms, validate %8.0f/ms (%d found)\n",
+			p_count,
+			p_count * 1000.0 / MAX(1, created - begin),
+			p_count * 1000.0 / MAX(1, destroyed - validated),
+			p_count * rounds * 1000.0 / MAX(1, looked_up - created),
+			p_count * 1000.0 / MAX(1, validated - looked_up),
+			found);
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_lookup,
+	test_threaded,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	OS::get_singleton()->print("\nBenchmark:\n");
+	for (int n = 1000; n <= 1000000; n *= 10) {
+		benchmark(n);
+	}
+
+	return NULL;
+}
+
+} // namespace TestObjectDB
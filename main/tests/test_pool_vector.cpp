@@ -0,0 +1,249 @@
+/*************************************************************************/
+/*  test_pool_vector.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_pool_vector.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/pool_vector.h"
+
+namespace TestPoolVector {
+
+static bool test_cow() {
+
+	OS::get_singleton()->print("\n\nTest 1: Copy on write\n");
+
+	uint32_t allocs = MemoryPool::allocs_used;
+
+	bool pass = true;
+	{
+		PoolVector<String> a;
+		for (int i = 0; i < 100; i++) {
+			a.push_back(itos(i));
+		}
+
+		PoolVector<String> b = a;
+		b.set(10, "changed");
+		b.resize(50);
+		b.append("last");
+
+		pass = pass && a.size() == 100 && a[10] == "10" && a[99] == "99";
+		pass = pass && b.size() == 51 && b[10] == "changed" && b[11] == "11" && b[50] == "last";
+
+		PoolVector<int> c;
+		c.resize(1000);
+		{
+			PoolVector<int>::Write w = c.write();
+			for (int i = 0; i < 1000; i++) {
+				w[i] = i;
+			}
+		}
+		PoolVector<int> d = c;
+		d.invert();
+		pass = pass && c[0] == 0 && d[0] == 999 && d[999] == 0;
+
+		c.resize(0);
+		pass = pass && c.size() == 0 && d.size() == 1000;
+	}
+
+	if (MemoryPool::allocs_used != allocs) {
+		OS::get_singleton()->print("\t%d allocs leaked\n", MemoryPool::allocs_used - allocs);
+		pass = false;
+	}
+
+	return pass;
+}
+
+struct ThreadedCopies {
+	PoolVector<String> shared;
+	volatile uint32_t errors;
+};
+
+static void _copy_thread(void *p_userdata) {
+
+	ThreadedCopies *tc = (ThreadedCopies *)p_userdata;
+	for (int i = 0; i < 2000; i++) {
+		PoolVector<String> copy = tc->shared;
+		{
+			PoolVector<String>::Read r = copy.read();
+			if (r[i % copy.size()] != itos(i % copy.size())) {
+				atomic_increment(&tc->errors);
+			}
+		}
+		copy.set(0, "mine");
+		copy.resize(i % 64 + 1);
+		if (copy[0] != "mine" || tc->shared[0] != "0") {
+			atomic_increment(&tc->errors);
+		}
+	}
+}
+
+static bool test_threaded() {
+
+	OS::get_singleton()->print("\n\nTest 2: Copies racing on eight threads\n");
+
+	uint32_t allocs = MemoryPool::allocs_used;
+
+	ThreadedCopies tc;
+	tc.errors = 0;
+	for (int i = 0; i < 256; i++) {
+		tc.shared.push_back(itos(i));
+	}
+
+	Thread *threads[8];
+	for (int i = 0; i < 8; i++) {
+		threads[i] = Thread::create(_copy_thread, &tc);
+	}
+	for (int i = 0; i < 8; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+	tc.shared = PoolVector<String>();
+
+	if (tc.errors) {
+		OS::get_singleton()->print("\t%d checks failed\n", tc.errors);
+	}
+	if (MemoryPool::allocs_used != allocs) {
+		OS::get_singleton()->print("\t%d allocs leaked\n", MemoryPool::allocs_used - allocs);
+	}
+	return tc.errors == 0 && MemoryPool::allocs_used == allocs;
+}
+
+enum BenchmarkMode {
+	BENCHMARK_READ,
+	BENCHMARK_WRITE,
+	BENCHMARK_RESIZE,
+	BENCHMARK_COW,
+	BENCHMARK_MAX
+};
+
+struct Benchmark {
+	BenchmarkMode mode;
+	PoolVector<Vector3> shared;
+	int ops;
+};
+
+static void _benchmark_thread(void *p_userdata) {
+
+	Benchmark *b = (Benchmark *)p_userdata;
+	PoolVector<Vector3> own = b->shared;
+	own.set(0, Vector3()); // make it unique
+	real_t sum = 0;
+
+	for (int i = 0; i < b->ops; i++) {
+		switch (b->mode) {
+			case BENCHMARK_READ: {
+				PoolVector<Vector3>::Read r = b->shared.read();
+				sum += r[i & 63].x;
+			} break;
+			case BENCHMARK_WRITE: {
+				PoolVector<Vector3>::Write w = own.write();
+				w[i & 63].x += 1;
+			} break;
+			case BENCHMARK_RESIZE: {
+				own.resize(64 + (i & 63));
+			} break;
+			case BENCHMARK_COW: {
+				PoolVector<Vector3> copy = b->shared;
+				copy.set(i & 63, Vector3());
+			} break;
+			default: {
+			}
+		}
+	}
+
+	// keep the loop from being optimized away
+	if (sum < 0) {
+		OS::get_singleton()->print("%f\n", sum);
+	}
+}
+
+static void benchmark(int p_threads) {
+
+	static const char *mode_names[BENCHMARK_MAX] = { "read", "write", "resize", "cow" };
+
+	OS::get_singleton()->print("\t%d threads:", p_threads);
+	for (int mode = 0; mode < BENCHMARK_MAX; mode++) {
+
+		Benchmark b;
+		b.mode = BenchmarkMode(mode);
+		b.shared.resize(128);
+		b.ops = mode == BENCHMARK_COW ? 20000 : 200000;
+
+		Thread *threads[8];
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_threads; i++) {
+			threads[i] = Thread::create(_benchmark_thread, &b);
+		}
+		for (int i = 0; i < p_threads; i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+		uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+		OS::get_singleton()->print(" %s %8.0f/ms", mode_names[mode], b.ops * p_threads * 1000.0 / MAX(1, end - begin));
+	}
+	OS::get_singleton()->print("\n");
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_cow,
+	test_threaded,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	OS::get_singleton()->print("\nBenchmark:\n");
+	benchmark(1);
+	benchmark(8);
+
+	return NULL;
+}
+
+} // namespace TestPoolVector
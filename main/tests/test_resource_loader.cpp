@@ -0,0 +1,357 @@
+/*************************************************************************/
+/*  test_resource_loader.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_loader.h"
+
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+namespace TestResourceLoader {
+
+// Loads a bare Resource named after its path, sleeping a bit on every stage.
+// If it has a dependency, it's loaded first the way the binary loader does on loader threads.
+class TestInteractiveLoader : public ResourceInteractiveLoader {
+
+public:
+	String path;
+	String dependency;
+	int stage;
+	int stage_count;
+	Ref<Resource> resource;
+
+	virtual void set_local_path(const String &p_local_path) { path = p_local_path; }
+	virtual Ref<Resource> get_resource() { return resource; }
+	virtual Error poll() {
+		if (stage == stage_count) {
+			return ERR_FILE_EOF;
+		}
+		if (stage == 0 && dependency != String()) {
+			ResourceLoader::load_threaded_request(dependency);
+			ResourceLoader::load_threaded_get(dependency);
+		}
+		OS::get_singleton()->delay_usec(500);
+		stage++;
+		if (stage == stage_count) {
+			resource.instance();
+			resource->set_name(path);
+			return ERR_FILE_EOF;
+		}
+		return OK;
+	}
+	virtual int get_stage() const { return stage; }
+	virtual int get_stage_count() const { return stage_count; }
+	virtual void set_translation_remapped(bool p_remapped) {}
+};
+
+class TestFormatLoader : public ResourceFormatLoader {
+
+public:
+	uint32_t loads;
+
+	virtual Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_original_path, Error *r_error) {
+		atomic_increment(&loads);
+		Ref<TestInteractiveLoader> ril;
+		ril.instance();
+		ril->path = p_path;
+		ril->stage = 0;
+		ril->stage_count = p_path.get_basename().ends_with("slow") ? 400 : 20;
+		if (p_path.get_file().begins_with("cycle_a")) {
+			ril->dependency = p_path.replace("cycle_a", "cycle_b");
+		} else if (p_path.get_file().begins_with("cycle_b")) {
+			ril->dependency = p_path.replace("cycle_b", "cycle_a");
+		}
+		if (r_error) {
+			*r_error = OK;
+		}
+		return ril;
+	}
+	virtual void get_recognized_extensions(List<String> *p_extensions) const { p_extensions->push_back("testres"); }
+	virtual bool handles_type(const String &p_type) const { return p_type == "Resource"; }
+	virtual String get_resource_type(const String &p_path) const { return p_path.get_extension() == "testres" ? "Resource" : ""; }
+
+	TestFormatLoader() { loads = 0; }
+};
+
+static Ref<TestFormatLoader> format_loader;
+
+static bool _wait_for_status(const String &p_path, ResourceLoader::ThreadLoadStatus p_status) {
+
+	for (int i = 0; i < 10000; i++) {
+		if (ResourceLoader::load_threaded_get_status(p_path) == p_status) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+static bool test_request_get() {
+
+	OS::get_singleton()->print("\n\nTest 1: Request, status and get\n");
+
+	const int count = 16;
+	for (int i = 0; i < count; i++) {
+		ResourceLoader::load_threaded_request("res://request_" + itos(i) + ".testres", "", i % 3);
+	}
+
+	bool pass = true;
+	for (int i = 0; i < count; i++) {
+		String path = "res://request_" + itos(i) + ".testres";
+		float progress = -1;
+		ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(path, &progress);
+		if (status != ResourceLoader::THREAD_LOAD_IN_PROGRESS && status != ResourceLoader::THREAD_LOAD_LOADED) {
+			OS::get_singleton()->print("\t%d has status %d\n", i, status);
+			pass = false;
+		}
+		if (progress < 0 || progress > 1) {
+			OS::get_singleton()->print("\t%d has progress %f\n", i, progress);
+			pass = false;
+		}
+	}
+
+	// Half are waited for by polling the status, the other half by blocking in get.
+	for (int i = 0; i < count; i += 2) {
+		if (!_wait_for_status("res://request_" + itos(i) + ".testres", ResourceLoader::THREAD_LOAD_LOADED)) {
+			OS::get_singleton()->print("\t%d never finished loading\n", i);
+			pass = false;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		String path = "res://request_" + itos(i) + ".testres";
+		Error err;
+		RES res = ResourceLoader::load_threaded_get(path, &err);
+		if (err != OK || res.is_null() || res->get_name() != path) {
+			OS::get_singleton()->print("\t%d was not loaded\n", i);
+			pass = false;
+		}
+		if (ResourceLoader::load_threaded_get_status(path) != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE) {
+			OS::get_singleton()->print("\t%d is still tracked after get\n", i);
+			pass = false;
+		}
+	}
+
+	return pass;
+}
+
+static bool test_shared_request() {
+
+	OS::get_singleton()->print("\n\nTest 2: Requesting a path twice loads it once\n");
+
+	uint32_t loads = format_loader->loads;
+	String path = "res://shared.testres";
+	ResourceLoader::load_threaded_request(path);
+	ResourceLoader::load_threaded_request(path);
+
+	RES first = ResourceLoader::load_threaded_get(path);
+	bool pass = ResourceLoader::load_threaded_get_status(path) != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+	RES second = ResourceLoader::load_threaded_get(path);
+
+	pass = pass && first.is_valid() && first == second;
+	pass = pass && format_loader->loads == loads + 1;
+	pass = pass && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+	return pass;
+}
+
+static bool test_cancel() {
+
+	OS::get_singleton()->print("\n\nTest 3: Cancel\n");
+
+	bool pass = true;
+
+	String path = "res://cancelled_slow.testres";
+	ResourceLoader::load_threaded_request(path);
+	ResourceLoader::load_threaded_cancel(path);
+	// If a worker already picked it up, it stops at the next stage.
+	if (!_wait_for_status(path, ResourceLoader::THREAD_LOAD_INVALID_RESOURCE)) {
+		OS::get_singleton()->print("\tcancelled request is still tracked\n");
+		pass = false;
+	}
+
+	// Cancelling one of two requests keeps the load going.
+	path = "res://half_cancelled.testres";
+	ResourceLoader::load_threaded_request(path);
+	ResourceLoader::load_threaded_request(path);
+	ResourceLoader::load_threaded_cancel(path);
+	RES res = ResourceLoader::load_threaded_get(path);
+	if (res.is_null()) {
+		OS::get_singleton()->print("\tremaining request was not loaded\n");
+		pass = false;
+	}
+
+	// Requested again while being cancelled, the load starts over.
+	path = "res://requested_again_slow.testres";
+	ResourceLoader::load_threaded_request(path);
+	OS::get_singleton()->delay_usec(5000);
+	ResourceLoader::load_threaded_cancel(path);
+	ResourceLoader::load_threaded_request(path);
+	res = ResourceLoader::load_threaded_get(path);
+	if (res.is_null() || res->get_name() != path) {
+		OS::get_singleton()->print("\tload requested again was not loaded\n");
+		pass = false;
+	}
+
+	return pass;
+}
+
+struct RacingLoad {
+	String path;
+	RES results[4];
+	volatile uint32_t next;
+};
+
+static void _load_thread(void *p_userdata) {
+
+	RacingLoad *rl = (RacingLoad *)p_userdata;
+	uint32_t index = atomic_increment(&rl->next) - 1;
+	rl->results[index] = ResourceLoader::load(rl->path);
+}
+
+static bool test_racing_load() {
+
+	OS::get_singleton()->print("\n\nTest 4: load() racing a threaded request\n");
+
+	uint32_t loads = format_loader->loads;
+
+	RacingLoad rl;
+	rl.path = "res://racing_slow.testres";
+	rl.next = 0;
+
+	Thread *threads[4];
+	for (int i = 0; i < 4; i++) {
+		threads[i] = Thread::create(_load_thread, &rl);
+	}
+	ResourceLoader::load_threaded_request(rl.path);
+	RES res = ResourceLoader::load_threaded_get(rl.path);
+
+	for (int i = 0; i < 4; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	bool pass = res.is_valid();
+	for (int i = 0; i < 4; i++) {
+		if (rl.results[i] != res) {
+			OS::get_singleton()->print("\tthread %d got a different resource\n", i);
+			pass = false;
+		}
+	}
+	if (format_loader->loads != loads + 1) {
+		OS::get_singleton()->print("\tloaded %d times\n", format_loader->loads - loads);
+		pass = false;
+	}
+	return pass;
+}
+
+static bool test_cyclic_dependency() {
+
+	OS::get_singleton()->print("\n\nTest 5: Resources depending on each other\n");
+
+	bool pass = true;
+
+	// Requesting one runs the other inline on the same thread, requesting both may also
+	// split the cycle across two threads. Either way the second wait must fail instead of hanging.
+	String paths[3] = { "res://cycle_a.testres", "res://cycle_a_both.testres", "res://cycle_b_both.testres" };
+	for (int i = 0; i < 3; i++) {
+		ResourceLoader::load_threaded_request(paths[i]);
+	}
+
+	for (int i = 0; i < 3; i++) {
+		bool finished = false;
+		for (int j = 0; j < 10000 && !finished; j++) {
+			finished = ResourceLoader::load_threaded_get_status(paths[i]) != ResourceLoader::THREAD_LOAD_IN_PROGRESS;
+			if (!finished) {
+				OS::get_singleton()->delay_usec(1000);
+			}
+		}
+		if (!finished) {
+			OS::get_singleton()->print("\t%ls never finished loading\n", paths[i].c_str());
+			return false;
+		}
+	}
+
+	for (int i = 0; i < 3; i++) {
+		RES res = ResourceLoader::load_threaded_get(paths[i]);
+		if (res.is_null() || res->get_name() != paths[i]) {
+			OS::get_singleton()->print("\t%ls was not loaded\n", paths[i].c_str());
+			pass = false;
+		}
+	}
+
+	// The dependency requested by the inline load was balanced by its get.
+	if (ResourceLoader::load_threaded_get_status("res://cycle_b.testres") != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE) {
+		OS::get_singleton()->print("\tdependency is still tracked\n");
+		pass = false;
+	}
+
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_request_get,
+	test_shared_request,
+	test_cancel,
+	test_racing_load,
+	test_cyclic_dependency,
+	NULL
+};
+
+MainLoop *test() {
+
+	format_loader.instance();
+	ResourceLoader::add_resource_format_loader(format_loader, true);
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	ResourceLoader::remove_resource_format_loader(format_loader);
+	format_loader.unref();
+
+	return NULL;
+}
+
+} // namespace TestResourceLoader
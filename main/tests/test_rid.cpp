@@ -0,0 +1,375 @@
+/*************************************************************************/
+/*  test_rid.cpp                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_rid.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/rid.h"
+#include "core/safe_refcount.h"
+
+namespace TestRID {
+
+static volatile uint32_t alive_count = 0;
+
+struct TestData : public RID_Data {
+	int value;
+
+	TestData() {
+		value = 0;
+		atomic_increment(&alive_count);
+	}
+	~TestData() {
+		atomic_decrement(&alive_count);
+	}
+};
+
+static bool test_freed_and_stale() {
+
+	OS::get_singleton()->print("\n\nTest 1: Freed and stale RIDs\n");
+
+	RID_Owner<TestData> owner;
+	const int count = 1000;
+	Vector<TestData *> data;
+	Vector<RID> rids;
+	for (int i = 0; i < count; i++) {
+		TestData *d = memnew(TestData);
+		data.push_back(d);
+		rids.push_back(owner.make_rid(d));
+	}
+
+	bool pass = true;
+	for (int i = 0; i < count; i++) {
+		if (owner.getptr(rids[i]) != data[i]) {
+			OS::get_singleton()->print("\tRID %d does not resolve\n", i);
+			pass = false;
+			break;
+		}
+	}
+
+	for (int i = 0; i < count; i += 2) {
+		owner.free(rids[i]);
+		memdelete(data[i]);
+	}
+
+	// The freed slots are reused, the old RIDs must not resolve to the new data.
+	Vector<RID> reused;
+	for (int i = 0; i < count / 2; i++) {
+		reused.push_back(owner.make_rid(memnew(TestData)));
+	}
+
+	for (int i = 0; i < count && pass; i++) {
+		bool freed = (i & 1) == 0;
+		if (owner.owns(rids[i]) == freed || owner.getptr(rids[i]) != (freed ? NULL : data[i])) {
+			OS::get_singleton()->print("\t%s RID %d resolves wrong\n", freed ? "stale" : "live", i);
+			pass = false;
+		}
+	}
+	if (owner.owns(RID()) || owner.get_rid_count() != uint32_t(count)) {
+		OS::get_singleton()->print("\tnull RID owned or wrong count\n");
+		pass = false;
+	}
+
+	for (int i = 1; i < count; i += 2) {
+		owner.free(rids[i]);
+		memdelete(data[i]);
+	}
+	for (int i = 0; i < reused.size(); i++) {
+		TestData *d = owner.getptr(reused[i]);
+		owner.free(reused[i]);
+		memdelete(d);
+	}
+
+	return pass;
+}
+
+static bool test_foreign() {
+
+	OS::get_singleton()->print("\n\nTest 2: RIDs from another owner\n");
+
+	RID_Owner<TestData> owner_a;
+	RID_Owner<TestData> owner_b;
+
+	// Both owners get the same slots, only the validator tells them apart.
+	Vector<RID> rids_a;
+	Vector<RID> rids_b;
+	for (int i = 0; i < 100; i++) {
+		rids_a.push_back(owner_a.make_rid());
+		rids_b.push_back(owner_b.make_rid());
+	}
+
+	bool pass = true;
+	for (int i = 0; i < 100; i++) {
+		if (owner_a.owns(rids_b[i]) || owner_b.owns(rids_a[i]) || !owner_a.owns(rids_a[i]) || !owner_b.owns(rids_b[i])) {
+			OS::get_singleton()->print("\tRID %d is owned by the wrong owner\n", i);
+			pass = false;
+			break;
+		}
+	}
+
+	// Freeing through the wrong owner must leave both alone.
+	owner_b.free(rids_a[0]);
+	if (!owner_a.owns(rids_a[0]) || !owner_b.owns(rids_b[0])) {
+		OS::get_singleton()->print("\tforeign free released a RID\n");
+		pass = false;
+	}
+
+	for (int i = 0; i < 100; i++) {
+		owner_a.free(rids_a[i]);
+		owner_b.free(rids_b[i]);
+	}
+
+	return pass;
+}
+
+static bool test_in_place() {
+
+	OS::get_singleton()->print("\n\nTest 3: Objects made in place\n");
+
+	uint32_t alive = alive_count;
+	RID_Owner<TestData> owner;
+	const int count = 1000;
+	Vector<RID> rids;
+	for (int i = 0; i < count; i++) {
+		RID rid = owner.make_rid();
+		owner.get(rid)->value = i;
+		rids.push_back(rid);
+	}
+
+	bool pass = true;
+	if (alive_count != alive + count) {
+		OS::get_singleton()->print("\t%d objects made, expected %d\n", int(alive_count - alive), count);
+		pass = false;
+	}
+
+	// Objects handed over by pointer can live in the same owner.
+	TestData *external = memnew(TestData);
+	external->value = -1;
+	RID external_rid = owner.make_rid(external);
+
+	for (int i = 0; i < count; i += 2) {
+		owner.free(rids[i]);
+	}
+	if (alive_count != alive + count / 2 + 1) {
+		OS::get_singleton()->print("\tfree() destroyed %d objects, expected %d\n", int(alive + count + 1 - alive_count), count / 2);
+		pass = false;
+	}
+
+	// New objects take the freed slots, stale RIDs must not reach them.
+	Vector<RID> reused;
+	for (int i = 0; i < count / 2; i++) {
+		RID rid = owner.make_rid();
+		owner.get(rid)->value = count + i;
+		reused.push_back(rid);
+	}
+	for (int i = 0; i < count && pass; i++) {
+		TestData *d = owner.getptr(rids[i]);
+		if ((i & 1) ? (!d || d->value != i) : d != NULL) {
+			OS::get_singleton()->print("\tRID %d resolves wrong\n", i);
+			pass = false;
+		}
+	}
+
+	// A stale free must not destroy the object now in its slot.
+	uint32_t before = alive_count;
+	owner.free(rids[0]);
+	if (alive_count != before) {
+		OS::get_singleton()->print("\tstale free destroyed an object\n");
+		pass = false;
+	}
+
+	owner.free(external_rid);
+	if (external->value != -1) {
+		OS::get_singleton()->print("\tobject handed over by pointer was destroyed\n");
+		pass = false;
+	}
+	memdelete(external);
+
+	for (int i = 1; i < count; i += 2) {
+		owner.free(rids[i]);
+	}
+	for (int i = 0; i < reused.size(); i++) {
+		owner.free(reused[i]);
+	}
+	if (alive_count != alive || owner.get_rid_count() != 0) {
+		OS::get_singleton()->print("\t%d objects left\n", int(alive_count - alive));
+		pass = false;
+	}
+
+	return pass;
+}
+
+struct ThreadedRIDs {
+	RID_Owner<TestData> *owner;
+	Vector<RID> shared;
+	volatile uint32_t errors;
+};
+
+static void _rid_thread(void *p_userdata) {
+
+	ThreadedRIDs *tr = (ThreadedRIDs *)p_userdata;
+	RID own[64];
+	for (int i = 0; i < 100000; i++) {
+		RID &rid = own[i % 64];
+		if (rid.is_valid()) {
+			TestData *d = tr->owner->getptr(rid);
+			if (!d || d->value != i - 64) {
+				atomic_increment(&tr->errors);
+			}
+			tr->owner->free(rid);
+		}
+		rid = tr->owner->make_rid();
+		tr->owner->get(rid)->value = i;
+
+		const RID &shared = tr->shared[i % tr->shared.size()];
+		TestData *d = tr->owner->getptr(shared);
+		if (!d || d->value != -(i % tr->shared.size()) - 1) {
+			atomic_increment(&tr->errors);
+		}
+	}
+	for (int i = 0; i < 64; i++) {
+		tr->owner->free(own[i]);
+	}
+}
+
+static bool test_threaded() {
+
+	OS::get_singleton()->print("\n\nTest 4: Making and freeing from several threads\n");
+
+	RID_Owner<TestData> owner;
+	ThreadedRIDs tr;
+	tr.owner = &owner;
+	tr.errors = 0;
+	for (int i = 0; i < 100; i++) {
+		RID rid = owner.make_rid();
+		owner.get(rid)->value = -i - 1;
+		tr.shared.push_back(rid);
+	}
+
+	Thread *threads[4];
+	for (int i = 0; i < 4; i++) {
+		threads[i] = Thread::create(_rid_thread, &tr);
+	}
+	for (int i = 0; i < 4; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	bool pass = tr.errors == 0 && owner.get_rid_count() == uint32_t(tr.shared.size());
+	if (!pass) {
+		OS::get_singleton()->print("\t%d lookups failed, %d RIDs left\n", tr.errors, owner.get_rid_count());
+	}
+	for (int i = 0; i < tr.shared.size(); i++) {
+		owner.free(tr.shared[i]);
+	}
+
+	return pass;
+}
+
+static void benchmark(int p_count) {
+
+	RID_Owner<TestData> owner;
+	Vector<RID> rids;
+	rids.resize(p_count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_count; i++) {
+		rids.write[i] = owner.make_rid(memnew(TestData));
+	}
+	for (int i = 0; i < p_count; i++) {
+		memdelete(owner.getptr(rids[i]));
+		owner.free(rids[i]);
+	}
+	uint64_t freed = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < p_count; i++) {
+		rids.write[i] = owner.make_rid();
+	}
+	uint64_t made_in_place = OS::get_singleton()->get_ticks_usec();
+
+	const int rounds = 10;
+	int found = 0;
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < p_count; i++) {
+			found += owner.getptr(rids[i]) != NULL;
+		}
+	}
+	uint64_t looked_up = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < p_count; i++) {
+		owner.free(rids[i]);
+	}
+	uint64_t freed_in_place = OS::get_singleton()->get_ticks_usec();
+
+	OS::get_singleton()->print("\t%7d RIDs: make+free %8.0f/ms, in place %8.0f/ms, lookup %8.0f/ms (%d found)\n",
+			p_count,
+			p_count * 1000.0 / MAX(1, freed - begin),
+			p_count * 1000.0 / MAX(1, (made_in_place - freed) + (freed_in_place - looked_up)),
+			p_count * rounds * 1000.0 / MAX(1, looked_up - made_in_place),
+			found);
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_freed_and_stale,
+	test_foreign,
+	test_in_place,
+	test_threaded,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	OS::get_singleton()->print("\nBenchmark:\n");
+	for (int n = 1000; n <= 1000000; n *= 10) {
+		benchmark(n);
+	}
+
+	return NULL;
+}
+
+} // namespace TestRID
@@ -0,0 +1,254 @@
+/*************************************************************************/
+/*  test_signals.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_signals.h"
+
+#include "core/class_db.h"
+#include "core/object.h"
+#include "core/os/os.h"
+
+namespace TestSignals {
+
+class SignalReceiver : public Object {
+
+	GDCLASS(SignalReceiver, Object);
+
+public:
+	int calls;
+	int sum;
+
+	// when set, the first callback disconnects every receiver in this list and connects the pending one
+	Object *emitter;
+	Vector<SignalReceiver *> *others;
+	SignalReceiver *pending;
+
+	void _received(int p_value) {
+		calls++;
+		sum += p_value;
+	}
+
+	void _received_bind(int p_value, int p_bind) {
+		calls++;
+		sum += p_value * p_bind;
+	}
+
+	void _received_rewire(int p_value) {
+		calls++;
+		sum += p_value;
+
+		for (int i = 0; i < others->size(); i++) {
+			if (emitter->is_connected("test", (*others)[i], "_received")) {
+				emitter->disconnect("test", (*others)[i], "_received");
+			}
+		}
+		if (pending) {
+			emitter->connect("test", pending, "_received");
+			pending = NULL;
+		}
+	}
+
+	SignalReceiver() {
+		calls = 0;
+		sum = 0;
+		emitter = NULL;
+		others = NULL;
+		pending = NULL;
+	}
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("_received", "value"), &SignalReceiver::_received);
+		ClassDB::bind_method(D_METHOD("_received_bind", "value", "bind"), &SignalReceiver::_received_bind);
+		ClassDB::bind_method(D_METHOD("_received_rewire", "value"), &SignalReceiver::_received_rewire);
+	}
+};
+
+static Object *_make_emitter() {
+
+	Object *emitter = memnew(Object);
+	emitter->add_user_signal(MethodInfo("test", PropertyInfo(Variant::INT, "value")));
+	return emitter;
+}
+
+static bool test_binds() {
+
+	OS::get_singleton()->print("\n\nTest 1: Arguments and binds\n");
+
+	Object *emitter = _make_emitter();
+	Vector<SignalReceiver *> receivers;
+	for (int i = 0; i < 20; i++) {
+		SignalReceiver *r = memnew(SignalReceiver);
+		if (i & 1) {
+			Vector<Variant> binds;
+			binds.push_back(i);
+			emitter->connect("test", r, "_received_bind", binds);
+		} else {
+			emitter->connect("test", r, "_received");
+		}
+		receivers.push_back(r);
+	}
+
+	for (int i = 0; i < 3; i++) {
+		emitter->emit_signal("test", 2);
+	}
+
+	bool pass = true;
+	for (int i = 0; i < receivers.size(); i++) {
+		int expected = (i & 1) ? 3 * 2 * i : 3 * 2;
+		if (receivers[i]->calls != 3 || receivers[i]->sum != expected) {
+			OS::get_singleton()->print("\treceiver %d: %d calls, sum %d (expected %d)\n", i, receivers[i]->calls, receivers[i]->sum, expected);
+			pass = false;
+		}
+		memdelete(receivers[i]);
+	}
+	memdelete(emitter);
+
+	return pass;
+}
+
+static bool test_rewire() {
+
+	OS::get_singleton()->print("\n\nTest 2: Connecting and disconnecting while emitting\n");
+
+	Object *emitter = _make_emitter();
+
+	// the first receiver disconnects the others and connects a new one, the current emission must still
+	// reach the receivers it started with, the next one only the new receiver
+	Vector<SignalReceiver *> others;
+	SignalReceiver *first = memnew(SignalReceiver);
+	SignalReceiver *late = memnew(SignalReceiver);
+	first->emitter = emitter;
+	first->others = &others;
+	first->pending = late;
+	emitter->connect("test", first, "_received_rewire");
+	for (int i = 0; i < 5; i++) {
+		SignalReceiver *r = memnew(SignalReceiver);
+		emitter->connect("test", r, "_received");
+		others.push_back(r);
+	}
+	SignalReceiver *oneshot = memnew(SignalReceiver);
+	emitter->connect("test", oneshot, "_received", Vector<Variant>(), Object::CONNECT_ONESHOT);
+
+	emitter->emit_signal("test", 1);
+	emitter->emit_signal("test", 1);
+
+	bool pass = first->calls == 2 && late->calls == 1 && oneshot->calls == 1;
+	for (int i = 0; i < others.size(); i++) {
+		pass = pass && others[i]->calls == 1;
+		memdelete(others[i]);
+	}
+	if (!pass) {
+		OS::get_singleton()->print("\tfirst %d, late %d, oneshot %d calls\n", first->calls, late->calls, oneshot->calls);
+	}
+
+	memdelete(first);
+	memdelete(late);
+	memdelete(oneshot);
+	memdelete(emitter);
+
+	return pass;
+}
+
+static void benchmark(int p_receivers, bool p_binds) {
+
+	Object *emitter = _make_emitter();
+	Vector<SignalReceiver *> receivers;
+	for (int i = 0; i < p_receivers; i++) {
+		SignalReceiver *r = memnew(SignalReceiver);
+		if (p_binds) {
+			Vector<Variant> binds;
+			binds.push_back(i);
+			emitter->connect("test", r, "_received_bind", binds);
+		} else {
+			emitter->connect("test", r, "_received");
+		}
+		receivers.push_back(r);
+	}
+
+	const int emissions = 1000000 / p_receivers;
+	Variant value = 1;
+	const Variant *args[1] = { &value };
+	StringName signal = "test";
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emissions; i++) {
+		emitter->emit_signal(signal, args, 1);
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	OS::get_singleton()->print("\t%4d receivers%s: %8.0f emissions/ms, %8.0f calls/ms\n",
+			p_receivers, p_binds ? " with binds" : "           ",
+			emissions * 1000.0 / MAX(1, end - begin),
+			emissions * p_receivers * 1000.0 / MAX(1, end - begin));
+
+	for (int i = 0; i < receivers.size(); i++) {
+		memdelete(receivers[i]);
+	}
+	memdelete(emitter);
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_binds,
+	test_rewire,
+	NULL
+};
+
+MainLoop *test() {
+
+	ClassDB::register_class<SignalReceiver>();
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	OS::get_singleton()->print("\nBenchmark:\n");
+	for (int n = 1; n <= 1000; n *= 10) {
+		benchmark(n, false);
+		benchmark(n, true);
+	}
+
+	return NULL;
+}
+
+} // namespace TestSignals
@@ -0,0 +1,222 @@
+/*************************************************************************/
+/*  test_string_name.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_string_name.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+#include "core/string_name.h"
+#include "core/vector.h"
+
+namespace TestStringName {
+
+static bool test_tombstones() {
+
+	OS::get_singleton()->print("\n\nTest 1: Dropped names leave slots for new ones\n");
+
+	// Grow the table first, so there's room to work with no growth in between.
+	Vector<StringName> filler;
+	uint32_t initial_size = StringName::get_table_size();
+	for (int i = 0; StringName::get_table_size() == initial_size && i < 1000000; i++) {
+		filler.push_back(StringName("tombstone_filler_" + itos(i)));
+	}
+
+	uint32_t size = StringName::get_table_size();
+	uint32_t used = StringName::get_table_used();
+	int count = MIN(1000, int(size / 2 - used) / 2);
+
+	Vector<StringName> names;
+	for (int i = 0; i < count; i++) {
+		names.push_back(StringName("tombstone_" + itos(i)));
+	}
+	uint32_t filled = StringName::get_table_used();
+
+	bool pass = true;
+	if (filled != used + count) {
+		OS::get_singleton()->print("\t%d names took %d slots\n", count, int(filled - used));
+		pass = false;
+	}
+
+	// Nothing is reading, so the names are freed on the spot and their slots become tombstones.
+	names.clear();
+	if (StringName::search("tombstone_0") != StringName()) {
+		OS::get_singleton()->print("\tdropped name can still be found\n");
+		pass = false;
+	}
+
+	for (int i = 0; i < count; i++) {
+		names.push_back(StringName("tombstone_" + itos(i)));
+	}
+	if (StringName::get_table_used() != filled || StringName::get_table_size() != size) {
+		OS::get_singleton()->print("\tinterning again took %d new slots\n", int(StringName::get_table_used() - filled));
+		pass = false;
+	}
+
+	return pass;
+}
+
+#define NAME_THREADS 8
+#define NAME_ITERATIONS 50000
+#define SHARED_NAMES 2000
+#define HELD_NAMES 100
+#define OWN_LIVE_NAMES 4096
+
+struct SharedNames {
+	String names[SHARED_NAMES];
+	StringName held[HELD_NAMES];
+	volatile uint32_t errors;
+};
+
+struct NameThread {
+	SharedNames *shared;
+	int index;
+};
+
+static void _name_thread(void *p_userdata) {
+
+	NameThread *nt = (NameThread *)p_userdata;
+	SharedNames *shared = nt->shared;
+	StringName *own = memnew_arr(StringName, OWN_LIVE_NAMES);
+	uint32_t seed = nt->index * 7919 + 1;
+
+	for (int i = 0; i < NAME_ITERATIONS; i++) {
+
+		// Keep adding names of this thread's own and dropping the oldest ones,
+		// so the table grows and fills with tombstones while others look up.
+		String own_name = "thread_" + itos(nt->index) + "_" + itos(i);
+		StringName &slot = own[i % OWN_LIVE_NAMES];
+		slot = StringName(own_name);
+		if (StringName::search(own_name) != slot) {
+			atomic_increment(&shared->errors);
+		}
+
+		// The first names are held for the whole test, the others are
+		// interned and dropped by all threads at the same time.
+		seed = seed * 1103515245 + 12345;
+		int k = (seed >> 8) % SHARED_NAMES;
+		const String &name = shared->names[k];
+		StringName a(name);
+		StringName b(name.utf8().get_data());
+		StringName c = StringName::search(name);
+		if (a.data_unique_pointer() != b.data_unique_pointer() || a != c || a != name || (k < HELD_NAMES && a != shared->held[k])) {
+			atomic_increment(&shared->errors);
+		}
+	}
+
+	memdelete_arr(own);
+}
+
+static bool test_threaded() {
+
+	OS::get_singleton()->print("\n\nTest 2: Interning, looking up and dropping while the table grows\n");
+
+	SharedNames *shared = memnew(SharedNames);
+	shared->errors = 0;
+	for (int i = 0; i < SHARED_NAMES; i++) {
+		shared->names[i] = "shared_name_" + itos(i);
+	}
+	for (int i = 0; i < HELD_NAMES; i++) {
+		shared->held[i] = StringName(shared->names[i]);
+	}
+
+	uint32_t size = StringName::get_table_size();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	NameThread nt[NAME_THREADS];
+	Thread *threads[NAME_THREADS];
+	for (int i = 0; i < NAME_THREADS; i++) {
+		nt[i].shared = shared;
+		nt[i].index = i;
+		threads[i] = Thread::create(_name_thread, &nt[i]);
+	}
+	for (int i = 0; i < NAME_THREADS; i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+	OS::get_singleton()->print("\t%d names in %d ms, table grew from %d to %d slots\n", NAME_THREADS * NAME_ITERATIONS, int((end - begin) / 1000), size, StringName::get_table_size());
+
+	bool pass = true;
+	if (shared->errors) {
+		OS::get_singleton()->print("\t%d names resolved to different data\n", shared->errors);
+		pass = false;
+	}
+	if (StringName::get_table_size() <= size) {
+		OS::get_singleton()->print("\ttable never grew\n");
+		pass = false;
+	}
+	if (StringName::search("thread_0_0") != StringName() || StringName::search(shared->names[HELD_NAMES]) != StringName()) {
+		OS::get_singleton()->print("\tdropped names can still be found\n");
+		pass = false;
+	}
+	for (int i = 0; i < HELD_NAMES; i++) {
+		if (StringName::search(shared->names[i]) != shared->held[i]) {
+			OS::get_singleton()->print("\theld name %d was lost\n", i);
+			pass = false;
+			break;
+		}
+	}
+
+	memdelete(shared);
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_tombstones,
+	test_threaded,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+
+} // namespace TestStringName
@@ -37,7 +37,8 @@ extern "C" {
 
 #include <stdint.h>
 
-#define GODOT_RID_SIZE sizeof(void *)
+// RIDs are 64 bit slot handles on every platform since core API 1.3.
+#define GODOT_RID_SIZE sizeof(uint64_t)
 
 #ifndef GODOT_CORE_API_GODOT_RID_TYPE_DEFINED
 #define GODOT_CORE_API_GODOT_RID_TYPE_DEFINED
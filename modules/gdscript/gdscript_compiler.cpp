@@ -74,6 +74,197 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+static bool _is_typed_builtin(const GDScriptParser::DataType &p_type, Variant::Type p_builtin) {
+
+	return p_type.has_type && !p_type.is_meta_type && p_type.kind == GDScriptParser::DataType::BUILTIN && p_type.builtin_type == p_builtin;
+}
+
+static bool _is_typed_number(const GDScriptParser::DataType &p_type) {
+
+	return _is_typed_builtin(p_type, Variant::INT) || _is_typed_builtin(p_type, Variant::REAL);
+}
+
+// Picks one of the typed operator opcodes when the operand types are known and the VM has a fast path for them.
+// Type hints are not enforced in release builds, so the VM still checks the operands and falls back to
+// OPCODE_OPERATOR when needed.
+static GDScriptFunction::Opcode _get_operator_opcode(Variant::Operator p_op, const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) {
+
+	switch (p_op) {
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_ADD:
+		case Variant::OP_SUBTRACT:
+		case Variant::OP_MULTIPLY:
+		case Variant::OP_DIVIDE:
+		case Variant::OP_NEGATE:
+		case Variant::OP_POSITIVE: {
+
+			if (_is_typed_builtin(p_a, Variant::INT) && _is_typed_builtin(p_b, Variant::INT)) {
+				return GDScriptFunction::OPCODE_OPERATOR_INT;
+			}
+			if (_is_typed_number(p_a) && _is_typed_number(p_b)) {
+				return GDScriptFunction::OPCODE_OPERATOR_REAL;
+			}
+
+			static const Variant::Type vector_types[2] = { Variant::VECTOR2, Variant::VECTOR3 };
+			static const GDScriptFunction::Opcode vector_opcodes[2] = { GDScriptFunction::OPCODE_OPERATOR_VECTOR2, GDScriptFunction::OPCODE_OPERATOR_VECTOR3 };
+			for (int i = 0; i < 2; i++) {
+				if (_is_typed_builtin(p_a, vector_types[i]) && _is_typed_builtin(p_b, vector_types[i])) {
+					return vector_opcodes[i];
+				}
+				if ((p_op == Variant::OP_MULTIPLY || p_op == Variant::OP_DIVIDE) && _is_typed_builtin(p_a, vector_types[i]) && _is_typed_number(p_b)) {
+					return vector_opcodes[i];
+				}
+				if (p_op == Variant::OP_MULTIPLY && _is_typed_number(p_a) && _is_typed_builtin(p_b, vector_types[i])) {
+					return vector_opcodes[i];
+				}
+			}
+		} break;
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL: {
+
+			if (_is_typed_builtin(p_a, Variant::INT) && _is_typed_builtin(p_b, Variant::INT)) {
+				return GDScriptFunction::OPCODE_OPERATOR_INT;
+			}
+			if (_is_typed_number(p_a) && _is_typed_number(p_b)) {
+				return GDScriptFunction::OPCODE_OPERATOR_REAL;
+			}
+		} break;
+		case Variant::OP_MODULE:
+		case Variant::OP_BIT_AND:
+		case Variant::OP_BIT_OR:
+		case Variant::OP_BIT_XOR:
+		case Variant::OP_BIT_NEGATE: {
+
+			if (_is_typed_builtin(p_a, Variant::INT) && _is_typed_builtin(p_b, Variant::INT)) {
+				return GDScriptFunction::OPCODE_OPERATOR_INT;
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return GDScriptFunction::OPCODE_OPERATOR;
+}
+
+static bool _get_comparison_operator(GDScriptParser::OperatorNode::Operator p_op, Variant::Operator &r_op) {
+
+	switch (p_op) {
+		case GDScriptParser::OperatorNode::OP_EQUAL: r_op = Variant::OP_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_NOT_EQUAL: r_op = Variant::OP_NOT_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_LESS: r_op = Variant::OP_LESS; break;
+		case GDScriptParser::OperatorNode::OP_LESS_EQUAL: r_op = Variant::OP_LESS_EQUAL; break;
+		case GDScriptParser::OperatorNode::OP_GREATER: r_op = Variant::OP_GREATER; break;
+		case GDScriptParser::OperatorNode::OP_GREATER_EQUAL: r_op = Variant::OP_GREATER_EQUAL; break;
+		default: return false;
+	}
+
+	return true;
+}
+
+// Returns false for anything that is not an assignment, r_op is OP_MAX for plain assignments.
+static bool _get_assign_operator(GDScriptParser::OperatorNode::Operator p_op, Variant::Operator &r_op) {
+
+	switch (p_op) {
+		case GDScriptParser::OperatorNode::OP_ASSIGN_ADD: r_op = Variant::OP_ADD; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_SUB: r_op = Variant::OP_SUBTRACT; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_MUL: r_op = Variant::OP_MULTIPLY; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_DIV: r_op = Variant::OP_DIVIDE; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_MOD: r_op = Variant::OP_MODULE; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_SHIFT_LEFT: r_op = Variant::OP_SHIFT_LEFT; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_SHIFT_RIGHT: r_op = Variant::OP_SHIFT_RIGHT; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_AND: r_op = Variant::OP_BIT_AND; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_OR: r_op = Variant::OP_BIT_OR; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_XOR: r_op = Variant::OP_BIT_XOR; break;
+		case GDScriptParser::OperatorNode::OP_INIT_ASSIGN:
+		case GDScriptParser::OperatorNode::OP_ASSIGN: r_op = Variant::OP_MAX; break;
+		default: return false;
+	}
+
+	return true;
+}
+
+// Expressions made only of constants, local variables and plain operators can't have side effects,
+// so the compiler is free to change when they are evaluated. Any other identifier may be a member
+// read through a setget getter or _get(), which can run code.
+static bool _is_pure_expression(const GDScriptParser::Node *p_expression, const Map<StringName, int> &p_locals) {
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::TYPE_CONSTANT:
+		case GDScriptParser::Node::TYPE_SELF: {
+
+			return true;
+		} break;
+		case GDScriptParser::Node::TYPE_IDENTIFIER: {
+
+			return p_locals.has(static_cast<const GDScriptParser::IdentifierNode *>(p_expression)->name);
+		} break;
+		case GDScriptParser::Node::TYPE_OPERATOR: {
+
+			const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(p_expression);
+			switch (on->op) {
+				case GDScriptParser::OperatorNode::OP_NEG:
+				case GDScriptParser::OperatorNode::OP_POS:
+				case GDScriptParser::OperatorNode::OP_NOT:
+				case GDScriptParser::OperatorNode::OP_BIT_INVERT:
+				case GDScriptParser::OperatorNode::OP_EQUAL:
+				case GDScriptParser::OperatorNode::OP_NOT_EQUAL:
+				case GDScriptParser::OperatorNode::OP_LESS:
+				case GDScriptParser::OperatorNode::OP_LESS_EQUAL:
+				case GDScriptParser::OperatorNode::OP_GREATER:
+				case GDScriptParser::OperatorNode::OP_GREATER_EQUAL:
+				case GDScriptParser::OperatorNode::OP_AND:
+				case GDScriptParser::OperatorNode::OP_OR:
+				case GDScriptParser::OperatorNode::OP_ADD:
+				case GDScriptParser::OperatorNode::OP_SUB:
+				case GDScriptParser::OperatorNode::OP_MUL:
+				case GDScriptParser::OperatorNode::OP_DIV:
+				case GDScriptParser::OperatorNode::OP_MOD:
+				case GDScriptParser::OperatorNode::OP_SHIFT_LEFT:
+				case GDScriptParser::OperatorNode::OP_SHIFT_RIGHT:
+				case GDScriptParser::OperatorNode::OP_BIT_AND:
+				case GDScriptParser::OperatorNode::OP_BIT_OR:
+				case GDScriptParser::OperatorNode::OP_BIT_XOR: {
+
+					for (int i = 0; i < on->arguments.size(); i++) {
+						if (!_is_pure_expression(on->arguments[i], p_locals)) {
+							return false;
+						}
+					}
+					return true;
+				} break;
+				default: {
+				}
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return false;
+}
+
+// Returns the call when p_expression is range() with one to three arguments, NULL otherwise.
+static const GDScriptParser::OperatorNode *_get_range_call(const GDScriptParser::Node *p_expression) {
+
+	if (p_expression->type != GDScriptParser::Node::TYPE_OPERATOR) {
+		return NULL;
+	}
+
+	const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(p_expression);
+	if (on->op != GDScriptParser::OperatorNode::OP_CALL || on->arguments.size() < 2 || on->arguments.size() > 4) {
+		return NULL;
+	}
+
+	if (on->arguments[0]->type != GDScriptParser::Node::TYPE_BUILT_IN_FUNCTION || static_cast<const GDScriptParser::BuiltInFunctionNode *>(on->arguments[0])->function != GDScriptFunctions::GEN_RANGE) {
+		return NULL;
+	}
+
+	return on;
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -82,7 +273,8 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 	if (src_address_a < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	const GDScriptParser::DataType type_a = on->arguments[0]->get_datatype();
+	codegen.opcodes.push_back(_get_operator_opcode(op, type_a, type_a)); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
@@ -104,7 +296,7 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 	if (src_address_b < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	codegen.opcodes.push_back(_get_operator_opcode(op, on->arguments[0]->get_datatype(), on->arguments[1]->get_datatype())); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
@@ -175,27 +367,9 @@ int GDScriptCompiler::_parse_assign_right_expression(CodeGen &codegen, const GDS
 
 	Variant::Operator var_op = Variant::OP_MAX;
 
-	switch (p_expression->op) {
-
-		case GDScriptParser::OperatorNode::OP_ASSIGN_ADD: var_op = Variant::OP_ADD; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_SUB: var_op = Variant::OP_SUBTRACT; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_MUL: var_op = Variant::OP_MULTIPLY; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_DIV: var_op = Variant::OP_DIVIDE; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_MOD: var_op = Variant::OP_MODULE; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_SHIFT_LEFT: var_op = Variant::OP_SHIFT_LEFT; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_SHIFT_RIGHT: var_op = Variant::OP_SHIFT_RIGHT; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_AND: var_op = Variant::OP_BIT_AND; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_OR: var_op = Variant::OP_BIT_OR; break;
-		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_XOR: var_op = Variant::OP_BIT_XOR; break;
-		case GDScriptParser::OperatorNode::OP_INIT_ASSIGN:
-		case GDScriptParser::OperatorNode::OP_ASSIGN: {
+	if (!_get_assign_operator(p_expression->op, var_op)) {
 
-			//none
-		} break;
-		default: {
-
-			ERR_FAIL_V(-1);
-		}
+		ERR_FAIL_V(-1);
 	}
 
 	bool initializer = p_expression->op == GDScriptParser::OperatorNode::OP_INIT_ASSIGN;
@@ -214,6 +388,45 @@ int GDScriptCompiler::_parse_assign_right_expression(CodeGen &codegen, const GDS
 	return dst_addr;
 }
 
+int GDScriptCompiler::_parse_jump_if_not(CodeGen &codegen, const GDScriptParser::Node *p_condition, int p_stack_level) {
+
+	Variant::Operator op;
+
+	if (p_condition->type == GDScriptParser::Node::TYPE_OPERATOR && _get_comparison_operator(static_cast<const GDScriptParser::OperatorNode *>(p_condition)->op, op)) {
+
+		// compare and jump in a single instruction, the result of the comparison is not needed afterwards
+		const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(p_condition);
+		ERR_FAIL_COND_V(on->arguments.size() != 2, -1);
+
+		int src_address_a = _parse_expression(codegen, on->arguments[0], p_stack_level);
+		if (src_address_a < 0)
+			return -1;
+		if (src_address_a & GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS)
+			p_stack_level++; //uses stack for return, increase stack
+
+		int src_address_b = _parse_expression(codegen, on->arguments[1], p_stack_level);
+		if (src_address_b < 0)
+			return -1;
+
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR);
+		codegen.opcodes.push_back(op);
+		codegen.opcodes.push_back(src_address_a);
+		codegen.opcodes.push_back(src_address_b);
+	} else {
+
+		int ret = _parse_expression(codegen, p_condition, p_stack_level, false);
+		if (ret < 0)
+			return -1;
+
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		codegen.opcodes.push_back(ret);
+	}
+
+	int jump_addr = codegen.opcodes.size();
+	codegen.opcodes.push_back(0); //temporary, patched by the caller
+	return jump_addr;
+}
+
 int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::Node *p_expression, int p_stack_level, bool p_root, bool p_initializer) {
 
 	switch (p_expression->type) {
@@ -656,10 +869,48 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							arguments.push_back(ret);
 						}
 
-						codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						MethodBind *native_method = NULL;
+						const Variant::BuiltinMethod *variant_method = NULL;
+						if (instance->type != GDScriptParser::Node::TYPE_SELF) {
+
+							// calling a method of an engine class on an object whose type is known, the MethodBind
+							// can be looked up now instead of on every call
+							const GDScriptParser::DataType base_type = instance->get_datatype();
+							if (base_type.has_type && !base_type.is_meta_type && base_type.kind == GDScriptParser::DataType::BUILTIN && base_type.builtin_type != Variant::NIL && base_type.builtin_type != Variant::OBJECT) {
+
+								// same for methods of built-in types
+								variant_method = Variant::get_builtin_method(base_type.builtin_type, static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+							} else if (base_type.has_type && !base_type.is_meta_type && base_type.kind != GDScriptParser::DataType::BUILTIN && base_type.kind != GDScriptParser::DataType::UNRESOLVED) {
+
+								GDScriptDataType native_type = _gdtype_from_datatype(base_type);
+								if (native_type.has_type && native_type.native_type != StringName()) {
+									native_method = ClassDB::get_method(native_type.native_type, static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+								}
+								if (native_method) {
+									ClassDB::ClassInfo *ci = ClassDB::classes.getptr(native_method->get_instance_class());
+									if (native_method->is_vararg() || !ci || !ci->class_ptr) {
+										native_method = NULL;
+									}
+								}
+							}
+						}
+
+						if (native_method) {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL_NATIVE : GDScriptFunction::OPCODE_CALL_NATIVE_RETURN); // perform operator
+						} else if (variant_method) {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL_VARIANT : GDScriptFunction::OPCODE_CALL_VARIANT_RETURN); // perform operator
+						} else {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						}
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++)
+						for (int i = 0; i < 2; i++)
+							codegen.opcodes.push_back(arguments[i]);
+						if (native_method)
+							codegen.opcodes.push_back(codegen.get_native_method_pos(native_method));
+						else if (variant_method)
+							codegen.opcodes.push_back(codegen.get_variant_method_pos(instance->get_datatype().builtin_type, variant_method));
+						for (int i = 2; i < arguments.size(); i++)
 							codegen.opcodes.push_back(arguments[i]);
 					}
 				} break;
@@ -704,6 +955,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						return from;
 
 					int index;
+					StringName index_name;
 					if (named) {
 						if (on->arguments[0]->type == GDScriptParser::Node::TYPE_SELF && codegen.script && codegen.function_node && !codegen.function_node->_static) {
 
@@ -724,14 +976,15 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							}
 						}
 
-						index = codegen.get_name_map_pos(static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+						index_name = static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name;
+						index = codegen.get_name_map_pos(index_name);
 
 					} else {
 
 						if (on->arguments[1]->type == GDScriptParser::Node::TYPE_CONSTANT && static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value.get_type() == Variant::STRING) {
 							//also, somehow, named (speed up anyway)
-							StringName name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
-							index = codegen.get_name_map_pos(name);
+							index_name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
+							index = codegen.get_name_map_pos(index_name);
 							named = true;
 
 						} else {
@@ -747,6 +1000,32 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						}
 					}
 
+					if (named && on->arguments[0]->type != GDScriptParser::Node::TYPE_SELF) {
+
+						// reading a member of an object whose script is known, the slot can be read directly
+						const GDScriptParser::DataType base_type = on->arguments[0]->get_datatype();
+						if (base_type.has_type && !base_type.is_meta_type && (base_type.kind == GDScriptParser::DataType::GDSCRIPT || base_type.kind == GDScriptParser::DataType::CLASS)) {
+
+							GDScriptDataType script_type = _gdtype_from_datatype(base_type);
+							GDScript *member_script = Object::cast_to<GDScript>(script_type.script_type.ptr());
+							const Map<StringName, GDScript::MemberInfo>::Element *MI = member_script ? member_script->member_indices.find(index_name) : NULL;
+
+							if (MI && MI->get().getter == StringName()) {
+
+								Variant script = script_type.script_type;
+								int idx = codegen.get_constant_pos(script);
+								idx |= GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS; //make it a local constant (faster access)
+
+								codegen.opcodes.push_back(GDScriptFunction::OPCODE_GET_NAMED_SCRIPT_MEMBER); // perform operator
+								codegen.opcodes.push_back(from); // argument 1
+								codegen.opcodes.push_back(index); // argument 2, used if the object turns out to have another script
+								codegen.opcodes.push_back(idx); // script the member belongs to
+								codegen.opcodes.push_back(MI->get().index); // member slot
+								break;
+							}
+						}
+					}
+
 					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
@@ -1111,13 +1390,29 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						//assignment to member property
 
 						int slevel = p_stack_level;
+						StringName name = static_cast<GDScriptParser::IdentifierNode *>(on->arguments[0])->name;
+
+						Variant::Operator var_op = Variant::OP_MAX;
+						_get_assign_operator(on->op, var_op);
+
+						if (var_op != Variant::OP_MAX && _is_pure_expression(on->arguments[1], codegen.stack_identifiers)) {
+							// the right side can't touch the property, so it can be evaluated before the property is read
+							int src_address = _parse_expression(codegen, on->arguments[1], slevel);
+							if (src_address < 0)
+								return -1;
+
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR_MEMBER);
+							codegen.opcodes.push_back(var_op);
+							codegen.opcodes.push_back(codegen.get_name_map_pos(name));
+							codegen.opcodes.push_back(src_address);
+
+							return GDScriptFunction::ADDR_TYPE_NIL << GDScriptFunction::ADDR_BITS;
+						}
 
 						int src_address = _parse_assign_right_expression(codegen, on, slevel);
 						if (src_address < 0)
 							return -1;
 
-						StringName name = static_cast<GDScriptParser::IdentifierNode *>(on->arguments[0])->name;
-
 						codegen.opcodes.push_back(GDScriptFunction::OPCODE_SET_MEMBER);
 						codegen.opcodes.push_back(codegen.get_name_map_pos(name));
 						codegen.opcodes.push_back(src_address);
@@ -1359,15 +1654,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 
 					case GDScriptParser::ControlFlowNode::CF_IF: {
 
-						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
-						if (ret2 < 0)
+						int else_addr = _parse_jump_if_not(codegen, cf->arguments[0], p_stack_level);
+						if (else_addr < 0)
 							return ERR_PARSE_ERROR;
 
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret2);
-						int else_addr = codegen.opcodes.size();
-						codegen.opcodes.push_back(0); //temporary
-
 						Error err = _parse_block(codegen, cf->body, p_stack_level, p_break_addr, p_continue_addr);
 						if (err)
 							return err;
@@ -1397,39 +1687,93 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 						int iterator_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 						int counter_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 						int container_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+						const GDScriptParser::OperatorNode *range_call = _get_range_call(cf->arguments[1]);
+						int step_pos = range_call ? (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS) : 0;
 						codegen.alloc_stack(slevel);
 
 						codegen.push_stack_identifiers();
 						codegen.add_stack_identifier(static_cast<const GDScriptParser::IdentifierNode *>(cf->arguments[0])->name, iter_stack_pos);
 
-						int ret2 = _parse_expression(codegen, cf->arguments[1], slevel, false);
-						if (ret2 < 0)
-							return ERR_COMPILATION_FAILED;
+						int break_pos;
+						int continue_pos;
 
-						//assign container
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_ASSIGN);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(ret2);
+						if (range_call) {
+
+							// count through the range instead of calling range(), container_pos holds the end
+							int argc = range_call->arguments.size() - 1;
+							int arguments[3];
+							int arg_level = slevel;
+							for (int i = 0; i < argc; i++) {
+
+								arguments[i] = _parse_expression(codegen, range_call->arguments[i + 1], arg_level);
+								if (arguments[i] < 0)
+									return ERR_COMPILATION_FAILED;
+
+								if ((arguments[i] >> GDScriptFunction::ADDR_BITS & GDScriptFunction::ADDR_TYPE_STACK) == GDScriptFunction::ADDR_TYPE_STACK) {
+									arg_level++;
+									codegen.alloc_stack(arg_level);
+								}
+							}
+
+							//begin loop
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(step_pos);
+							codegen.opcodes.push_back(codegen.opcodes.size() + 8);
+							codegen.opcodes.push_back(iterator_pos);
+							codegen.opcodes.push_back(argc);
+							for (int i = 0; i < 3; i++) {
+								codegen.opcodes.push_back(arguments[i < argc ? i : 0]);
+							}
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(codegen.opcodes.size() + 9);
+							//break loop
+							break_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(0); //skip code for next
+							//next loop
+							continue_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_RANGE);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(step_pos);
+							codegen.opcodes.push_back(break_pos);
+							codegen.opcodes.push_back(iterator_pos);
+
+						} else {
+
+							int ret2 = _parse_expression(codegen, cf->arguments[1], slevel, false);
+							if (ret2 < 0)
+								return ERR_COMPILATION_FAILED;
+
+							//assign container
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ASSIGN);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(ret2);
 
-						//begin loop
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_BEGIN);
-						codegen.opcodes.push_back(counter_pos);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(codegen.opcodes.size() + 4);
-						codegen.opcodes.push_back(iterator_pos);
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
-						codegen.opcodes.push_back(codegen.opcodes.size() + 8);
-						//break loop
-						int break_pos = codegen.opcodes.size();
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
-						codegen.opcodes.push_back(0); //skip code for next
-						//next loop
-						int continue_pos = codegen.opcodes.size();
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE);
-						codegen.opcodes.push_back(counter_pos);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(break_pos);
-						codegen.opcodes.push_back(iterator_pos);
+							bool iterate_number = _is_typed_number(cf->arguments[1]->get_datatype());
+
+							//begin loop
+							codegen.opcodes.push_back(iterate_number ? GDScriptFunction::OPCODE_ITERATE_BEGIN_INT : GDScriptFunction::OPCODE_ITERATE_BEGIN);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(codegen.opcodes.size() + 4);
+							codegen.opcodes.push_back(iterator_pos);
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(codegen.opcodes.size() + 8);
+							//break loop
+							break_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(0); //skip code for next
+							//next loop
+							continue_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(iterate_number ? GDScriptFunction::OPCODE_ITERATE_INT : GDScriptFunction::OPCODE_ITERATE);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(break_pos);
+							codegen.opcodes.push_back(iterator_pos);
+						}
 
 						Error err = _parse_block(codegen, cf->body, slevel, break_pos, continue_pos);
 						if (err)
@@ -1451,12 +1795,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 						codegen.opcodes.push_back(0);
 						int continue_addr = codegen.opcodes.size();
 
-						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
-						if (ret2 < 0)
+						int jump_addr = _parse_jump_if_not(codegen, cf->arguments[0], p_stack_level);
+						if (jump_addr < 0)
 							return ERR_PARSE_ERROR;
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret2);
-						codegen.opcodes.push_back(break_addr);
+						codegen.opcodes.write[jump_addr] = break_addr;
 						Error err = _parse_block(codegen, cf->body, p_stack_level, break_addr, continue_addr);
 						if (err)
 							return err;
@@ -1718,10 +2060,57 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 			gdfunc->global_names.write[E->get()] = E->key();
 		}
 		gdfunc->_global_names_count = gdfunc->global_names.size();
+		gdfunc->name_caches.resize(gdfunc->global_names.size());
+		gdfunc->_name_caches_ptr = gdfunc->name_caches.ptrw();
 
 	} else {
 		gdfunc->_global_names_ptr = NULL;
 		gdfunc->_global_names_count = 0;
+		gdfunc->_name_caches_ptr = NULL;
+	}
+
+	//native methods
+	if (codegen.native_method_map.size()) {
+
+		gdfunc->native_methods.resize(codegen.native_method_map.size());
+		for (Map<MethodBind *, int>::Element *E = codegen.native_method_map.front(); E; E = E->next()) {
+
+			MethodBind *method = E->key();
+			GDScriptFunction::NativeMethod native;
+			native.method = method;
+			native.class_ptr = ClassDB::classes.getptr(method->get_instance_class())->class_ptr;
+			native.ptrcall = false;
+			native.ret_enum = false;
+#if defined(PTRCALL_ENABLED) && defined(DEBUG_METHODS_ENABLED)
+			// objects can't be passed as raw pointers, they need the Variant conversions
+			native.ptrcall = !method->has_return() || method->get_argument_type(-1) != Variant::OBJECT;
+			native.ret_enum = method->has_return() && (method->get_return_info().usage & PROPERTY_USAGE_CLASS_IS_ENUM);
+			for (int i = 0; i < method->get_argument_count(); i++) {
+				if (method->get_argument_type(i) == Variant::OBJECT) {
+					native.ptrcall = false;
+				}
+			}
+#endif
+			gdfunc->native_methods.write[E->get()] = native;
+		}
+		gdfunc->_native_methods_ptr = gdfunc->native_methods.ptr();
+		gdfunc->_native_methods_count = gdfunc->native_methods.size();
+
+	} else {
+		gdfunc->_native_methods_ptr = NULL;
+		gdfunc->_native_methods_count = 0;
+	}
+
+	//methods of built-in types
+	if (codegen.variant_methods.size()) {
+
+		gdfunc->variant_methods = codegen.variant_methods;
+		gdfunc->_variant_methods_ptr = gdfunc->variant_methods.ptr();
+		gdfunc->_variant_methods_count = gdfunc->variant_methods.size();
+
+	} else {
+		gdfunc->_variant_methods_ptr = NULL;
+		gdfunc->_variant_methods_count = 0;
 	}
 
 #ifdef TOOLS_ENABLED
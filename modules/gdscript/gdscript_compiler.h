@@ -98,6 +98,8 @@ class GDScriptCompiler {
 
 		HashMap<Variant, int, VariantHasher, VariantComparator> constant_map;
 		Map<StringName, int> name_map;
+		Map<MethodBind *, int> native_method_map;
+		Vector<GDScriptFunction::VariantMethod> variant_methods;
 #ifdef TOOLS_ENABLED
 		Vector<StringName> named_globals;
 #endif
@@ -113,6 +115,29 @@ class GDScriptCompiler {
 			return ret;
 		}
 
+		int get_native_method_pos(MethodBind *p_method) {
+			int ret;
+			if (!native_method_map.has(p_method)) {
+				ret = native_method_map.size();
+				native_method_map[p_method] = ret;
+			} else {
+				ret = native_method_map[p_method];
+			}
+			return ret;
+		}
+
+		int get_variant_method_pos(Variant::Type p_type, const Variant::BuiltinMethod *p_method) {
+			for (int i = 0; i < variant_methods.size(); i++) {
+				if (variant_methods[i].method == p_method)
+					return i;
+			}
+			GDScriptFunction::VariantMethod vm;
+			vm.method = p_method;
+			vm.type = p_type;
+			variant_methods.push_back(vm);
+			return variant_methods.size() - 1;
+		}
+
 		int get_constant_pos(const Variant &p_constant) {
 			if (constant_map.has(p_constant))
 				return constant_map[p_constant];
@@ -146,6 +171,7 @@ class GDScriptCompiler {
 
 	int _parse_assign_right_expression(CodeGen &codegen, const GDScriptParser::OperatorNode *p_expression, int p_stack_level);
 	int _parse_expression(CodeGen &codegen, const GDScriptParser::Node *p_expression, int p_stack_level, bool p_root = false, bool p_initializer = false);
+	int _parse_jump_if_not(CodeGen &codegen, const GDScriptParser::Node *p_condition, int p_stack_level);
 	Error _parse_block(CodeGen &codegen, const GDScriptParser::BlockNode *p_block, int p_stack_level = 0, int p_break_addr = -1, int p_continue_addr = -1);
 	Error _parse_function(GDScript *p_script, const GDScriptParser::ClassNode *p_class, const GDScriptParser::FunctionNode *p_func, bool p_for_ready = false);
 	Error _parse_class_level(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
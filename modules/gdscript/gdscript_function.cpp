@@ -31,6 +31,7 @@
 #include "gdscript_function.h"
 
 #include "core/os/os.h"
+#include "core/variant_internal.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
 
@@ -189,18 +190,244 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 	return err_text;
 }
 
-#if defined(__GNUC__)
+// The object held by p_variant when it can be used directly, NULL for anything (including null or freed
+// instances) that has to go through the Variant methods.
+static _FORCE_INLINE_ Object *_get_object_for_access(const Variant *p_variant) {
+
+	if (p_variant->get_type() != Variant::OBJECT)
+		return NULL;
+
+	Object *obj = VariantInternal::get_object(p_variant);
+#ifdef DEBUG_ENABLED
+	if (obj && ScriptDebugger::get_singleton() && !VariantInternal::is_object_ref(p_variant) && !ObjectDB::instance_validate(obj)) {
+		return NULL;
+	}
+#endif
+	return obj;
+}
+
+// Fast paths for the typed operator opcodes. They return false when the operands are not of the expected
+// types (hints are not enforced in release builds) or when Variant::evaluate() would report an error,
+// in which case the generic OPCODE_OPERATOR path must be taken.
+
+static _FORCE_INLINE_ void _set_bool(Variant *r_dst, bool p_value) {
+	VariantInternal::initialize(r_dst, Variant::BOOL);
+	*VariantInternal::get_bool(r_dst) = p_value;
+}
+
+static _FORCE_INLINE_ void _set_int(Variant *r_dst, int64_t p_value) {
+	VariantInternal::initialize(r_dst, Variant::INT);
+	*VariantInternal::get_int(r_dst) = p_value;
+}
+
+static _FORCE_INLINE_ void _set_real(Variant *r_dst, double p_value) {
+	VariantInternal::initialize(r_dst, Variant::REAL);
+	*VariantInternal::get_real(r_dst) = p_value;
+}
+
+static _FORCE_INLINE_ bool _evaluate_int(Variant::Operator p_op, const Variant *p_a, const Variant *p_b, Variant *r_dst) {
+
+	if (unlikely(p_a->get_type() != Variant::INT || p_b->get_type() != Variant::INT)) {
+		return false;
+	}
+
+	// read both before writing, dst may be one of the operands
+	int64_t a = *VariantInternal::get_int(p_a);
+	int64_t b = *VariantInternal::get_int(p_b);
+
+	switch (p_op) {
+		case Variant::OP_EQUAL: _set_bool(r_dst, a == b); break;
+		case Variant::OP_NOT_EQUAL: _set_bool(r_dst, a != b); break;
+		case Variant::OP_LESS: _set_bool(r_dst, a < b); break;
+		case Variant::OP_LESS_EQUAL: _set_bool(r_dst, a <= b); break;
+		case Variant::OP_GREATER: _set_bool(r_dst, a > b); break;
+		case Variant::OP_GREATER_EQUAL: _set_bool(r_dst, a >= b); break;
+		case Variant::OP_ADD: _set_int(r_dst, a + b); break;
+		case Variant::OP_SUBTRACT: _set_int(r_dst, a - b); break;
+		case Variant::OP_MULTIPLY: _set_int(r_dst, a * b); break;
+		case Variant::OP_DIVIDE: {
+			if (b == 0) {
+				return false;
+			}
+			_set_int(r_dst, a / b);
+		} break;
+		case Variant::OP_MODULE: {
+			if (b == 0) {
+				return false;
+			}
+			_set_int(r_dst, a % b);
+		} break;
+		case Variant::OP_NEGATE: _set_int(r_dst, -a); break;
+		case Variant::OP_POSITIVE: _set_int(r_dst, a); break;
+		case Variant::OP_BIT_AND: _set_int(r_dst, a & b); break;
+		case Variant::OP_BIT_OR: _set_int(r_dst, a | b); break;
+		case Variant::OP_BIT_XOR: _set_int(r_dst, a ^ b); break;
+		case Variant::OP_BIT_NEGATE: _set_int(r_dst, ~a); break;
+		default: return false;
+	}
+
+	return true;
+}
+
+static _FORCE_INLINE_ bool _evaluate_real(Variant::Operator p_op, const Variant *p_a, const Variant *p_b, Variant *r_dst) {
+
+	Variant::Type type_a = p_a->get_type();
+	Variant::Type type_b = p_b->get_type();
+
+	// mixed int and real operands are fine, but two ints must keep integer semantics
+	if (unlikely((type_a != Variant::REAL && type_a != Variant::INT) || (type_b != Variant::REAL && type_b != Variant::INT) || (type_a == Variant::INT && type_b == Variant::INT))) {
+		return false;
+	}
+
+	double a = VariantInternal::get_number(p_a);
+	double b = VariantInternal::get_number(p_b);
+
+	switch (p_op) {
+		case Variant::OP_EQUAL: _set_bool(r_dst, a == b); break;
+		case Variant::OP_NOT_EQUAL: _set_bool(r_dst, a != b); break;
+		case Variant::OP_LESS: _set_bool(r_dst, a < b); break;
+		case Variant::OP_LESS_EQUAL: _set_bool(r_dst, a <= b); break;
+		case Variant::OP_GREATER: _set_bool(r_dst, a > b); break;
+		case Variant::OP_GREATER_EQUAL: _set_bool(r_dst, a >= b); break;
+		case Variant::OP_ADD: _set_real(r_dst, a + b); break;
+		case Variant::OP_SUBTRACT: _set_real(r_dst, a - b); break;
+		case Variant::OP_MULTIPLY: _set_real(r_dst, a * b); break;
+		case Variant::OP_DIVIDE: {
+			if (b == 0) {
+				return false;
+			}
+			_set_real(r_dst, a / b);
+		} break;
+		case Variant::OP_NEGATE: _set_real(r_dst, -a); break;
+		case Variant::OP_POSITIVE: _set_real(r_dst, a); break;
+		default: return false;
+	}
+
+	return true;
+}
+
+template <class T, Variant::Type TYPE>
+static _FORCE_INLINE_ bool _evaluate_vector(Variant::Operator p_op, const Variant *p_a, const Variant *p_b, Variant *r_dst) {
+
+	Variant::Type type_a = p_a->get_type();
+	Variant::Type type_b = p_b->get_type();
+
+	if (type_a == TYPE && type_b == TYPE) {
+
+		T a = *VariantInternal::get_value<T>(p_a);
+		T b = *VariantInternal::get_value<T>(p_b);
+
+		switch (p_op) {
+			case Variant::OP_EQUAL: _set_bool(r_dst, a == b); return true;
+			case Variant::OP_NOT_EQUAL: _set_bool(r_dst, a != b); return true;
+			case Variant::OP_ADD: a = a + b; break;
+			case Variant::OP_SUBTRACT: a = a - b; break;
+			case Variant::OP_MULTIPLY: a = a * b; break;
+			case Variant::OP_DIVIDE: a = a / b; break;
+			case Variant::OP_NEGATE: a = -a; break;
+			case Variant::OP_POSITIVE: break;
+			default: return false;
+		}
+
+		VariantInternal::initialize(r_dst, TYPE);
+		*VariantInternal::get_value<T>(r_dst) = a;
+		return true;
+	}
+
+	if (type_a == TYPE && (type_b == Variant::INT || type_b == Variant::REAL)) {
+
+		T a = *VariantInternal::get_value<T>(p_a);
+		real_t b = VariantInternal::get_number(p_b);
+
+		switch (p_op) {
+			case Variant::OP_MULTIPLY: a = a * b; break;
+			case Variant::OP_DIVIDE: a = a / b; break;
+			default: return false;
+		}
+
+		VariantInternal::initialize(r_dst, TYPE);
+		*VariantInternal::get_value<T>(r_dst) = a;
+		return true;
+	}
+
+	if ((type_a == Variant::INT || type_a == Variant::REAL) && type_b == TYPE && p_op == Variant::OP_MULTIPLY) {
+
+		T b = *VariantInternal::get_value<T>(p_b);
+		real_t a = VariantInternal::get_number(p_a);
+
+		VariantInternal::initialize(r_dst, TYPE);
+		*VariantInternal::get_value<T>(r_dst) = a * b;
+		return true;
+	}
+
+	return false;
+}
+
+template <class T>
+static _FORCE_INLINE_ bool _compare(Variant::Operator p_op, T p_a, T p_b, bool &r_result) {
+
+	switch (p_op) {
+		case Variant::OP_EQUAL: r_result = p_a == p_b; break;
+		case Variant::OP_NOT_EQUAL: r_result = p_a != p_b; break;
+		case Variant::OP_LESS: r_result = p_a < p_b; break;
+		case Variant::OP_LESS_EQUAL: r_result = p_a <= p_b; break;
+		case Variant::OP_GREATER: r_result = p_a > p_b; break;
+		case Variant::OP_GREATER_EQUAL: r_result = p_a >= p_b; break;
+		default: return false;
+	}
+
+	return true;
+}
+
+// Fast path for OPCODE_JUMP_IF_NOT_OPERATOR, int and real operands are compared the same way Variant::evaluate() does.
+static _FORCE_INLINE_ bool _compare_numbers(Variant::Operator p_op, const Variant *p_a, const Variant *p_b, bool &r_result) {
+
+	Variant::Type type_a = p_a->get_type();
+	Variant::Type type_b = p_b->get_type();
+
+	if (type_a == Variant::INT && type_b == Variant::INT) {
+		return _compare<int64_t>(p_op, *VariantInternal::get_int(p_a), *VariantInternal::get_int(p_b), r_result);
+	}
+
+	if ((type_a == Variant::INT || type_a == Variant::REAL) && (type_b == Variant::INT || type_b == Variant::REAL)) {
+		return _compare<double>(p_op, VariantInternal::get_number(p_a), VariantInternal::get_number(p_b), r_result);
+	}
+
+	return false;
+}
+
+// Loop conditions for OPCODE_ITERATE_*_INT and OPCODE_ITERATE_*_RANGE, matching Variant::iter_next() and range().
+
+static _FORCE_INLINE_ bool _is_in_number_range(const Variant *p_container, int64_t p_idx) {
+
+	return p_container->get_type() == Variant::INT ? p_idx < *VariantInternal::get_int(p_container) : p_idx < *VariantInternal::get_real(p_container);
+}
+
+static _FORCE_INLINE_ bool _is_in_range(int64_t p_idx, int64_t p_to, int64_t p_step) {
+
+	return p_step > 0 ? p_idx < p_to : (p_step < 0 && p_idx > p_to);
+}
+
+// Threaded dispatch is used with GCC and Clang, build with GDSCRIPT_NO_COMPUTED_GOTO defined
+// (e.g. through the CCFLAGS option) to use the portable switch() based loop instead.
+#if defined(__GNUC__) && !defined(GDSCRIPT_NO_COMPUTED_GOTO)
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR,                    \
+		&&OPCODE_OPERATOR_INT,                \
+		&&OPCODE_OPERATOR_REAL,               \
+		&&OPCODE_OPERATOR_VECTOR2,            \
+		&&OPCODE_OPERATOR_VECTOR3,            \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
 		&&OPCODE_GET,                         \
 		&&OPCODE_SET_NAMED,                   \
 		&&OPCODE_GET_NAMED,                   \
+		&&OPCODE_GET_NAMED_SCRIPT_MEMBER,     \
 		&&OPCODE_SET_MEMBER,                  \
 		&&OPCODE_GET_MEMBER,                  \
+		&&OPCODE_OPERATOR_MEMBER,             \
 		&&OPCODE_ASSIGN,                      \
 		&&OPCODE_ASSIGN_TRUE,                 \
 		&&OPCODE_ASSIGN_FALSE,                \
@@ -215,6 +442,10 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 		&&OPCODE_CONSTRUCT_DICTIONARY,        \
 		&&OPCODE_CALL,                        \
 		&&OPCODE_CALL_RETURN,                 \
+		&&OPCODE_CALL_NATIVE,                 \
+		&&OPCODE_CALL_NATIVE_RETURN,          \
+		&&OPCODE_CALL_VARIANT,                \
+		&&OPCODE_CALL_VARIANT_RETURN,         \
 		&&OPCODE_CALL_BUILT_IN,               \
 		&&OPCODE_CALL_SELF,                   \
 		&&OPCODE_CALL_SELF_BASE,              \
@@ -224,10 +455,15 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 		&&OPCODE_JUMP,                        \
 		&&OPCODE_JUMP_IF,                     \
 		&&OPCODE_JUMP_IF_NOT,                 \
+		&&OPCODE_JUMP_IF_NOT_OPERATOR,        \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,        \
 		&&OPCODE_RETURN,                      \
 		&&OPCODE_ITERATE_BEGIN,               \
 		&&OPCODE_ITERATE,                     \
+		&&OPCODE_ITERATE_BEGIN_INT,           \
+		&&OPCODE_ITERATE_INT,                 \
+		&&OPCODE_ITERATE_BEGIN_RANGE,         \
+		&&OPCODE_ITERATE_RANGE,               \
 		&&OPCODE_ASSERT,                      \
 		&&OPCODE_BREAKPOINT,                  \
 		&&OPCODE_LINE,                        \
@@ -443,6 +679,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		OPCODE_SWITCH(_code_ptr[ip]) {
 
 			OPCODE(OPCODE_OPERATOR) {
+			generic_operator: // typed operators end up here when they can't handle their operands
 
 				CHECK_SPACE(5);
 
@@ -479,6 +716,66 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_INT) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!_evaluate_int((Variant::Operator)_code_ptr[ip + 1], a, b, dst))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_REAL) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!_evaluate_real((Variant::Operator)_code_ptr[ip + 1], a, b, dst))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VECTOR2) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!(_evaluate_vector<Vector2, Variant::VECTOR2>((Variant::Operator)_code_ptr[ip + 1], a, b, dst)))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VECTOR3) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!(_evaluate_vector<Vector3, Variant::VECTOR3>((Variant::Operator)_code_ptr[ip + 1], a, b, dst)))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 
 				CHECK_SPACE(4);
@@ -630,7 +927,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
-				dst->set_named(*index, *value, &valid);
+				Object *obj = _get_object_for_access(dst);
+				if (obj) {
+					obj->set(*index, *value, &valid, &_name_caches_ptr[indexname].set);
+				} else {
+					dst->set_named(*index, *value, &valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -656,12 +958,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
+				Object *obj = _get_object_for_access(src);
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, &valid);
+				Variant ret = obj ? obj->get(*index, &valid, &_name_caches_ptr[indexname].get) : src->get_named(*index, &valid);
 
 #else
-				*dst = src->get_named(*index, &valid);
+				*dst = obj ? obj->get(*index, &valid, &_name_caches_ptr[indexname].get) : src->get_named(*index, &valid);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -678,6 +981,70 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_NAMED_SCRIPT_MEMBER) {
+
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(src, 1);
+				GET_VARIANT_PTR(type, 3);
+				GET_VARIANT_PTR(dst, 5);
+				int member_index = _code_ptr[ip + 4];
+
+				// the slot can only be read directly if the object runs the script the member belongs to
+				// (or one inheriting it), anything else goes through Object::get() like OPCODE_GET_NAMED
+				GDScriptInstance *instance = NULL;
+				if (src->get_type() == Variant::OBJECT) {
+					Object *obj = VariantInternal::get_object(src);
+#ifdef DEBUG_ENABLED
+					if (obj && ScriptDebugger::get_singleton() && !VariantInternal::is_object_ref(src) && !ObjectDB::instance_validate(obj)) {
+						obj = NULL;
+					}
+#endif
+					ScriptInstance *si = obj ? obj->get_script_instance() : NULL;
+					if (si && si->get_language() == GDScriptLanguage::get_singleton() && !si->is_placeholder()) {
+						GDScript *member_script = Object::cast_to<GDScript>(VariantInternal::get_object(type));
+						GDScript *scr = static_cast<GDScriptInstance *>(si)->script.ptr();
+						while (scr && scr != member_script) {
+							scr = scr->_base;
+						}
+						if (scr && member_index < static_cast<GDScriptInstance *>(si)->members.size()) {
+							instance = static_cast<GDScriptInstance *>(si);
+						}
+					}
+				}
+
+				if (likely(instance)) {
+					if (unlikely(dst == src)) {
+						// overwriting src may free the object holding the member
+						Variant value = instance->members[member_index];
+						*dst = value;
+					} else {
+						*dst = instance->members[member_index];
+					}
+					ip += 6;
+					DISPATCH_OPCODE;
+				}
+
+				int indexname = _code_ptr[ip + 2];
+
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+
+				bool valid;
+#ifdef DEBUG_ENABLED
+				Variant ret = src->get_named(*index, &valid);
+				if (!valid) {
+					err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+					OPCODE_BREAK;
+				}
+				*dst = ret;
+#else
+				*dst = src->get_named(*index, &valid);
+#endif
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_MEMBER) {
 
 				CHECK_SPACE(3);
@@ -724,6 +1091,60 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_MEMBER) {
+
+				CHECK_SPACE(4);
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				GD_ERR_BREAK(op >= Variant::OP_MAX);
+				int indexname = _code_ptr[ip + 2];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+				GET_VARIANT_PTR(src, 3);
+
+				Variant value;
+#ifndef DEBUG_ENABLED
+				ClassDB::get_property(p_instance->owner, *index, value);
+#else
+				bool ok = ClassDB::get_property(p_instance->owner, *index, value);
+				if (!ok) {
+					err_text = "Internal error getting property: " + String(*index);
+					OPCODE_BREAK;
+				}
+#endif
+
+				bool valid;
+				Variant ret;
+				Variant::evaluate(op, value, *src, ret, valid);
+#ifdef DEBUG_ENABLED
+				if (!valid) {
+
+					if (ret.get_type() == Variant::STRING) {
+						//return a string when invalid with the error
+						err_text = ret;
+						err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
+					} else {
+						err_text = "Invalid operands '" + Variant::get_type_name(value.get_type()) + "' and '" + Variant::get_type_name(src->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
+					}
+					OPCODE_BREAK;
+				}
+#endif
+
+#ifndef DEBUG_ENABLED
+				ClassDB::set_property(p_instance->owner, *index, ret, &valid);
+#else
+				ok = ClassDB::set_property(p_instance->owner, *index, ret, &valid);
+				if (!ok) {
+					err_text = "Internal error setting property: " + String(*index);
+					OPCODE_BREAK;
+				} else if (!valid) {
+					err_text = "Error setting property '" + String(*index) + "' with value of type " + Variant::get_type_name(ret.get_type()) + ".";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_ASSIGN) {
 
 				CHECK_SPACE(3);
@@ -1071,14 +1492,21 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 
 #endif
-				Variant::CallError err;
+				Variant *ret = NULL;
 				if (call_ret) {
+					GET_VARIANT_PTR(v, argc);
+					ret = v;
+				}
 
-					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+				Variant::CallError err;
+				Object *obj = _get_object_for_access(base);
+				if (obj) {
+					Variant result = obj->call(*methodname, (const Variant **)argptrs, argc, err, &_name_caches_ptr[nameg].method);
+					if (ret && err.error == Variant::CallError::CALL_OK) {
+						*ret = result;
+					}
 				} else {
-
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err);
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1121,6 +1549,203 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_NATIVE_RETURN)
+			OPCODE(OPCODE_CALL_NATIVE) {
+
+				CHECK_SPACE(5);
+				bool call_ret = _code_ptr[ip] == OPCODE_CALL_NATIVE_RETURN;
+
+				int argc = _code_ptr[ip + 1];
+				GET_VARIANT_PTR(base, 2);
+				int nameg = _code_ptr[ip + 3];
+				int native_idx = _code_ptr[ip + 4];
+
+				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
+				const StringName *methodname = &_global_names_ptr[nameg];
+				GD_ERR_BREAK(native_idx < 0 || native_idx >= _native_methods_count);
+				const NativeMethod *native = &_native_methods_ptr[native_idx];
+
+				GD_ERR_BREAK(argc < 0);
+				ip += 5;
+				CHECK_SPACE(argc + 1);
+				Variant **argptrs = call_args;
+
+				for (int i = 0; i < argc; i++) {
+					GET_VARIANT_PTR(v, i);
+					argptrs[i] = v;
+				}
+
+				Variant *ret = NULL;
+				if (call_ret) {
+					GET_VARIANT_PTR(v, argc);
+					ret = v;
+				}
+
+				// the MethodBind can only be called directly on objects of the class it was looked up in,
+				// and only if their script doesn't define a method with the same name (Object::call() gives
+				// scripts priority), anything else goes through Variant::call_ptr() like OPCODE_CALL
+				Object *obj = NULL;
+				if (base->get_type() == Variant::OBJECT) {
+					obj = VariantInternal::get_object(base);
+#ifdef DEBUG_ENABLED
+					if (obj && ScriptDebugger::get_singleton() && !VariantInternal::is_object_ref(base) && !ObjectDB::instance_validate(obj)) {
+						obj = NULL;
+					}
+#endif
+					if (obj && (!obj->is_class_ptr(native->class_ptr) || (obj->get_script_instance() && obj->get_script_instance()->has_method(*methodname)))) {
+						obj = NULL;
+					}
+				}
+
+#ifdef DEBUG_ENABLED
+				uint64_t call_time = 0;
+
+				if (GDScriptLanguage::get_singleton()->profiling) {
+					call_time = OS::get_singleton()->get_ticks_usec();
+				}
+
+#endif
+				Variant::CallError err;
+				if (likely(obj)) {
+
+					err.error = Variant::CallError::CALL_OK;
+					MethodBind *method = native->method;
+					bool use_ptrcall = false;
+#if defined(PTRCALL_ENABLED) && defined(DEBUG_METHODS_ENABLED)
+					bool ret_aliased = ret == base;
+					// ptrcall needs every argument to be stored as the exact type the method takes (or to be
+					// taken as a Variant), default arguments and conversions are left to MethodBind::call()
+					use_ptrcall = native->ptrcall && argc == method->get_argument_count();
+					for (int i = 0; use_ptrcall && i < argc; i++) {
+						Variant::Type arg_type = method->get_argument_type(i);
+						use_ptrcall = arg_type == Variant::NIL || arg_type == argptrs[i]->get_type();
+						ret_aliased = ret_aliased || ret == argptrs[i];
+					}
+
+					if (use_ptrcall) {
+						// the argument pointers are not needed anymore, so their storage is reused
+						const void **ptr_args = (const void **)argptrs;
+						for (int i = 0; i < argc; i++) {
+							Variant *arg = argptrs[i];
+							ptr_args[i] = method->get_argument_type(i) == Variant::NIL ? arg : VariantInternal::get_opaque_pointer(arg);
+						}
+
+						if (!method->has_return()) {
+							method->ptrcall(obj, ptr_args, NULL);
+							if (ret) {
+								*ret = Variant();
+							}
+						} else {
+							// writing the result in place would clobber arguments before the call reads them
+							Variant temp_ret;
+							Variant *r_ret = (ret && !ret_aliased) ? ret : &temp_ret;
+							Variant::Type ret_type = method->get_argument_type(-1);
+							if (ret_type == Variant::NIL) {
+								method->ptrcall(obj, ptr_args, r_ret);
+							} else if (native->ret_enum) {
+								// only the low 32 bits would be written into the int64 of the Variant
+								int enum_ret = 0;
+								method->ptrcall(obj, ptr_args, &enum_ret);
+								*r_ret = enum_ret;
+							} else {
+								VariantInternal::initialize(r_ret, ret_type);
+								method->ptrcall(obj, ptr_args, VariantInternal::get_opaque_pointer(r_ret));
+							}
+							if (ret && r_ret != ret) {
+								*ret = temp_ret;
+							}
+						}
+					}
+#endif
+					if (!use_ptrcall) {
+						Variant result = method->call(obj, (const Variant **)argptrs, argc, err);
+						if (ret && err.error == Variant::CallError::CALL_OK) {
+							*ret = result;
+						}
+					}
+				} else {
+
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+				}
+#ifdef DEBUG_ENABLED
+				if (GDScriptLanguage::get_singleton()->profiling) {
+					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
+				}
+
+				if (err.error != Variant::CallError::CALL_OK) {
+
+					err_text = _get_call_error(err, "function '" + String(*methodname) + "' in base '" + _get_var_type(base) + "'", (const Variant **)argptrs);
+					OPCODE_BREAK;
+				}
+#endif
+
+				ip += argc + 1;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_CALL_VARIANT_RETURN)
+			OPCODE(OPCODE_CALL_VARIANT) {
+
+				CHECK_SPACE(5);
+				bool call_ret = _code_ptr[ip] == OPCODE_CALL_VARIANT_RETURN;
+
+				int argc = _code_ptr[ip + 1];
+				GET_VARIANT_PTR(base, 2);
+				int nameg = _code_ptr[ip + 3];
+				int method_idx = _code_ptr[ip + 4];
+
+				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
+				const StringName *methodname = &_global_names_ptr[nameg];
+				GD_ERR_BREAK(method_idx < 0 || method_idx >= _variant_methods_count);
+				const VariantMethod *method = &_variant_methods_ptr[method_idx];
+
+				GD_ERR_BREAK(argc < 0);
+				ip += 5;
+				CHECK_SPACE(argc + 1);
+				Variant **argptrs = call_args;
+
+				for (int i = 0; i < argc; i++) {
+					GET_VARIANT_PTR(v, i);
+					argptrs[i] = v;
+				}
+
+				Variant *ret = NULL;
+				if (call_ret) {
+					GET_VARIANT_PTR(v, argc);
+					ret = v;
+				}
+
+#ifdef DEBUG_ENABLED
+				uint64_t call_time = 0;
+
+				if (GDScriptLanguage::get_singleton()->profiling) {
+					call_time = OS::get_singleton()->get_ticks_usec();
+				}
+
+#endif
+				Variant::CallError err;
+				if (likely(base->get_type() == method->type)) {
+					base->call_builtin(method->method, (const Variant **)argptrs, argc, ret, err);
+				} else {
+					// type hints are not enforced everywhere, the value may not be of the inferred type
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+				}
+#ifdef DEBUG_ENABLED
+				if (GDScriptLanguage::get_singleton()->profiling) {
+					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
+				}
+
+				if (err.error != Variant::CallError::CALL_OK) {
+
+					err_text = _get_call_error(err, "function '" + String(*methodname) + "' in base '" + _get_var_type(base) + "'", (const Variant **)argptrs);
+					OPCODE_BREAK;
+				}
+#endif
+
+				ip += argc + 1;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_CALL_BUILT_IN) {
 
 				CHECK_SPACE(4);
@@ -1389,6 +2014,48 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_NOT_OPERATOR) {
+
+				CHECK_SPACE(5);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+
+				bool result;
+				if (unlikely(!_compare_numbers(op, a, b, result))) {
+
+					bool valid;
+					Variant ret;
+					Variant::evaluate(op, *a, *b, ret, valid);
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+
+						if (ret.get_type() == Variant::STRING) {
+							//return a string when invalid with the error
+							err_text = ret;
+							err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
+						} else {
+							err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
+						}
+						OPCODE_BREAK;
+					}
+#endif
+					result = ret.booleanize();
+				}
+
+				if (!result) {
+					int to = _code_ptr[ip + 4];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 5;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 
 				CHECK_SPACE(2);
@@ -1408,6 +2075,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 
 			OPCODE(OPCODE_ITERATE_BEGIN) {
+			generic_iterate_begin: // OPCODE_ITERATE_BEGIN_INT ends up here when the container is not an int
 
 				CHECK_SPACE(8); //space for this a regular iterate
 
@@ -1441,6 +2109,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_ITERATE) {
+			generic_iterate:
 
 				CHECK_SPACE(4);
 
@@ -1473,6 +2142,145 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_ITERATE_BEGIN_INT) {
+
+				CHECK_SPACE(8); //space for this a regular iterate
+
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(container, 2);
+
+				if (unlikely(container->get_type() != Variant::INT && container->get_type() != Variant::REAL)) {
+					goto generic_iterate_begin;
+				}
+
+				_set_int(counter, 0);
+
+				if (!_is_in_number_range(container, 0)) {
+					int jumpto = _code_ptr[ip + 3];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 4);
+
+					_set_int(iterator, 0);
+					ip += 5; //skip regular iterate which is always next
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ITERATE_INT) {
+
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(container, 2);
+
+				if (unlikely((container->get_type() != Variant::INT && container->get_type() != Variant::REAL) || counter->get_type() != Variant::INT)) {
+					goto generic_iterate;
+				}
+
+				int64_t idx = *VariantInternal::get_int(counter) + 1;
+
+				if (!_is_in_number_range(container, idx)) {
+					int jumpto = _code_ptr[ip + 3];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 4);
+
+					*VariantInternal::get_int(counter) = idx;
+					_set_int(iterator, idx);
+					ip += 5; //loop again
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ITERATE_BEGIN_RANGE) {
+
+				CHECK_SPACE(10);
+
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(to, 2);
+				GET_VARIANT_PTR(step, 3);
+
+				// range() arguments, the unused ones repeat the first
+				int argc = _code_ptr[ip + 6];
+				GD_ERR_BREAK(argc < 1 || argc > 3);
+				GET_VARIANT_PTR(arg0, 7);
+				GET_VARIANT_PTR(arg1, 8);
+				GET_VARIANT_PTR(arg2, 9);
+				const Variant *argptrs[3] = { arg0, arg1, arg2 };
+
+#ifdef DEBUG_ENABLED
+				int invalid_arg = -1;
+				for (int i = 0; i < argc; i++) {
+					if (!argptrs[i]->is_num()) {
+						invalid_arg = i;
+						break;
+					}
+				}
+
+				if (invalid_arg >= 0) {
+					Variant::CallError err;
+					err.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+					err.argument = invalid_arg;
+					err.expected = Variant::REAL;
+					err_text = _get_call_error(err, "built-in function 'range'", argptrs);
+					OPCODE_BREAK;
+				}
+#endif
+
+				// same conversions as the range() built-in function
+				int64_t from = argc > 1 ? argptrs[0]->operator int64_t() : 0;
+				_set_int(counter, from);
+				_set_int(to, argptrs[argc > 1 ? 1 : 0]->operator int64_t());
+				_set_int(step, argc > 2 ? argptrs[2]->operator int64_t() : 1);
+
+#ifdef DEBUG_ENABLED
+				if (*VariantInternal::get_int(step) == 0) {
+					err_text = "Error calling built-in function 'range': Step argument is zero!";
+					OPCODE_BREAK;
+				}
+#endif
+
+				if (!_is_in_range(from, *VariantInternal::get_int(to), *VariantInternal::get_int(step))) {
+					int jumpto = _code_ptr[ip + 4];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 5);
+
+					_set_int(iterator, from);
+					ip += 10; //skip regular iterate which is always next
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ITERATE_RANGE) {
+
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(to, 2);
+				GET_VARIANT_PTR(step, 3);
+
+				// the loop owns these, they are always ints
+				int64_t idx = *VariantInternal::get_int(counter) + *VariantInternal::get_int(step);
+
+				if (!_is_in_range(idx, *VariantInternal::get_int(to), *VariantInternal::get_int(step))) {
+					int jumpto = _code_ptr[ip + 4];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 5);
+
+					*VariantInternal::get_int(counter) = idx;
+					_set_int(iterator, idx);
+					ip += 6; //loop again
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(3);
 
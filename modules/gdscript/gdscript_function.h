@@ -31,6 +31,7 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "core/class_db.h"
 #include "core/os/thread.h"
 #include "core/pair.h"
 #include "core/reference.h"
@@ -41,6 +42,7 @@
 
 class GDScriptInstance;
 class GDScript;
+class MethodBind;
 
 struct GDScriptDataType {
 	bool has_type;
@@ -148,14 +150,20 @@ class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_INT, // same layout as OPCODE_OPERATOR, emitted when the operand types are known
+		OPCODE_OPERATOR_REAL,
+		OPCODE_OPERATOR_VECTOR2,
+		OPCODE_OPERATOR_VECTOR3,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
 		OPCODE_GET,
 		OPCODE_SET_NAMED,
 		OPCODE_GET_NAMED,
+		OPCODE_GET_NAMED_SCRIPT_MEMBER, // OPCODE_GET_NAMED on an instance of a known script, reads the member slot directly
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
+		OPCODE_OPERATOR_MEMBER, // OPCODE_GET_MEMBER + OPCODE_OPERATOR + OPCODE_SET_MEMBER, for compound assignments to native properties
 		OPCODE_ASSIGN,
 		OPCODE_ASSIGN_TRUE,
 		OPCODE_ASSIGN_FALSE,
@@ -170,6 +178,10 @@ public:
 		OPCODE_CONSTRUCT_DICTIONARY,
 		OPCODE_CALL,
 		OPCODE_CALL_RETURN,
+		OPCODE_CALL_NATIVE, // OPCODE_CALL on an object of a known engine class, calls the MethodBind directly
+		OPCODE_CALL_NATIVE_RETURN,
+		OPCODE_CALL_VARIANT, // OPCODE_CALL on a value of a known built-in type, calls the resolved method directly
+		OPCODE_CALL_VARIANT_RETURN,
 		OPCODE_CALL_BUILT_IN,
 		OPCODE_CALL_SELF,
 		OPCODE_CALL_SELF_BASE,
@@ -179,10 +191,15 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_NOT_OPERATOR, // comparison + OPCODE_JUMP_IF_NOT, the result is not stored
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_RETURN,
 		OPCODE_ITERATE_BEGIN,
 		OPCODE_ITERATE,
+		OPCODE_ITERATE_BEGIN_INT, // same layout as OPCODE_ITERATE_BEGIN, emitted when iterating over an int or a float
+		OPCODE_ITERATE_INT,
+		OPCODE_ITERATE_BEGIN_RANGE, // for ... in range(), counts without creating the array
+		OPCODE_ITERATE_RANGE,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
@@ -205,6 +222,29 @@ public:
 		ADDR_TYPE_NIL = 9
 	};
 
+	struct NativeMethod {
+
+		MethodBind *method;
+		void *class_ptr; // class declaring the method, instances are checked against it before calling
+		bool ptrcall; // whether the arguments and return value can be passed as raw pointers
+		bool ret_enum; // enums are returned as 32 bit ints by ptrcall
+	};
+
+	// what a global name resolved to on the classes of the objects it was used on, so calls and named
+	// accesses don't walk the class hierarchy each time
+	struct NameCache {
+
+		MethodCache method;
+		PropertyCache get;
+		PropertyCache set;
+	};
+
+	struct VariantMethod {
+
+		const Variant::BuiltinMethod *method;
+		Variant::Type type; // type the method was resolved on, other values go through Variant::call_ptr()
+	};
+
 	struct StackDebug {
 
 		int line;
@@ -223,6 +263,11 @@ private:
 	int _constant_count;
 	const StringName *_global_names_ptr;
 	int _global_names_count;
+	NameCache *_name_caches_ptr; // one per global name
+	const NativeMethod *_native_methods_ptr;
+	int _native_methods_count;
+	const VariantMethod *_variant_methods_ptr;
+	int _variant_methods_count;
 #ifdef TOOLS_ENABLED
 	const StringName *_named_globals_ptr;
 	int _named_globals_count;
@@ -243,6 +288,9 @@ private:
 	StringName name;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
+	Vector<NameCache> name_caches;
+	Vector<NativeMethod> native_methods;
+	Vector<VariantMethod> variant_methods;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
@@ -30,6 +30,7 @@
 
 #include "thread_jandroid.h"
 
+#include "core/message_queue.h"
 #include "core/os/memory.h"
 #include "core/safe_refcount.h"
 #include "core/script_language.h"
@@ -64,8 +65,11 @@ void *ThreadAndroid::thread_callback(void *userdata) {
 	ScriptServer::thread_enter(); //scripts may need to attach a stack
 	t->id = atomic_increment(&next_thread_id);
 	pthread_setspecific(thread_id_key, (void *)memnew(ID(t->id)));
+	MessageQueue::thread_enter();
 	t->callback(t->user);
+	MessageQueue::thread_exit();
 	ScriptServer::thread_exit();
+	Memory::release_thread_cache();
 	return NULL;
 }
 
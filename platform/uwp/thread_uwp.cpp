@@ -30,13 +30,25 @@
 
 #include "thread_uwp.h"
 
+#include "core/message_queue.h"
 #include "core/os/memory.h"
 
+void ThreadUWP::thread_callback(ThreadCreateCallback p_callback, void *p_user) {
+
+	MessageQueue::thread_enter();
+
+	p_callback(p_user);
+
+	MessageQueue::thread_exit();
+
+	Memory::release_thread_cache();
+};
+
 Thread *ThreadUWP::create_func_uwp(ThreadCreateCallback p_callback, void *p_user, const Settings &) {
 
 	ThreadUWP *thread = memnew(ThreadUWP);
 
-	std::thread new_thread(p_callback, p_user);
+	std::thread new_thread(thread_callback, p_callback, p_user);
 	std::swap(thread->thread, new_thread);
 
 	return thread;
@@ -41,6 +41,8 @@ class ThreadUWP : public Thread {
 
 	std::thread thread;
 
+	static void thread_callback(ThreadCreateCallback p_callback, void *p_user);
+
 	static Thread *create_func_uwp(ThreadCreateCallback p_callback, void *, const Settings &);
 	static ID get_thread_id_func_uwp();
 	static void wait_to_finish_func_uwp(Thread *p_thread);
@@ -41,9 +41,17 @@ bool AreaPairSW::setup(real_t p_step) {
 		result = true;
 	}
 
-	if (result != colliding) {
+	process_collision = result != colliding; // the area is shared between islands, so it's updated in pre_solve()
+	colliding = result;
 
-		if (result) {
+	return false; //never do any post solving
+}
+
+bool AreaPairSW::pre_solve(real_t p_step) {
+
+	if (process_collision) {
+
+		if (colliding) {
 
 			if (area->get_space_override_mode() != PhysicsServer::AREA_SPACE_OVERRIDE_DISABLED)
 				body->add_area(area);
@@ -58,7 +66,7 @@ bool AreaPairSW::setup(real_t p_step) {
 				area->remove_body_from_query(body, body_shape, area_shape);
 		}
 
-		colliding = result;
+		process_collision = false;
 	}
 
 	return false; //never do any post solving
@@ -74,6 +82,7 @@ AreaPairSW::AreaPairSW(BodySW *p_body, int p_body_shape, AreaSW *p_area, int p_a
 	body_shape = p_body_shape;
 	area_shape = p_area_shape;
 	colliding = false;
+	process_collision = false;
 	body->add_constraint(this, 0);
 	area->add_constraint(this);
 	if (p_body->get_mode() == PhysicsServer::BODY_MODE_KINEMATIC)
@@ -104,9 +113,17 @@ bool Area2PairSW::setup(real_t p_step) {
 		result = true;
 	}
 
-	if (result != colliding) {
+	process_collision = result != colliding; // both areas may be shared with other islands, so they're updated in pre_solve()
+	colliding = result;
+
+	return false; //never do any post solving
+}
+
+bool Area2PairSW::pre_solve(real_t p_step) {
+
+	if (process_collision) {
 
-		if (result) {
+		if (colliding) {
 
 			if (area_b->has_area_monitor_callback() && area_a->is_monitorable())
 				area_b->add_area_to_query(area_a, shape_a, shape_b);
@@ -123,7 +140,7 @@ bool Area2PairSW::setup(real_t p_step) {
 				area_a->remove_area_from_query(area_b, shape_b, shape_a);
 		}
 
-		colliding = result;
+		process_collision = false;
 	}
 
 	return false; //never do any post solving
@@ -139,6 +156,7 @@ Area2PairSW::Area2PairSW(AreaSW *p_area_a, int p_shape_a, AreaSW *p_area_b, int
 	shape_a = p_shape_a;
 	shape_b = p_shape_b;
 	colliding = false;
+	process_collision = false;
 	area_a->add_constraint(this);
 	area_b->add_constraint(this);
 }
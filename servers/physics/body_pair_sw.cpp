@@ -169,6 +169,16 @@ void BodyPairSW::validate_contacts() {
 	}
 }
 
+void BodyPairSW::_get_shape_transforms(Transform &r_xform_A, Transform &r_xform_B) const {
+
+	Transform xform_Au = Transform(A->get_transform().basis, Vector3());
+	r_xform_A = xform_Au * A->get_shape_transform(shape_A);
+
+	Transform xform_Bu = B->get_transform();
+	xform_Bu.origin -= A->get_transform().get_origin();
+	r_xform_B = xform_Bu * B->get_shape_transform(shape_B);
+}
+
 bool BodyPairSW::_test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B) {
 
 	Vector3 motion = p_A->get_linear_velocity() * p_step;
@@ -221,6 +231,8 @@ real_t combine_friction(BodySW *A, BodySW *B) {
 
 bool BodyPairSW::setup(real_t p_step) {
 
+	check_ccd = false;
+
 	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self()) || (A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC && A->get_max_contacts_reported() == 0 && B->get_max_contacts_reported() == 0)) {
 		collided = false;
@@ -232,17 +244,15 @@ bool BodyPairSW::setup(real_t p_step) {
 		return false;
 	}
 
+	dynamic_A = A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC;
+	dynamic_B = B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC;
+
 	offset_B = B->get_transform().get_origin() - A->get_transform().get_origin();
 
 	validate_contacts();
 
-	Vector3 offset_A = A->get_transform().get_origin();
-	Transform xform_Au = Transform(A->get_transform().basis, Vector3());
-	Transform xform_A = xform_Au * A->get_shape_transform(shape_A);
-
-	Transform xform_Bu = B->get_transform();
-	xform_Bu.origin -= offset_A;
-	Transform xform_B = xform_Bu * B->get_shape_transform(shape_B);
+	Transform xform_A, xform_B;
+	_get_shape_transforms(xform_A, xform_B);
 
 	ShapeSW *shape_A_ptr = A->get_shape(shape_A);
 	ShapeSW *shape_B_ptr = B->get_shape(shape_B);
@@ -252,16 +262,8 @@ bool BodyPairSW::setup(real_t p_step) {
 
 	if (!collided) {
 
-		//test ccd (currently just a raycast)
-
-		if (A->is_continuous_collision_detection_enabled() && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
-			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
-		}
-
-		if (B->is_continuous_collision_detection_enabled() && B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
-			_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
-		}
-
+		//test ccd (currently just a raycast), done in pre_solve() as it changes the body velocity
+		check_ccd = true;
 		return false;
 	}
 
@@ -281,6 +283,10 @@ bool BodyPairSW::setup(real_t p_step) {
 
 	real_t inv_dt = 1.0 / p_step;
 
+	Transform xform_Au = Transform(A->get_transform().basis, Vector3());
+	Transform xform_Bu = B->get_transform();
+	xform_Bu.origin -= A->get_transform().get_origin();
+
 	for (int i = 0; i < contact_count; i++) {
 
 		Contact &c = contacts[i];
@@ -298,46 +304,80 @@ bool BodyPairSW::setup(real_t p_step) {
 
 		c.active = true;
 
+		c.rA = global_A - A->get_center_of_mass();
+		c.rB = global_B - B->get_center_of_mass() - offset_B;
+
+		// Precompute normal mass, tangent mass, and bias.
+		Vector3 inertia_A = A->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
+		Vector3 inertia_B = B->get_inv_inertia_tensor().xform(c.rB.cross(c.normal));
+		real_t kNormal = A->get_inv_mass() + B->get_inv_mass();
+		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
+		c.mass_normal = 1.0f / kNormal;
+
+		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
+		c.depth = depth;
+
+		c.acc_bias_impulse = 0;
+		c.acc_bias_impulse_center_of_mass = 0;
+	}
+
+	return true;
+}
+
+bool BodyPairSW::pre_solve(real_t p_step) {
+
+	if (!collided) {
+
+		if (!check_ccd)
+			return false;
+
+		Transform xform_A, xform_B;
+		_get_shape_transforms(xform_A, xform_B);
+
+		if (A->is_continuous_collision_detection_enabled() && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
+			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
+		}
+
+		if (B->is_continuous_collision_detection_enabled() && B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
+			_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
+		}
+
+		return false;
+	}
+
+	for (int i = 0; i < contact_count; i++) {
+
+		Contact &c = contacts[i];
+		if (!c.active)
+			continue;
+
+		Vector3 global_A = c.rA + A->get_center_of_mass();
+		Vector3 global_B = c.rB + B->get_center_of_mass() + offset_B;
+
 #ifdef DEBUG_ENABLED
 
 		if (space->is_debugging_contacts()) {
+			Vector3 offset_A = A->get_transform().get_origin();
 			space->add_debug_contact(global_A + offset_A);
 			space->add_debug_contact(global_B + offset_A);
 		}
 #endif
 
-		c.rA = global_A - A->get_center_of_mass();
-		c.rB = global_B - B->get_center_of_mass() - offset_B;
-
 		// contact query reporting...
 
 		if (A->can_report_contacts()) {
 			Vector3 crA = A->get_angular_velocity().cross(c.rA) + A->get_linear_velocity();
-			A->add_contact(global_A, -c.normal, depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crA);
+			A->add_contact(global_A, -c.normal, c.depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crA);
 		}
 
 		if (B->can_report_contacts()) {
 			Vector3 crB = B->get_angular_velocity().cross(c.rB) + B->get_linear_velocity();
-			B->add_contact(global_B, c.normal, depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crB);
+			B->add_contact(global_B, c.normal, c.depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crB);
 		}
 
-		c.active = true;
-
-		// Precompute normal mass, tangent mass, and bias.
-		Vector3 inertia_A = A->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
-		Vector3 inertia_B = B->get_inv_inertia_tensor().xform(c.rB.cross(c.normal));
-		real_t kNormal = A->get_inv_mass() + B->get_inv_mass();
-		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
-		c.mass_normal = 1.0f / kNormal;
-
-		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
-		c.depth = depth;
-
 		Vector3 j_vec = c.normal * c.acc_normal_impulse + c.acc_tangent_impulse;
 		A->apply_impulse(c.rA + A->get_center_of_mass(), -j_vec);
 		B->apply_impulse(c.rB + B->get_center_of_mass(), j_vec);
-		c.acc_bias_impulse = 0;
-		c.acc_bias_impulse_center_of_mass = 0;
 
 		c.bounce = combine_bounce(A, B);
 		if (c.bounce) {
@@ -382,8 +422,10 @@ void BodyPairSW::solve(real_t p_step) {
 
 			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
 
-			A->apply_bias_impulse(c.rA + A->get_center_of_mass(), -jb, MAX_BIAS_ROTATION / p_step);
-			B->apply_bias_impulse(c.rB + B->get_center_of_mass(), jb, MAX_BIAS_ROTATION / p_step);
+			if (dynamic_A)
+				A->apply_bias_impulse(c.rA + A->get_center_of_mass(), -jb, MAX_BIAS_ROTATION / p_step);
+			if (dynamic_B)
+				B->apply_bias_impulse(c.rB + B->get_center_of_mass(), jb, MAX_BIAS_ROTATION / p_step);
 
 			crbA = A->get_biased_angular_velocity().cross(c.rA);
 			crbB = B->get_biased_angular_velocity().cross(c.rB);
@@ -399,8 +441,10 @@ void BodyPairSW::solve(real_t p_step) {
 
 				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
 
-				A->apply_bias_impulse(A->get_center_of_mass(), -jb_com, 0.0f);
-				B->apply_bias_impulse(B->get_center_of_mass(), jb_com, 0.0f);
+				if (dynamic_A)
+					A->apply_bias_impulse(A->get_center_of_mass(), -jb_com, 0.0f);
+				if (dynamic_B)
+					B->apply_bias_impulse(B->get_center_of_mass(), jb_com, 0.0f);
 			}
 
 			c.active = true;
@@ -421,8 +465,10 @@ void BodyPairSW::solve(real_t p_step) {
 
 			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
 
-			A->apply_impulse(c.rA + A->get_center_of_mass(), -j);
-			B->apply_impulse(c.rB + B->get_center_of_mass(), j);
+			if (dynamic_A)
+				A->apply_impulse(c.rA + A->get_center_of_mass(), -j);
+			if (dynamic_B)
+				B->apply_impulse(c.rB + B->get_center_of_mass(), j);
 
 			c.active = true;
 		}
@@ -466,8 +512,10 @@ void BodyPairSW::solve(real_t p_step) {
 
 			jt = c.acc_tangent_impulse - jtOld;
 
-			A->apply_impulse(c.rA + A->get_center_of_mass(), -jt);
-			B->apply_impulse(c.rB + B->get_center_of_mass(), jt);
+			if (dynamic_A)
+				A->apply_impulse(c.rA + A->get_center_of_mass(), -jt);
+			if (dynamic_B)
+				B->apply_impulse(c.rB + B->get_center_of_mass(), jt);
 
 			c.active = true;
 		}
@@ -486,6 +534,9 @@ BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B) :
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	check_ccd = false;
+	dynamic_A = false;
+	dynamic_B = false;
 }
 
 BodyPairSW::~BodyPairSW() {
@@ -565,22 +565,28 @@ void BodySW::integrate_forces(real_t p_step) {
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+	if (do_motion) { //shapes temporarily extend for raycast, done in post_integrate_forces()
+		pending_motion = motion;
+		motion_pending = true;
 	}
 
 	def_area = NULL; // clear the area, so it is set in the next frame
 	contact_count = 0;
 }
 
+void BodySW::post_integrate_forces() {
+
+	if (motion_pending) {
+		_update_shapes_with_motion(pending_motion);
+		motion_pending = false;
+	}
+}
+
 void BodySW::integrate_velocities(real_t p_step) {
 
 	if (mode == PhysicsServer::BODY_MODE_STATIC)
 		return;
 
-	if (fi_callback)
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer::BodyAxis)(1 << i))) {
@@ -601,9 +607,6 @@ void BodySW::integrate_velocities(real_t p_step) {
 
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3())
-			set_active(false); //stopped moving, deactivate
-
 		return;
 	}
 
@@ -630,7 +633,7 @@ void BodySW::integrate_velocities(real_t p_step) {
 
 	transform.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform);
+	_set_transform(transform, false); // shapes are updated in post_integrate_velocities()
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependant();
@@ -641,6 +644,25 @@ void BodySW::integrate_velocities(real_t p_step) {
 	*/
 }
 
+void BodySW::post_integrate_velocities() {
+
+	if (mode == PhysicsServer::BODY_MODE_STATIC)
+		return;
+
+	if (fi_callback)
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+
+	if (mode == PhysicsServer::BODY_MODE_KINEMATIC) {
+
+		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3())
+			set_active(false); //stopped moving, deactivate
+
+		return;
+	}
+
+	_update_shapes();
+}
+
 /*
 void BodySW::simulate_motion(const Transform& p_xform,real_t p_step) {
 
@@ -784,6 +806,7 @@ BodySW::BodySW() :
 	island_next = NULL;
 	island_list_next = NULL;
 	first_time_kinematic = false;
+	motion_pending = false;
 	first_integration = false;
 	_set_static(false);
 
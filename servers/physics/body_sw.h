@@ -92,6 +92,8 @@ class BodySW : public CollisionObjectSW {
 	bool continuous_cd;
 	bool can_sleep;
 	bool first_time_kinematic;
+	bool motion_pending;
+	Vector3 pending_motion;
 	void _update_inertia();
 	virtual void _shapes_changed();
 	Transform new_transform;
@@ -305,8 +307,12 @@ public:
 	void set_axis_lock(PhysicsServer::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer::BodyAxis p_axis) const;
 
+	// The integrate functions only modify the body itself, so different bodies can be integrated on different threads.
+	// The broadphase and the space lists are updated afterwards by the post_integrate functions, which must run serially.
 	void integrate_forces(real_t p_step);
+	void post_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void post_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 
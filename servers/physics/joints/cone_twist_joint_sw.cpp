@@ -111,6 +111,9 @@ ConeTwistJointSW::ConeTwistJointSW(BodySW *rbA, BodySW *rbB, const Transform &rb
 }
 
 bool ConeTwistJointSW::setup(real_t p_timestep) {
+	dynamic_A = (A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+
 	m_appliedImpulse = real_t(0.);
 
 	//set bias, sign, clear accumulator
@@ -264,8 +267,10 @@ void ConeTwistJointSW::solve(real_t p_timestep) {
 			real_t impulse = depth * tau / p_timestep * jacDiagABInv - rel_vel * jacDiagABInv;
 			m_appliedImpulse += impulse;
 			Vector3 impulse_vector = normal * impulse;
-			A->apply_impulse(pivotAInW - A->get_transform().origin, impulse_vector);
-			B->apply_impulse(pivotBInW - B->get_transform().origin, -impulse_vector);
+			if (dynamic_A)
+				A->apply_impulse(pivotAInW - A->get_transform().origin, impulse_vector);
+			if (dynamic_B)
+				B->apply_impulse(pivotBInW - B->get_transform().origin, -impulse_vector);
 		}
 	}
 
@@ -286,8 +291,10 @@ void ConeTwistJointSW::solve(real_t p_timestep) {
 
 			Vector3 impulse = m_swingAxis * impulseMag;
 
-			A->apply_torque_impulse(impulse);
-			B->apply_torque_impulse(-impulse);
+			if (dynamic_A)
+				A->apply_torque_impulse(impulse);
+			if (dynamic_B)
+				B->apply_torque_impulse(-impulse);
 		}
 
 		// solve twist limit
@@ -302,8 +309,10 @@ void ConeTwistJointSW::solve(real_t p_timestep) {
 
 			Vector3 impulse = m_twistAxis * impulseMag;
 
-			A->apply_torque_impulse(impulse);
-			B->apply_torque_impulse(-impulse);
+			if (dynamic_A)
+				A->apply_torque_impulse(impulse);
+			if (dynamic_B)
+				B->apply_torque_impulse(-impulse);
 		}
 	}
 }
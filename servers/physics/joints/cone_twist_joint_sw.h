@@ -70,6 +70,9 @@ public:
 		BodySW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	JacobianEntrySW m_jac[3]; //3 orthogonal linear constraints
 
 	real_t m_appliedImpulse;
@@ -82,7 +82,7 @@ int G6DOFRotationalLimitMotorSW::testLimitValue(real_t test_value) {
 
 real_t G6DOFRotationalLimitMotorSW::solveAngularLimits(
 		real_t timeStep, Vector3 &axis, real_t jacDiagABInv,
-		BodySW *body0, BodySW *body1) {
+		BodySW *body0, bool dynamic0, BodySW *body1, bool dynamic1) {
 	if (!needApplyTorques()) return 0.0f;
 
 	real_t target_velocity = m_targetVelocity;
@@ -136,8 +136,8 @@ real_t G6DOFRotationalLimitMotorSW::solveAngularLimits(
 
 	Vector3 motorImp = clippedMotorImpulse * axis;
 
-	body0->apply_torque_impulse(motorImp);
-	if (body1) body1->apply_torque_impulse(-motorImp);
+	if (dynamic0) body0->apply_torque_impulse(motorImp);
+	if (body1 && dynamic1) body1->apply_torque_impulse(-motorImp);
 
 	return clippedMotorImpulse;
 }
@@ -148,8 +148,8 @@ real_t G6DOFRotationalLimitMotorSW::solveAngularLimits(
 real_t G6DOFTranslationalLimitMotorSW::solveLinearAxis(
 		real_t timeStep,
 		real_t jacDiagABInv,
-		BodySW *body1, const Vector3 &pointInA,
-		BodySW *body2, const Vector3 &pointInB,
+		BodySW *body1, bool dynamic1, const Vector3 &pointInA,
+		BodySW *body2, bool dynamic2, const Vector3 &pointInB,
 		int limit_index,
 		const Vector3 &axis_normal_on_a,
 		const Vector3 &anchorPos) {
@@ -202,8 +202,10 @@ real_t G6DOFTranslationalLimitMotorSW::solveLinearAxis(
 	normalImpulse = m_accumulatedImpulse[limit_index] - oldNormalImpulse;
 
 	Vector3 impulse_vector = axis_normal_on_a * normalImpulse;
-	body1->apply_impulse(rel_pos1, impulse_vector);
-	body2->apply_impulse(rel_pos2, -impulse_vector);
+	if (dynamic1)
+		body1->apply_impulse(rel_pos1, impulse_vector);
+	if (dynamic2)
+		body2->apply_impulse(rel_pos2, -impulse_vector);
 	return normalImpulse;
 }
 
@@ -302,6 +304,9 @@ bool Generic6DOFJointSW::testAngularLimitMotor(int axis_index) {
 
 bool Generic6DOFJointSW::setup(real_t p_timestep) {
 
+	dynamic_A = (A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+
 	// Clear accumulated impulses for the next simulation step
 	m_linearLimits.m_accumulatedImpulse = Vector3(real_t(0.), real_t(0.), real_t(0.));
 	int i;
@@ -375,8 +380,8 @@ void Generic6DOFJointSW::solve(real_t p_timestep) {
 			m_linearLimits.solveLinearAxis(
 					m_timeStep,
 					jacDiagABInv,
-					A, pointInA,
-					B, pointInB,
+					A, dynamic_A, pointInA,
+					B, dynamic_B, pointInB,
 					i, linear_axis, m_AnchorPos);
 		}
 	}
@@ -392,7 +397,7 @@ void Generic6DOFJointSW::solve(real_t p_timestep) {
 
 			angularJacDiagABInv = real_t(1.) / m_jacAng[i].getDiagonal();
 
-			m_angularLimits[i].solveAngularLimits(m_timeStep, angular_axis, angularJacDiagABInv, A, B);
+			m_angularLimits[i].solveAngularLimits(m_timeStep, angular_axis, angularJacDiagABInv, A, dynamic_A, B, dynamic_B);
 		}
 	}
 }
@@ -132,8 +132,8 @@ public:
 	*/
 	int testLimitValue(real_t test_value);
 
-	//! apply the correction impulses for two bodies
-	real_t solveAngularLimits(real_t timeStep, Vector3 &axis, real_t jacDiagABInv, BodySW *body0, BodySW *body1);
+	//! apply the correction impulses for two bodies, only dynamic ones are written to
+	real_t solveAngularLimits(real_t timeStep, Vector3 &axis, real_t jacDiagABInv, BodySW *body0, bool dynamic0, BodySW *body1, bool dynamic1);
 };
 
 class G6DOFTranslationalLimitMotorSW {
@@ -187,8 +187,8 @@ public:
 	real_t solveLinearAxis(
 			real_t timeStep,
 			real_t jacDiagABInv,
-			BodySW *body1, const Vector3 &pointInA,
-			BodySW *body2, const Vector3 &pointInB,
+			BodySW *body1, bool dynamic1, const Vector3 &pointInA,
+			BodySW *body2, bool dynamic2, const Vector3 &pointInB,
 			int limit_index,
 			const Vector3 &axis_normal_on_a,
 			const Vector3 &anchorPos);
@@ -205,6 +205,9 @@ protected:
 		BodySW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	//! relative_frames
 	//!@{
 	Transform m_frameInA; //!< the constraint space w.r.t body A
@@ -64,6 +64,9 @@ class HingeJointSW : public JointSW {
 		BodySW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	JacobianEntrySW m_jac[3]; //3 orthogonal linear constraints
 	JacobianEntrySW m_jacAng[3]; //2 orthogonal angular constraints+ 1 for limit/motor
 
@@ -51,6 +51,9 @@ subject to the following restrictions:
 
 bool PinJointSW::setup(real_t p_step) {
 
+	dynamic_A = (A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+
 	m_appliedImpulse = real_t(0.);
 
 	Vector3 normal(0, 0, 0);
@@ -119,8 +122,10 @@ void PinJointSW::solve(real_t p_step) {
 
 		m_appliedImpulse += impulse;
 		Vector3 impulse_vector = normal * impulse;
-		A->apply_impulse(pivotAInW - A->get_transform().origin, impulse_vector);
-		B->apply_impulse(pivotBInW - B->get_transform().origin, -impulse_vector);
+		if (dynamic_A)
+			A->apply_impulse(pivotAInW - A->get_transform().origin, impulse_vector);
+		if (dynamic_B)
+			B->apply_impulse(pivotBInW - B->get_transform().origin, -impulse_vector);
 
 		normal[i] = 0;
 	}
@@ -64,6 +64,9 @@ class PinJointSW : public JointSW {
 		BodySW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	real_t m_tau; //bias
 	real_t m_damping;
 	real_t m_impulseClamp;
@@ -130,6 +130,9 @@ SliderJointSW::SliderJointSW(BodySW *rbA, BodySW *rbB, const Transform &frameInA
 
 bool SliderJointSW::setup(real_t p_step) {
 
+	dynamic_A = (A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC);
+
 	//calculate transforms
 	m_calculatedTransformA = A->get_transform() * m_frameInA;
 	m_calculatedTransformB = B->get_transform() * m_frameInB;
@@ -200,8 +203,10 @@ void SliderJointSW::solve(real_t p_step) {
 		// calcutate and apply impulse
 		real_t normalImpulse = softness * (restitution * depth / p_step - damping * rel_vel) * m_jacLinDiagABInv[i];
 		Vector3 impulse_vector = normal * normalImpulse;
-		A->apply_impulse(m_relPosA, impulse_vector);
-		B->apply_impulse(m_relPosB, -impulse_vector);
+		if (dynamic_A)
+			A->apply_impulse(m_relPosA, impulse_vector);
+		if (dynamic_B)
+			B->apply_impulse(m_relPosB, -impulse_vector);
 		if (m_poweredLinMotor && (!i)) { // apply linear motor
 			if (m_accumulatedLinMotorImpulse < m_maxLinMotorForce) {
 				real_t desiredMotorVel = m_targetLinMotorVelocity;
@@ -221,8 +226,10 @@ void SliderJointSW::solve(real_t p_step) {
 				m_accumulatedLinMotorImpulse = new_acc;
 				// apply clamped impulse
 				impulse_vector = normal * normalImpulse;
-				A->apply_impulse(m_relPosA, impulse_vector);
-				B->apply_impulse(m_relPosB, -impulse_vector);
+				if (dynamic_A)
+					A->apply_impulse(m_relPosA, impulse_vector);
+				if (dynamic_B)
+					B->apply_impulse(m_relPosB, -impulse_vector);
 			}
 		}
 	}
@@ -256,8 +263,10 @@ void SliderJointSW::solve(real_t p_step) {
 		angularError *= (real_t(1.) / denom2) * m_restitutionOrthoAng * m_softnessOrthoAng;
 	}
 	// apply impulse
-	A->apply_torque_impulse(-velrelOrthog + angularError);
-	B->apply_torque_impulse(velrelOrthog - angularError);
+	if (dynamic_A)
+		A->apply_torque_impulse(-velrelOrthog + angularError);
+	if (dynamic_B)
+		B->apply_torque_impulse(velrelOrthog - angularError);
 	real_t impulseMag;
 	//solve angular limits
 	if (m_solveAngLim) {
@@ -268,8 +277,10 @@ void SliderJointSW::solve(real_t p_step) {
 		impulseMag *= m_kAngle * m_softnessDirAng;
 	}
 	Vector3 impulse = axisA * impulseMag;
-	A->apply_torque_impulse(impulse);
-	B->apply_torque_impulse(-impulse);
+	if (dynamic_A)
+		A->apply_torque_impulse(impulse);
+	if (dynamic_B)
+		B->apply_torque_impulse(-impulse);
 	//apply angular motor
 	if (m_poweredAngMotor) {
 		if (m_accumulatedAngMotorImpulse < m_maxAngMotorForce) {
@@ -294,8 +305,10 @@ void SliderJointSW::solve(real_t p_step) {
 			m_accumulatedAngMotorImpulse = new_acc;
 			// apply clamped impulse
 			Vector3 motorImp = angImpulse * axisA;
-			A->apply_torque_impulse(motorImp);
-			B->apply_torque_impulse(-motorImp);
+			if (dynamic_A)
+				A->apply_torque_impulse(motorImp);
+			if (dynamic_B)
+				B->apply_torque_impulse(-motorImp);
 		}
 	}
 } // SliderJointSW::solveConstraint()
@@ -76,6 +76,9 @@ protected:
 		BodySW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	Transform m_frameInA;
 	Transform m_frameInB;
 
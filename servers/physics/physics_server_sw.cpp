@@ -31,8 +31,10 @@
 #include "physics_server_sw.h"
 
 #include "broad_phase_basic.h"
+#include "broad_phase_bvh.h"
 #include "broad_phase_octree.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "core/script_language.h"
 #include "joints/cone_twist_joint_sw.h"
 #include "joints/generic_6dof_joint_sw.h"
@@ -142,8 +144,8 @@ real_t PhysicsServerSW::shape_get_custom_solver_bias(RID p_shape) const {
 
 RID PhysicsServerSW::space_create() {
 
-	SpaceSW *space = memnew(SpaceSW);
-	RID id = space_owner.make_rid(space);
+	RID id = space_owner.make_rid();
+	SpaceSW *space = space_owner.get(id);
 	space->set_self(id);
 	RID area_id = area_create();
 	AreaSW *area = area_owner.get(area_id);
@@ -224,8 +226,8 @@ int PhysicsServerSW::space_get_contact_count(RID p_space) const {
 
 RID PhysicsServerSW::area_create() {
 
-	AreaSW *area = memnew(AreaSW);
-	RID rid = area_owner.make_rid(area);
+	RID rid = area_owner.make_rid();
+	AreaSW *area = area_owner.get(rid);
 	area->set_self(rid);
 	return rid;
 };
@@ -477,12 +479,12 @@ void PhysicsServerSW::area_set_area_monitor_callback(RID p_area, Object *p_recei
 
 RID PhysicsServerSW::body_create(BodyMode p_mode, bool p_init_sleeping) {
 
-	BodySW *body = memnew(BodySW);
+	RID rid = body_owner.make_rid();
+	BodySW *body = body_owner.get(rid);
 	if (p_mode != BODY_MODE_RIGID)
 		body->set_mode(p_mode);
 	if (p_init_sleeping)
 		body->set_state(BODY_STATE_SLEEPING, p_init_sleeping);
-	RID rid = body_owner.make_rid(body);
 	body->set_self(rid);
 	return rid;
 };
@@ -1349,7 +1351,6 @@ void PhysicsServerSW::free(RID p_rid) {
 		}
 
 		body_owner.free(p_rid);
-		memdelete(body);
 
 	} else if (area_owner.owns(p_rid)) {
 
@@ -1368,7 +1369,6 @@ void PhysicsServerSW::free(RID p_rid) {
 		}
 
 		area_owner.free(p_rid);
-		memdelete(area);
 	} else if (space_owner.owns(p_rid)) {
 
 		SpaceSW *space = space_owner.get(p_rid);
@@ -1383,7 +1383,6 @@ void PhysicsServerSW::free(RID p_rid) {
 		free(space->get_static_global_body());
 
 		space_owner.free(p_rid);
-		memdelete(space);
 	} else if (joint_owner.owns(p_rid)) {
 
 		JointSW *joint = joint_owner.get(p_rid);
@@ -1574,7 +1573,10 @@ void PhysicsServerSW::_shape_col_cbk(const Vector3 &p_point_A, const Vector3 &p_
 PhysicsServerSW *PhysicsServerSW::singleton = NULL;
 PhysicsServerSW::PhysicsServerSW() {
 	singleton = this;
-	BroadPhaseSW::create_func = BroadPhaseOctree::_create;
+
+	GLOBAL_DEF("physics/3d/godot_physics/threaded_step", true);
+	bool use_bvh = GLOBAL_DEF("physics/3d/godot_physics/use_bvh", false);
+	BroadPhaseSW::create_func = use_bvh ? BroadPhaseBVH::_create : BroadPhaseOctree::_create;
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
@@ -32,6 +32,7 @@
 #include "joints_sw.h"
 
 #include "core/os/os.h"
+#include "core/project_settings.h"
 
 void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island) {
 
@@ -59,16 +60,6 @@ void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **
 	}
 }
 
-void StepSW::_setup_island(ConstraintSW *p_island, real_t p_delta) {
-
-	ConstraintSW *ci = p_island;
-	while (ci) {
-		ci->setup(p_delta);
-		//todo remove from island if process fails
-		ci = ci->get_island_next();
-	}
-}
-
 void StepSW::_solve_island(ConstraintSW *p_island, int p_iterations, real_t p_delta) {
 
 	int at_priority = 1;
@@ -144,12 +135,60 @@ void StepSW::_check_suspend(BodySW *p_island, real_t p_delta) {
 	}
 }
 
+void StepSW::_integrate_forces(uint32_t p_index, void *p_userdata) {
+
+	body_array[p_index]->integrate_forces(delta);
+}
+
+void StepSW::_integrate_velocities(uint32_t p_index, void *p_userdata) {
+
+	body_array[p_index]->integrate_velocities(delta);
+}
+
+void StepSW::_setup_constraint(uint32_t p_index, void *p_userdata) {
+
+	constraint_array[p_index]->setup(delta);
+}
+
+void StepSW::_solve_island_work(uint32_t p_index, void *p_userdata) {
+
+	_solve_island(island_array[p_index], iterations, delta);
+}
+
+void StepSW::_dispatch(uint32_t p_count, bool p_threaded, void (StepSW::*p_method)(uint32_t, void *)) {
+
+	if (p_threaded && work_pool.is_threaded()) {
+		work_pool.do_work(p_count, this, p_method, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, NULL);
+		}
+	}
+}
+
+void StepSW::_fill_body_array(const SelfList<BodySW>::List *p_body_list) {
+
+	int count = 0;
+	for (const SelfList<BodySW> *b = p_body_list->first(); b; b = b->next()) {
+		count++;
+	}
+
+	body_array.resize(count); // keeps the allocation from the previous step when the count doesn't change
+	BodySW **bodies = body_array.ptrw();
+	for (const SelfList<BodySW> *b = p_body_list->first(); b; b = b->next()) {
+		*bodies++ = b->self();
+	}
+}
+
 void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
 
+	delta = p_delta;
+	iterations = p_iterations;
+
 	const SelfList<BodySW>::List *body_list = &p_space->get_active_body_list();
 
 	/* INTEGRATE FORCES */
@@ -157,14 +196,13 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_body_array(body_list);
+	int active_count = body_array.size();
 
-	const SelfList<BodySW> *b = body_list->first();
-	while (b) {
+	_dispatch(active_count, active_count >= THREADED_MIN_BODIES, &StepSW::_integrate_forces);
 
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	for (int i = 0; i < active_count; i++) {
+		body_array[i]->post_integrate_forces(); // moves the broadphase, not thread safe
 	}
 
 	p_space->set_active_objects(active_count);
@@ -179,7 +217,7 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	BodySW *island_list = NULL;
 	ConstraintSW *constraint_island_list = NULL;
-	b = body_list->first();
+	const SelfList<BodySW> *b = body_list->first();
 
 	int island_count = 0;
 
@@ -222,6 +260,28 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 		p_space->area_remove_from_moved_list((SelfList<AreaSW> *)aml.first()); //faster to remove here
 	}
 
+	int constraint_count = 0;
+	int total_island_count = 0; // includes the area islands
+	for (ConstraintSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+		total_island_count++;
+		for (ConstraintSW *c = ci; c; c = c->get_island_next()) {
+			constraint_count++;
+		}
+	}
+
+	island_array.resize(total_island_count);
+	constraint_array.resize(constraint_count);
+	{
+		ConstraintSW **islands = island_array.ptrw();
+		ConstraintSW **constraints = constraint_array.ptrw();
+		for (ConstraintSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+			*islands++ = ci;
+			for (ConstraintSW *c = ci; c; c = c->get_island_next()) {
+				*constraints++ = c;
+			}
+		}
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
@@ -230,13 +290,13 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
-	{
-		ConstraintSW *ci = constraint_island_list;
-		while (ci) {
+	// setup() only does collision detection and precomputation on the constraint itself, so all constraints
+	// can be set up at once; whatever touches bodies or areas shared between islands is done in pre_solve()
+	_dispatch(constraint_count, constraint_count >= THREADED_MIN_CONSTRAINTS, &StepSW::_setup_constraint);
 
-			_setup_island(ci, p_delta);
-			ci = ci->get_island_list_next();
-		}
+	// unlike 2D, islands are still solved as linked lists, so constraints with nothing to solve aren't removed
+	for (int i = 0; i < constraint_count; i++) {
+		constraint_array[i]->pre_solve(p_delta);
 	}
 
 	{ //profile
@@ -247,14 +307,9 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
-		ConstraintSW *ci = constraint_island_list;
-		while (ci) {
-			//iterating each island separatedly improves cache efficiency
-			_solve_island(ci, p_iterations, p_delta);
-			ci = ci->get_island_list_next();
-		}
-	}
+	// islands don't share dynamic bodies, so each one can be solved on its own thread
+	// (iterating each island separatedly also improves cache efficiency)
+	_dispatch(total_island_count, constraint_count >= THREADED_MIN_CONSTRAINTS, &StepSW::_solve_island_work);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -264,11 +319,13 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<BodySW> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	_fill_body_array(body_list); // pre_solve() may have woken up bodies
+	active_count = body_array.size();
+
+	_dispatch(active_count, active_count >= THREADED_MIN_BODIES, &StepSW::_integrate_velocities);
+
+	for (int i = 0; i < active_count; i++) {
+		body_array[i]->post_integrate_velocities(); // may remove the body from the active list
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -296,4 +353,15 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 StepSW::StepSW() {
 
 	_step = 1;
+	delta = 0;
+	iterations = 0;
+
+	if (GLOBAL_GET("physics/3d/godot_physics/threaded_step")) {
+		work_pool.init();
+	}
+}
+
+StepSW::~StepSW() {
+
+	work_pool.finish();
 }
@@ -33,18 +33,41 @@
 
 #include "space_sw.h"
 
+#include "core/os/thread_work_pool.h"
+
 class StepSW {
 
+	enum {
+		THREADED_MIN_BODIES = 128, // below this, dispatching to the worker pool costs more than it saves
+		THREADED_MIN_CONSTRAINTS = 64,
+	};
+
 	uint64_t _step;
 
+	ThreadWorkPool work_pool;
+
+	real_t delta;
+	int iterations;
+
+	Vector<BodySW *> body_array;
+	Vector<ConstraintSW *> constraint_array;
+	Vector<ConstraintSW *> island_array;
+
 	void _populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island);
-	void _setup_island(ConstraintSW *p_island, real_t p_delta);
 	void _solve_island(ConstraintSW *p_island, int p_iterations, real_t p_delta);
 	void _check_suspend(BodySW *p_island, real_t p_delta);
 
+	void _integrate_forces(uint32_t p_index, void *p_userdata);
+	void _integrate_velocities(uint32_t p_index, void *p_userdata);
+	void _setup_constraint(uint32_t p_index, void *p_userdata);
+	void _solve_island_work(uint32_t p_index, void *p_userdata);
+	void _dispatch(uint32_t p_count, bool p_threaded, void (StepSW::*p_method)(uint32_t, void *));
+	void _fill_body_array(const SelfList<BodySW>::List *p_body_list);
+
 public:
 	void step(SpaceSW *p_space, real_t p_delta, int p_iterations);
 	StepSW();
+	~StepSW();
 };
 
 #endif // STEP__SW_H
@@ -79,6 +79,8 @@ class Body2DSW : public CollisionObject2DSW {
 	bool active;
 	bool can_sleep;
 	bool first_time_kinematic;
+	bool motion_pending;
+	Vector2 pending_motion;
 	bool first_integration;
 	void _update_inertia();
 	virtual void _shapes_changed();
@@ -273,8 +275,12 @@ public:
 	_FORCE_INLINE_ real_t get_linear_damp() const { return linear_damp; }
 	_FORCE_INLINE_ real_t get_angular_damp() const { return angular_damp; }
 
+	// The integrate functions only modify the body itself, so different bodies can be integrated on different threads.
+	// The broadphase and the space lists are updated afterwards by the post_integrate functions, which must run serially.
 	void integrate_forces(real_t p_step);
+	void post_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void post_integrate_velocities();
 
 	_FORCE_INLINE_ Vector2 get_motion() const {
 
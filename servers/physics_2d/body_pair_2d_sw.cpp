@@ -240,12 +240,14 @@ bool BodyPair2DSW::setup(real_t p_step) {
 		return false;
 	}
 
+	dynamic_A = A->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC;
+	dynamic_B = B->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC;
+
 	//use local A coordinates to avoid numerical issues on collision detection
 	offset_B = B->get_transform().get_origin() - A->get_transform().get_origin();
 
 	_validate_contacts();
 
-	Vector2 offset_A = A->get_transform().get_origin();
 	Transform2D xform_Au = A->get_transform().untranslated();
 	Transform2D xform_A = xform_Au * A->get_shape_transform(shape_A);
 
@@ -341,6 +343,19 @@ bool BodyPair2DSW::setup(real_t p_step) {
 		}
 	}
 
+	return true;
+}
+
+bool BodyPair2DSW::pre_solve(real_t p_step) {
+
+	Vector2 offset_A = A->get_transform().get_origin();
+	Transform2D xform_Au = A->get_transform().untranslated();
+	Transform2D xform_Bu = B->get_transform();
+	xform_Bu.elements[2] -= offset_A;
+
+	Shape2DSW *shape_A_ptr = A->get_shape(shape_A);
+	Shape2DSW *shape_B_ptr = B->get_shape(shape_B);
+
 	real_t max_penetration = space->get_contact_max_allowed_penetration();
 
 	real_t bias = 0.3;
@@ -434,8 +449,10 @@ bool BodyPair2DSW::setup(real_t p_step) {
 			// Apply normal + friction impulse
 			Vector2 P = c.acc_normal_impulse * c.normal + c.acc_tangent_impulse * tangent;
 
-			A->apply_impulse(c.rA, -P);
-			B->apply_impulse(c.rB, P);
+			if (dynamic_A)
+				A->apply_impulse(c.rA, -P);
+			if (dynamic_B)
+				B->apply_impulse(c.rB, P);
 		}
 
 #endif
@@ -489,8 +506,10 @@ void BodyPair2DSW::solve(real_t p_step) {
 
 		Vector2 jb = c.normal * (c.acc_bias_impulse - jbnOld);
 
-		A->apply_bias_impulse(c.rA, -jb);
-		B->apply_bias_impulse(c.rB, jb);
+		if (dynamic_A)
+			A->apply_bias_impulse(c.rA, -jb);
+		if (dynamic_B)
+			B->apply_bias_impulse(c.rB, jb);
 
 		real_t jn = -(c.bounce + vn) * c.mass_normal;
 		real_t jnOld = c.acc_normal_impulse;
@@ -505,8 +524,10 @@ void BodyPair2DSW::solve(real_t p_step) {
 
 		Vector2 j = c.normal * (c.acc_normal_impulse - jnOld) + tangent * (c.acc_tangent_impulse - jtOld);
 
-		A->apply_impulse(c.rA, -j);
-		B->apply_impulse(c.rB, j);
+		if (dynamic_A)
+			A->apply_impulse(c.rA, -j);
+		if (dynamic_B)
+			B->apply_impulse(c.rB, j);
 	}
 }
 
@@ -523,6 +544,8 @@ BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_sh
 	contact_count = 0;
 	collided = false;
 	oneway_disabled = false;
+	dynamic_A = false;
+	dynamic_B = false;
 }
 
 BodyPair2DSW::~BodyPair2DSW() {
@@ -72,6 +72,7 @@ public:
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
 	virtual bool setup(real_t p_step) = 0;
+	virtual bool pre_solve(real_t p_step) { return true; } // runs serially after a successful setup(), may modify objects shared with other islands, returns false if there is nothing to solve
 	virtual void solve(real_t p_step) = 0;
 
 	virtual ~Constraint2DSW() {}
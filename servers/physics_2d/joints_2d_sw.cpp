@@ -91,6 +91,9 @@ normal_relative_velocity(Body2DSW *a, Body2DSW *b, Vector2 rA, Vector2 rB, Vecto
 
 bool PinJoint2DSW::setup(real_t p_step) {
 
+	dynamic_A = (A->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B && B->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC);
+
 	Space2DSW *space = A->get_space();
 	ERR_FAIL_COND_V(!space, false);
 	rA = A->get_transform().basis_xform(anchor_A);
@@ -138,9 +141,15 @@ bool PinJoint2DSW::setup(real_t p_step) {
 
 	bias = delta * -(get_bias() == 0 ? space->get_constraint_bias() : get_bias()) * (1.0 / p_step);
 
+	return true;
+}
+
+bool PinJoint2DSW::pre_solve(real_t p_step) {
+
 	// apply accumulated impulse
-	A->apply_impulse(rA, -P);
-	if (B)
+	if (dynamic_A)
+		A->apply_impulse(rA, -P);
+	if (dynamic_B)
 		B->apply_impulse(rB, P);
 
 	return true;
@@ -164,8 +173,9 @@ void PinJoint2DSW::solve(real_t p_step) {
 
 	Vector2 impulse = M.basis_xform(bias - rel_vel - Vector2(softness, softness) * P);
 
-	A->apply_impulse(rA, -impulse);
-	if (B)
+	if (dynamic_A)
+		A->apply_impulse(rA, -impulse);
+	if (dynamic_B)
 		B->apply_impulse(rB, impulse);
 
 	P += impulse;
@@ -260,6 +270,9 @@ mult_k(const Vector2 &vr, const Vector2 &k1, const Vector2 &k2) {
 
 bool GrooveJoint2DSW::setup(real_t p_step) {
 
+	dynamic_A = (A->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC);
+
 	// calculate endpoints in worldspace
 	Vector2 ta = A->get_transform().xform(A_groove_1);
 	Vector2 tb = A->get_transform().xform(A_groove_2);
@@ -302,11 +315,18 @@ bool GrooveJoint2DSW::setup(real_t p_step) {
 	real_t _b = get_bias();
 	gbias = (delta * -(_b == 0 ? space->get_constraint_bias() : _b) * (1.0 / p_step)).clamped(get_max_bias());
 
+	correct = true;
+	return true;
+}
+
+bool GrooveJoint2DSW::pre_solve(real_t p_step) {
+
 	// apply accumulated impulse
-	A->apply_impulse(rA, -jn_acc);
-	B->apply_impulse(rB, jn_acc);
+	if (dynamic_A)
+		A->apply_impulse(rA, -jn_acc);
+	if (dynamic_B)
+		B->apply_impulse(rB, jn_acc);
 
-	correct = true;
 	return true;
 }
 
@@ -323,8 +343,10 @@ void GrooveJoint2DSW::solve(real_t p_step) {
 
 	j = jn_acc - jOld;
 
-	A->apply_impulse(rA, -j);
-	B->apply_impulse(rB, j);
+	if (dynamic_A)
+		A->apply_impulse(rA, -j);
+	if (dynamic_B)
+		B->apply_impulse(rB, j);
 }
 
 GrooveJoint2DSW::GrooveJoint2DSW(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, Body2DSW *p_body_a, Body2DSW *p_body_b) :
@@ -354,6 +376,9 @@ GrooveJoint2DSW::~GrooveJoint2DSW() {
 
 bool DampedSpringJoint2DSW::setup(real_t p_step) {
 
+	dynamic_A = (A->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC);
+
 	rA = A->get_transform().basis_xform(anchor_A);
 	rB = B->get_transform().basis_xform(anchor_B);
 
@@ -371,12 +396,20 @@ bool DampedSpringJoint2DSW::setup(real_t p_step) {
 	target_vrn = 0.0f;
 	v_coef = 1.0f - Math::exp(-damping * (p_step)*k);
 
-	// apply spring force
+	// spring force, applied in pre_solve()
 	real_t f_spring = (rest_length - dist) * stiffness;
-	Vector2 j = n * f_spring * (p_step);
+	spring_impulse = n * f_spring * (p_step);
 
-	A->apply_impulse(rA, -j);
-	B->apply_impulse(rB, j);
+	return true;
+}
+
+bool DampedSpringJoint2DSW::pre_solve(real_t p_step) {
+
+	// apply spring force
+	if (dynamic_A)
+		A->apply_impulse(rA, -spring_impulse);
+	if (dynamic_B)
+		B->apply_impulse(rB, spring_impulse);
 
 	return true;
 }
@@ -392,8 +425,10 @@ void DampedSpringJoint2DSW::solve(real_t p_step) {
 	target_vrn = vrn + v_damp;
 	Vector2 j = n * v_damp * n_mass;
 
-	A->apply_impulse(rA, -j);
-	B->apply_impulse(rB, j);
+	if (dynamic_A)
+		A->apply_impulse(rA, -j);
+	if (dynamic_B)
+		B->apply_impulse(rB, j);
 }
 
 void DampedSpringJoint2DSW::set_param(Physics2DServer::DampedStringParam p_param, real_t p_value) {
@@ -69,6 +69,9 @@ class PinJoint2DSW : public Joint2DSW {
 		Body2DSW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	Transform2D M;
 	Vector2 rA, rB;
 	Vector2 anchor_A;
@@ -81,6 +84,7 @@ public:
 	virtual Physics2DServer::JointType get_type() const { return Physics2DServer::JOINT_PIN; }
 
 	virtual bool setup(real_t p_step);
+	virtual bool pre_solve(real_t p_step);
 	virtual void solve(real_t p_step);
 
 	void set_param(Physics2DServer::PinJointParam p_param, real_t p_value);
@@ -101,6 +105,9 @@ class GrooveJoint2DSW : public Joint2DSW {
 		Body2DSW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	Vector2 A_groove_1;
 	Vector2 A_groove_2;
 	Vector2 A_groove_normal;
@@ -119,6 +126,7 @@ public:
 	virtual Physics2DServer::JointType get_type() const { return Physics2DServer::JOINT_GROOVE; }
 
 	virtual bool setup(real_t p_step);
+	virtual bool pre_solve(real_t p_step);
 	virtual void solve(real_t p_step);
 
 	GrooveJoint2DSW(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, Body2DSW *p_body_a, Body2DSW *p_body_b);
@@ -136,6 +144,9 @@ class DampedSpringJoint2DSW : public Joint2DSW {
 		Body2DSW *_arr[2];
 	};
 
+	bool dynamic_A;
+	bool dynamic_B;
+
 	Vector2 anchor_A;
 	Vector2 anchor_B;
 
@@ -148,11 +159,13 @@ class DampedSpringJoint2DSW : public Joint2DSW {
 	real_t n_mass;
 	real_t target_vrn;
 	real_t v_coef;
+	Vector2 spring_impulse;
 
 public:
 	virtual Physics2DServer::JointType get_type() const { return Physics2DServer::JOINT_DAMPED_SPRING; }
 
 	virtual bool setup(real_t p_step);
+	virtual bool pre_solve(real_t p_step);
 	virtual void solve(real_t p_step);
 
 	void set_param(Physics2DServer::DampedStringParam p_param, real_t p_value);
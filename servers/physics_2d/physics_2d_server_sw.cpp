@@ -242,8 +242,8 @@ bool Physics2DServerSW::shape_collide(RID p_shape_A, const Transform2D &p_xform_
 
 RID Physics2DServerSW::space_create() {
 
-	Space2DSW *space = memnew(Space2DSW);
-	RID id = space_owner.make_rid(space);
+	RID id = space_owner.make_rid();
+	Space2DSW *space = space_owner.get(id);
 	space->set_self(id);
 	RID area_id = area_create();
 	Area2DSW *area = area_owner.get(area_id);
@@ -320,8 +320,8 @@ Physics2DDirectSpaceState *Physics2DServerSW::space_get_direct_state(RID p_space
 
 RID Physics2DServerSW::area_create() {
 
-	Area2DSW *area = memnew(Area2DSW);
-	RID rid = area_owner.make_rid(area);
+	RID rid = area_owner.make_rid();
+	Area2DSW *area = area_owner.get(rid);
 	area->set_self(rid);
 	return rid;
 };
@@ -585,8 +585,8 @@ void Physics2DServerSW::area_set_area_monitor_callback(RID p_area, Object *p_rec
 
 RID Physics2DServerSW::body_create() {
 
-	Body2DSW *body = memnew(Body2DSW);
-	RID rid = body_owner.make_rid(body);
+	RID rid = body_owner.make_rid();
+	Body2DSW *body = body_owner.get(rid);
 	body->set_self(rid);
 	return rid;
 }
@@ -1264,7 +1264,6 @@ void Physics2DServerSW::free(RID p_rid) {
 		}
 
 		body_owner.free(p_rid);
-		memdelete(body);
 
 	} else if (area_owner.owns(p_rid)) {
 
@@ -1283,7 +1282,6 @@ void Physics2DServerSW::free(RID p_rid) {
 		}
 
 		area_owner.free(p_rid);
-		memdelete(area);
 	} else if (space_owner.owns(p_rid)) {
 
 		Space2DSW *space = space_owner.get(p_rid);
@@ -1296,7 +1294,6 @@ void Physics2DServerSW::free(RID p_rid) {
 		active_spaces.erase(space);
 		free(space->get_default_area()->get_self());
 		space_owner.free(p_rid);
-		memdelete(space);
 	} else if (joint_owner.owns(p_rid)) {
 
 		Joint2DSW *joint = joint_owner.get(p_rid);
@@ -1447,6 +1444,7 @@ Physics2DServerSW *Physics2DServerSW::singletonsw = NULL;
 Physics2DServerSW::Physics2DServerSW() {
 
 	singletonsw = this;
+	GLOBAL_DEF("physics/2d/threaded_step", true);
 	BroadPhase2DSW::create_func = BroadPhase2DHashGrid::_create;
 	//BroadPhase2DSW::create_func=BroadPhase2DBasic::_create;
 
@@ -30,6 +30,7 @@
 
 #include "step_2d_sw.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
 
@@ -57,43 +58,6 @@ void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constrain
 	}
 }
 
-bool Step2DSW::_setup_island(Constraint2DSW *p_island, real_t p_delta) {
-
-	Constraint2DSW *ci = p_island;
-	Constraint2DSW *prev_ci = NULL;
-	bool removed_root = false;
-	while (ci) {
-		bool process = ci->setup(p_delta);
-
-		if (!process) {
-			//remove from island if process fails
-			if (prev_ci) {
-				prev_ci->set_island_next(ci->get_island_next());
-			} else {
-				removed_root = true;
-				prev_ci = ci;
-			}
-		} else {
-			prev_ci = ci;
-		}
-		ci = ci->get_island_next();
-	}
-
-	return removed_root;
-}
-
-void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta) {
-
-	for (int i = 0; i < p_iterations; i++) {
-
-		Constraint2DSW *ci = p_island;
-		while (ci) {
-			ci->solve(p_delta);
-			ci = ci->get_island_next();
-		}
-	}
-}
-
 void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -131,12 +95,67 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 	}
 }
 
+void Step2DSW::_integrate_forces(uint32_t p_index, void *p_userdata) {
+
+	body_array[p_index]->integrate_forces(delta);
+}
+
+void Step2DSW::_integrate_velocities(uint32_t p_index, void *p_userdata) {
+
+	body_array[p_index]->integrate_velocities(delta);
+}
+
+void Step2DSW::_setup_constraint(uint32_t p_index, void *p_userdata) {
+
+	constraint_setup.write[p_index] = constraint_array[p_index]->setup(delta);
+}
+
+void Step2DSW::_solve_island(uint32_t p_index, void *p_userdata) {
+
+	const Island &island = island_array[p_index];
+	Constraint2DSW *const *constraints = &constraint_array.ptr()[island.first];
+
+	for (int i = 0; i < iterations; i++) {
+		for (int j = 0; j < island.count; j++) {
+			constraints[j]->solve(delta);
+		}
+	}
+}
+
+void Step2DSW::_dispatch(uint32_t p_count, bool p_threaded, void (Step2DSW::*p_method)(uint32_t, void *)) {
+
+	if (p_threaded && work_pool.is_threaded()) {
+		work_pool.do_work(p_count, this, p_method, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, NULL);
+		}
+	}
+}
+
+void Step2DSW::_fill_body_array(const SelfList<Body2DSW>::List *p_body_list) {
+
+	int count = 0;
+	for (const SelfList<Body2DSW> *b = p_body_list->first(); b; b = b->next()) {
+		count++;
+	}
+
+	body_array.resize(count); // keeps the allocation from the previous step when the count doesn't change
+	Body2DSW **bodies = body_array.ptrw();
+	for (const SelfList<Body2DSW> *b = p_body_list->first(); b; b = b->next()) {
+		*bodies++ = b->self();
+	}
+}
+
 void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
 
+	delta = p_delta;
+	iterations = p_iterations;
+
 	const SelfList<Body2DSW>::List *body_list = &p_space->get_active_body_list();
 
 	/* INTEGRATE FORCES */
@@ -144,14 +163,13 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_body_array(body_list);
+	int active_count = body_array.size();
 
-	const SelfList<Body2DSW> *b = body_list->first();
-	while (b) {
+	_dispatch(active_count, active_count >= THREADED_MIN_BODIES, &Step2DSW::_integrate_forces);
 
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	for (int i = 0; i < active_count; i++) {
+		body_array[i]->post_integrate_forces(); // moves the broadphase, not thread safe
 	}
 
 	p_space->set_active_objects(active_count);
@@ -166,7 +184,7 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	Body2DSW *island_list = NULL;
 	Constraint2DSW *constraint_island_list = NULL;
-	b = body_list->first();
+	const SelfList<Body2DSW> *b = body_list->first();
 
 	int island_count = 0;
 
@@ -209,6 +227,33 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 		p_space->area_remove_from_moved_list((SelfList<Area2DSW> *)aml.first()); //faster to remove here
 	}
 
+	// flatten the islands, so they can be processed by index
+	int constraint_count = 0;
+	int total_island_count = 0; // includes the area islands
+	for (Constraint2DSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+		total_island_count++;
+		for (Constraint2DSW *c = ci; c; c = c->get_island_next()) {
+			constraint_count++;
+		}
+	}
+
+	constraint_array.resize(constraint_count);
+	constraint_setup.resize(constraint_count);
+	island_array.resize(total_island_count);
+	{
+		Constraint2DSW **constraints = constraint_array.ptrw();
+		Island *islands = island_array.ptrw();
+		int index = 0;
+		for (Constraint2DSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+			islands->first = index;
+			for (Constraint2DSW *c = ci; c; c = c->get_island_next()) {
+				constraints[index++] = c;
+			}
+			islands->count = index - islands->first;
+			islands++;
+		}
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(Space2DSW::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
@@ -217,42 +262,38 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	// setup() only runs the narrowphase and touches nothing but the constraint itself, so all constraints
+	// can be set up at once; whatever touches bodies or areas shared between islands is done in pre_solve()
+	_dispatch(constraint_count, constraint_count >= THREADED_MIN_CONSTRAINTS, &Step2DSW::_setup_constraint);
+
 	{
-		Constraint2DSW *ci = constraint_island_list;
-		Constraint2DSW *prev_ci = NULL;
-		while (ci) {
-
-			if (_setup_island(ci, p_delta)) {
-
-				//removed the root from the island graph because it is not to be processed
-
-				Constraint2DSW *next = ci->get_island_next();
-
-				if (next) {
-					//root from list being deleted no longer exists, replace by next
-					next->set_island_list_next(ci->get_island_list_next());
-					if (prev_ci) {
-						prev_ci->set_island_list_next(next);
-					} else {
-						constraint_island_list = next;
-					}
-					prev_ci = next;
-				} else {
-
-					//list is empty, just skip
-					if (prev_ci) {
-						prev_ci->set_island_list_next(ci->get_island_list_next());
-
-					} else {
-						constraint_island_list = ci->get_island_list_next();
-					}
+		// remove the constraints that don't need solving, and the islands left empty
+		Constraint2DSW **constraints = constraint_array.ptrw();
+		const bool *setup = constraint_setup.ptr();
+		Island *islands = island_array.ptrw();
+		int valid_islands = 0;
+		int valid_constraints = 0;
+
+		for (int i = 0; i < total_island_count; i++) {
+
+			const Island &island = islands[i];
+			int first = valid_constraints;
+
+			for (int j = island.first; j < island.first + island.count; j++) {
+				if (setup[j] && constraints[j]->pre_solve(p_delta)) {
+					constraints[valid_constraints++] = constraints[j];
 				}
-			} else {
-				prev_ci = ci;
 			}
 
-			ci = ci->get_island_list_next();
+			if (valid_constraints > first) {
+				islands[valid_islands].first = first;
+				islands[valid_islands].count = valid_constraints - first;
+				valid_islands++;
+			}
 		}
+
+		total_island_count = valid_islands;
+		constraint_count = valid_constraints;
 	}
 
 	{ //profile
@@ -263,14 +304,9 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
-		Constraint2DSW *ci = constraint_island_list;
-		while (ci) {
-			//iterating each island separatedly improves cache efficiency
-			_solve_island(ci, p_iterations, p_delta);
-			ci = ci->get_island_list_next();
-		}
-	}
+	// islands don't share dynamic bodies, so each one can be solved on its own thread
+	// (iterating each island separatedly also improves cache efficiency)
+	_dispatch(total_island_count, constraint_count >= THREADED_MIN_CONSTRAINTS, &Step2DSW::_solve_island);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -280,12 +316,13 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
+	_fill_body_array(body_list); // pre_solve() may have woken up bodies
+	active_count = body_array.size();
 
-		const SelfList<Body2DSW> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	_dispatch(active_count, active_count >= THREADED_MIN_BODIES, &Step2DSW::_integrate_velocities);
+
+	for (int i = 0; i < active_count; i++) {
+		body_array[i]->post_integrate_velocities(); // may remove the body from the active list
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -313,4 +350,16 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 Step2DSW::Step2DSW() {
 
 	_step = 1;
+	delta = 0;
+	iterations = 0;
+
+	// also fine when the server runs on its own thread (physics/2d/thread_model), the pool is driven from whichever thread steps
+	if (GLOBAL_GET("physics/2d/threaded_step")) {
+		work_pool.init();
+	}
+}
+
+Step2DSW::~Step2DSW() {
+
+	work_pool.finish();
 }
@@ -33,18 +33,46 @@
 
 #include "space_2d_sw.h"
 
+#include "core/os/thread_work_pool.h"
+
 class Step2DSW {
 
+	enum {
+		THREADED_MIN_BODIES = 128, // below this, dispatching to the worker pool costs more than it saves
+		THREADED_MIN_CONSTRAINTS = 64,
+	};
+
+	struct Island {
+		int first; // range in constraint_array
+		int count;
+	};
+
 	uint64_t _step;
 
+	ThreadWorkPool work_pool;
+
+	real_t delta;
+	int iterations;
+
+	Vector<Body2DSW *> body_array;
+	Vector<Constraint2DSW *> constraint_array;
+	Vector<bool> constraint_setup;
+	Vector<Island> island_array;
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
-	bool _setup_island(Constraint2DSW *p_island, real_t p_delta);
-	void _solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta);
 	void _check_suspend(Body2DSW *p_island, real_t p_delta);
 
+	void _integrate_forces(uint32_t p_index, void *p_userdata);
+	void _integrate_velocities(uint32_t p_index, void *p_userdata);
+	void _setup_constraint(uint32_t p_index, void *p_userdata);
+	void _solve_island(uint32_t p_index, void *p_userdata);
+	void _dispatch(uint32_t p_count, bool p_threaded, void (Step2DSW::*p_method)(uint32_t, void *));
+	void _fill_body_array(const SelfList<Body2DSW>::List *p_body_list);
+
 public:
 	void step(Space2DSW *p_space, real_t p_delta, int p_iterations);
 	Step2DSW();
+	~Step2DSW();
 };
 
 #endif // STEP_2D_SW_H
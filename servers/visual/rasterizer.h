@@ -325,6 +325,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const = 0;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array) = 0;
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) = 0;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) = 0;
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const = 0;
@@ -697,6 +698,7 @@ public:
 			};
 
 			Type type;
+			Command *next; // next command of the same item, in drawing order
 			virtual ~Command() {}
 		};
 
@@ -851,7 +853,8 @@ public:
 		bool update_when_visible;
 		//VS::MaterialBlendMode blend_mode;
 		int light_mask;
-		Vector<Command *> commands;
+		Command *commands;
+		Command *last_command;
 		mutable bool custom_rect;
 		mutable bool rect_dirty;
 		mutable Rect2 rect;
@@ -883,8 +886,7 @@ public:
 				return rect;
 
 			//must update rect
-			int s = commands.size();
-			if (s == 0) {
+			if (!commands) {
 
 				rect = Rect2();
 				rect_dirty = false;
@@ -895,11 +897,8 @@ public:
 			bool found_xform = false;
 			bool first = true;
 
-			const Item::Command *const *cmd = &commands[0];
+			for (const Item::Command *c = commands; c; c = c->next) {
 
-			for (int i = 0; i < s; i++) {
-
-				const Item::Command *c = cmd[i];
 				Rect2 r;
 
 				switch (c->type) {
@@ -1023,10 +1022,91 @@ public:
 			return rect;
 		}
 
+		// commands are built in place in blocks owned by the item, clearing keeps the blocks for the next redraw
+		struct CommandBlock {
+
+			CommandBlock *next;
+			uint32_t size;
+			uint32_t used;
+
+			_FORCE_INLINE_ uint8_t *get_data() { return ((uint8_t *)this) + DATA_OFFSET; }
+
+			enum {
+				DATA_OFFSET = (sizeof(CommandBlock *) + sizeof(uint32_t) * 2 + 15) & ~15,
+				MIN_SIZE = 1024,
+				MAX_SIZE = 16384
+			};
+		};
+
+		CommandBlock *command_blocks;
+		CommandBlock *current_block;
+
+		void *_alloc_command_memory(uint32_t p_size) {
+
+			p_size = (p_size + 15) & ~15;
+
+			if (!current_block || current_block->used + p_size > current_block->size) {
+
+				CommandBlock *next = current_block ? current_block->next : command_blocks;
+
+				if (!next || next->size < p_size) {
+					// each new block twice the size of the last one, the ones left after it are dropped
+					uint32_t size = current_block ? MIN(current_block->size * 2, (uint32_t)CommandBlock::MAX_SIZE) : (uint32_t)CommandBlock::MIN_SIZE;
+					size = MAX(size, p_size);
+					CommandBlock *block = (CommandBlock *)memalloc(CommandBlock::DATA_OFFSET + size);
+					block->size = size;
+					block->next = NULL;
+					_free_command_blocks(next);
+					if (current_block) {
+						current_block->next = block;
+					} else {
+						command_blocks = block;
+					}
+					next = block;
+				}
+
+				current_block = next;
+				current_block->used = 0;
+			}
+
+			void *mem = current_block->get_data() + current_block->used;
+			current_block->used += p_size;
+			return mem;
+		}
+
+		static void _free_command_blocks(CommandBlock *p_block) {
+
+			while (p_block) {
+				CommandBlock *next = p_block->next;
+				memfree(p_block);
+				p_block = next;
+			}
+		}
+
+		template <class T>
+		T *alloc_command() {
+
+			T *command = memnew_placement(_alloc_command_memory(sizeof(T)), T);
+			command->next = NULL;
+			if (last_command) {
+				last_command->next = command;
+			} else {
+				commands = command;
+			}
+			last_command = command;
+			return command;
+		}
+
 		void clear() {
-			for (int i = 0; i < commands.size(); i++)
-				memdelete(commands[i]);
-			commands.clear();
+			Command *c = commands;
+			while (c) {
+				Command *next = c->next;
+				c->~Command();
+				c = next;
+			}
+			commands = NULL;
+			last_command = NULL;
+			current_block = NULL;
 			clip = false;
 			rect_dirty = true;
 			final_clip_owner = NULL;
@@ -1034,6 +1114,10 @@ public:
 			light_masked = false;
 		}
 		Item() {
+			commands = NULL;
+			last_command = NULL;
+			command_blocks = NULL;
+			current_block = NULL;
 			light_mask = 1;
 			vp_render = NULL;
 			next = NULL;
@@ -1052,6 +1136,7 @@ public:
 		}
 		virtual ~Item() {
 			clear();
+			_free_command_blocks(command_blocks);
 			if (copy_back_buffer) memdelete(copy_back_buffer);
 		}
 	};
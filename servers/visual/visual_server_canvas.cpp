@@ -45,31 +45,82 @@ void VisualServerCanvas::_render_canvas_item_tree(Item *p_canvas_item, const Tra
 	for (int i = 0; i < z_range; i++) {
 		if (!z_list[i])
 			continue;
-		VSG::canvas_render->canvas_render_items(z_list[i], VS::CANVAS_ITEM_Z_MIN + i, p_modulate, p_lights, p_transform);
+		RasterizerCanvas::Item *list = batcher.batch_items(z_list[i], VS::CANVAS_ITEM_Z_MIN + i, p_lights);
+		VSG::canvas_render->canvas_render_items(list, VS::CANVAS_ITEM_Z_MIN + i, p_modulate, p_lights, p_transform);
 	}
 }
 
-void _collect_ysort_children(VisualServerCanvas::Item *p_canvas_item, Transform2D p_transform, VisualServerCanvas::Item *p_material_owner, const Color p_modulate, VisualServerCanvas::Item **r_items, int &r_index) {
+void _collect_ysort_children(VisualServerCanvas::Item *p_canvas_item, int p_parent, Vector<VisualServerCanvas::Item *> &r_items, Vector<int> &r_parents) {
 	int child_item_count = p_canvas_item->child_items.size();
 	VisualServerCanvas::Item **child_items = p_canvas_item->child_items.ptrw();
 	for (int i = 0; i < child_item_count; i++) {
 		if (child_items[i]->visible) {
-			if (r_items) {
-				r_items[r_index] = child_items[i];
-				child_items[i]->ysort_modulate = p_modulate;
-				child_items[i]->ysort_xform = p_transform;
-				child_items[i]->ysort_pos = p_transform.xform(child_items[i]->xform.elements[2]);
-				child_items[i]->material_owner = child_items[i]->use_parent_material ? p_material_owner : NULL;
-			}
-
-			r_index++;
+			int index = r_items.size();
+			r_items.push_back(child_items[i]);
+			r_parents.push_back(p_parent);
 
 			if (child_items[i]->sort_y)
-				_collect_ysort_children(child_items[i],
-						p_transform * child_items[i]->xform,
-						child_items[i]->use_parent_material ? p_material_owner : child_items[i],
-						p_modulate * child_items[i]->modulate,
-						r_items, r_index);
+				_collect_ysort_children(child_items[i], index, r_items, r_parents);
+		}
+	}
+}
+
+void _update_ysort_children(VisualServerCanvas::Item *p_canvas_item, VisualServerCanvas::Item *p_material_owner) {
+
+	// the hierarchy is only collected again when it changed, transforms are refreshed every time
+	if (p_canvas_item->ysort_children_count == -1) {
+		p_canvas_item->ysort_items.clear();
+		p_canvas_item->ysort_parents.clear();
+		_collect_ysort_children(p_canvas_item, -1, p_canvas_item->ysort_items, p_canvas_item->ysort_parents);
+		p_canvas_item->ysort_children_count = p_canvas_item->ysort_items.size();
+		p_canvas_item->ysort_order = p_canvas_item->ysort_items;
+	}
+
+	int count = p_canvas_item->ysort_children_count;
+	VisualServerCanvas::Item **items = p_canvas_item->ysort_items.ptrw();
+	const int *parents = p_canvas_item->ysort_parents.ptr();
+
+	for (int i = 0; i < count; i++) {
+
+		VisualServerCanvas::Item *item = items[i];
+
+		if (parents[i] < 0) {
+			item->ysort_xform = Transform2D();
+			item->ysort_modulate = Color(1, 1, 1, 1);
+			item->material_owner = item->use_parent_material ? p_material_owner : NULL;
+		} else {
+			// parents come first, so theirs are up to date already
+			VisualServerCanvas::Item *parent = items[parents[i]];
+			item->ysort_xform = parent->ysort_xform * parent->xform;
+			item->ysort_modulate = parent->ysort_modulate * parent->modulate;
+			RasterizerCanvas::Item *material_owner = parent->use_parent_material ? parent->material_owner : parent;
+			item->material_owner = item->use_parent_material ? material_owner : NULL;
+		}
+
+		item->ysort_pos = item->ysort_xform.xform(item->xform.elements[2]);
+	}
+
+	// the order drawn last time is nearly sorted when only some items moved, so an insertion
+	// sort is close to linear. if too much moved it falls back to sorting from scratch
+	VisualServerCanvas::Item **order = p_canvas_item->ysort_order.ptrw();
+	VisualServerCanvas::ItemPtrSort compare;
+	int moves_left = count * 4;
+
+	for (int i = 1; i < count; i++) {
+
+		VisualServerCanvas::Item *item = order[i];
+		int j = i;
+		while (j > 0 && compare(item, order[j - 1])) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = item;
+
+		moves_left -= i - j;
+		if (moves_left < 0) {
+			SortArray<VisualServerCanvas::Item *, VisualServerCanvas::ItemPtrSort> sorter;
+			sorter.sort(order, count);
+			break;
 		}
 	}
 }
@@ -128,19 +179,10 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 
 	if (ci->sort_y) {
 
-		if (ci->ysort_children_count == -1) {
-			ci->ysort_children_count = 0;
-			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), NULL, ci->ysort_children_count);
-		}
+		_update_ysort_children(ci, p_material_owner);
 
 		child_item_count = ci->ysort_children_count;
-		child_items = (Item **)alloca(child_item_count * sizeof(Item *));
-
-		int i = 0;
-		_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i);
-
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+		child_items = ci->ysort_order.ptrw();
 	}
 
 	if (ci->z_relative)
@@ -168,7 +210,7 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 		VisualServerRaster::redraw_request();
 	}
 
-	if ((!ci->commands.empty() && p_clip_rect.intersects(global_rect)) || ci->vp_render || ci->copy_back_buffer) {
+	if ((ci->commands && p_clip_rect.intersects(global_rect)) || ci->vp_render || ci->copy_back_buffer) {
 		//something to draw?
 		ci->final_transform = xform;
 		ci->final_modulate = Color(modulate.r * ci->self_modulate.r, modulate.g * ci->self_modulate.g, modulate.b * ci->self_modulate.b, modulate.a * ci->self_modulate.a);
@@ -267,7 +309,8 @@ void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_tr
 				_light_mask_canvas_items(VS::CANVAS_ITEM_Z_MIN + i, z_list[i], p_masked_lights);
 			}
 
-			VSG::canvas_render->canvas_render_items(z_list[i], VS::CANVAS_ITEM_Z_MIN + i, p_canvas->modulate, p_lights, p_transform);
+			RasterizerCanvas::Item *list = batcher.batch_items(z_list[i], VS::CANVAS_ITEM_Z_MIN + i, p_lights);
+			VSG::canvas_render->canvas_render_items(list, VS::CANVAS_ITEM_Z_MIN + i, p_canvas->modulate, p_lights, p_transform);
 		}
 	} else {
 
@@ -340,10 +383,7 @@ void VisualServerCanvas::canvas_set_parent(RID p_canvas, RID p_parent, float p_s
 
 RID VisualServerCanvas::canvas_item_create() {
 
-	Item *canvas_item = memnew(Item);
-	ERR_FAIL_COND_V(!canvas_item, RID());
-
-	return canvas_item_owner.make_rid(canvas_item);
+	return canvas_item_owner.make_rid();
 }
 
 void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
@@ -478,16 +518,13 @@ void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandLine *line = memnew(Item::CommandLine);
-	ERR_FAIL_COND(!line);
+	Item::CommandLine *line = canvas_item->alloc_command<Item::CommandLine>();
 	line->color = p_color;
 	line->from = p_from;
 	line->to = p_to;
 	line->width = p_width;
 	line->antialiased = p_antialiased;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(line);
 }
 
 void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width, bool p_antialiased) {
@@ -496,8 +533,7 @@ void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPolyLine *pline = memnew(Item::CommandPolyLine);
-	ERR_FAIL_COND(!pline);
+	Item::CommandPolyLine *pline = canvas_item->alloc_command<Item::CommandPolyLine>();
 
 	pline->antialiased = p_antialiased;
 	pline->multiline = false;
@@ -572,7 +608,6 @@ void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point
 		}
 	}
 	canvas_item->rect_dirty = true;
-	canvas_item->commands.push_back(pline);
 }
 
 void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width, bool p_antialiased) {
@@ -581,8 +616,7 @@ void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPolyLine *pline = memnew(Item::CommandPolyLine);
-	ERR_FAIL_COND(!pline);
+	Item::CommandPolyLine *pline = canvas_item->alloc_command<Item::CommandPolyLine>();
 
 	pline->antialiased = false; //todo
 	pline->multiline = true;
@@ -596,7 +630,6 @@ void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	}
 
 	canvas_item->rect_dirty = true;
-	canvas_item->commands.push_back(pline);
 }
 
 void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
@@ -604,13 +637,10 @@ void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandRect *rect = memnew(Item::CommandRect);
-	ERR_FAIL_COND(!rect);
+	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	rect->modulate = p_color;
 	rect->rect = p_rect;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(rect);
 }
 
 void VisualServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
@@ -618,13 +648,10 @@ void VisualServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandCircle *circle = memnew(Item::CommandCircle);
-	ERR_FAIL_COND(!circle);
+	Item::CommandCircle *circle = canvas_item->alloc_command<Item::CommandCircle>();
 	circle->color = p_color;
 	circle->pos = p_pos;
 	circle->radius = p_radius;
-
-	canvas_item->commands.push_back(circle);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose, RID p_normal_map) {
@@ -632,8 +659,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandRect *rect = memnew(Item::CommandRect);
-	ERR_FAIL_COND(!rect);
+	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
 	rect->flags = 0;
@@ -660,7 +686,6 @@ void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	rect->texture = p_texture;
 	rect->normal_map = p_normal_map;
 	canvas_item->rect_dirty = true;
-	canvas_item->commands.push_back(rect);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, RID p_normal_map, bool p_clip_uv) {
@@ -668,8 +693,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const R
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandRect *rect = memnew(Item::CommandRect);
-	ERR_FAIL_COND(!rect);
+	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
 	rect->texture = p_texture;
@@ -708,8 +732,6 @@ void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const R
 	}
 
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(rect);
 }
 
 void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, VS::NinePatchAxisMode p_x_axis_mode, VS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate, RID p_normal_map) {
@@ -717,8 +739,7 @@ void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandNinePatch *style = memnew(Item::CommandNinePatch);
-	ERR_FAIL_COND(!style);
+	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	style->texture = p_texture;
 	style->normal_map = p_normal_map;
 	style->rect = p_rect;
@@ -732,16 +753,13 @@ void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	style->axis_x = p_x_axis_mode;
 	style->axis_y = p_y_axis_mode;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(style);
 }
 void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, float p_width, RID p_normal_map) {
 
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandPrimitive *prim = memnew(Item::CommandPrimitive);
-	ERR_FAIL_COND(!prim);
+	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	prim->texture = p_texture;
 	prim->normal_map = p_normal_map;
 	prim->points = p_points;
@@ -749,8 +767,6 @@ void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	prim->colors = p_colors;
 	prim->width = p_width;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(prim);
 }
 
 void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, RID p_normal_map, bool p_antialiased) {
@@ -768,8 +784,7 @@ void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	Vector<int> indices = Geometry::triangulate_polygon(p_points);
 	ERR_FAIL_COND_MSG(indices.empty(), "Invalid polygon data, triangulation failed.");
 
-	Item::CommandPolygon *polygon = memnew(Item::CommandPolygon);
-	ERR_FAIL_COND(!polygon);
+	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
 	polygon->texture = p_texture;
 	polygon->normal_map = p_normal_map;
 	polygon->points = p_points;
@@ -779,8 +794,6 @@ void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	polygon->count = indices.size();
 	polygon->antialiased = p_antialiased;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(polygon);
 }
 
 void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count, RID p_normal_map) {
@@ -811,8 +824,7 @@ void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector
 			count = indices.size();
 	}
 
-	Item::CommandPolygon *polygon = memnew(Item::CommandPolygon);
-	ERR_FAIL_COND(!polygon);
+	Item::CommandPolygon *polygon = canvas_item->alloc_command<Item::CommandPolygon>();
 	polygon->texture = p_texture;
 	polygon->normal_map = p_normal_map;
 	polygon->points = p_points;
@@ -824,8 +836,6 @@ void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector
 	polygon->count = count;
 	polygon->antialiased = false;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(polygon);
 }
 
 void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
@@ -833,11 +843,8 @@ void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transfo
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandTransform *tr = memnew(Item::CommandTransform);
-	ERR_FAIL_COND(!tr);
+	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	tr->xform = p_transform;
-
-	canvas_item->commands.push_back(tr);
 }
 
 void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture, RID p_normal_map) {
@@ -845,23 +852,19 @@ void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandMesh *m = memnew(Item::CommandMesh);
-	ERR_FAIL_COND(!m);
+	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	m->mesh = p_mesh;
 	m->texture = p_texture;
 	m->normal_map = p_normal_map;
 	m->transform = p_transform;
 	m->modulate = p_modulate;
-
-	canvas_item->commands.push_back(m);
 }
 void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture, RID p_normal) {
 
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandParticles *part = memnew(Item::CommandParticles);
-	ERR_FAIL_COND(!part);
+	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	part->particles = p_particles;
 	part->texture = p_texture;
 	part->normal_map = p_normal;
@@ -870,7 +873,6 @@ void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles,
 	VSG::storage->particles_request_process(p_particles);
 
 	canvas_item->rect_dirty = true;
-	canvas_item->commands.push_back(part);
 }
 
 void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture, RID p_normal_map) {
@@ -878,14 +880,12 @@ void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandMultiMesh *mm = memnew(Item::CommandMultiMesh);
-	ERR_FAIL_COND(!mm);
+	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	mm->multimesh = p_mesh;
 	mm->texture = p_texture;
 	mm->normal_map = p_normal_map;
 
 	canvas_item->rect_dirty = true;
-	canvas_item->commands.push_back(mm);
 }
 
 void VisualServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
@@ -893,11 +893,8 @@ void VisualServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
-	Item::CommandClipIgnore *ci = memnew(Item::CommandClipIgnore);
-	ERR_FAIL_COND(!ci);
+	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ci->ignore = p_ignore;
-
-	canvas_item->commands.push_back(ci);
 }
 void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 
@@ -1403,8 +1400,6 @@ bool VisualServerCanvas::free(RID p_rid) {
 
 		canvas_item_owner.free(p_rid);
 
-		memdelete(canvas_item);
-
 	} else if (canvas_light_owner.owns(p_rid)) {
 
 		RasterizerCanvas::Light *canvas_light = canvas_light_owner.get(p_rid);
@@ -32,6 +32,7 @@
 #define VISUALSERVERCANVAS_H
 
 #include "rasterizer.h"
+#include "visual_server_canvas_batcher.h"
 #include "visual_server_viewport.h"
 
 class VisualServerCanvas {
@@ -52,6 +53,9 @@ public:
 		Color ysort_modulate;
 		Transform2D ysort_xform;
 		Vector2 ysort_pos;
+		Vector<Item *> ysort_items; // visible descendants sorted with this item, parents first
+		Vector<int> ysort_parents; // index of each one's parent in ysort_items, -1 for children
+		Vector<Item *> ysort_order; // ysort_items in the order they were drawn last time
 
 		Vector<Item *> child_items;
 
@@ -156,6 +160,8 @@ public:
 
 	bool disable_scale;
 
+	VisualServerCanvasBatcher batcher;
+
 private:
 	void _render_canvas_item_tree(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights);
 	void _render_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
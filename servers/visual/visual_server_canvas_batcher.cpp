@@ -0,0 +1,354 @@
+/*************************************************************************/
+/*  visual_server_canvas_batcher.cpp                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "visual_server_canvas_batcher.h"
+
+#include "core/project_settings.h"
+
+typedef RasterizerCanvas::Item Item;
+
+int VisualServerCanvasBatcher::_get_quad_count(const Item *p_item, int p_z, RasterizerCanvas::Light *p_lights, RID &r_texture, RID &r_normal_map) const {
+
+	if (p_item->vp_render || p_item->copy_back_buffer || p_item->skeleton.is_valid() || p_item->distance_field || p_item->light_masked)
+		return -1;
+
+	const Item *material_owner = p_item->material_owner ? p_item->material_owner : p_item;
+	if (material_owner->material.is_valid())
+		return -1;
+
+	// the rasterizer skips the base pass of nearly transparent items
+	if (p_item->final_modulate.a <= 0.001)
+		return -1;
+
+	// lit items are drawn again for each light, so they are left whole
+	for (RasterizerCanvas::Light *light = p_lights; light; light = light->next_ptr) {
+		if (p_item->light_mask & light->item_mask && p_z >= light->z_min && p_z <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache))
+			return -1;
+	}
+
+	int quads = 0;
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+				if (rect->flags & (RasterizerCanvas::CANVAS_RECT_TILE | RasterizerCanvas::CANVAS_RECT_CLIP_UV))
+					return -1;
+
+				if (quads == 0) {
+					r_texture = rect->texture;
+					r_normal_map = rect->normal_map;
+				} else if (rect->texture != r_texture || rect->normal_map != r_normal_map) {
+					return -1;
+				}
+				quads++;
+			} break;
+			case Item::Command::TYPE_TRANSFORM: {
+			} break;
+			default: {
+				return -1;
+			}
+		}
+	}
+
+	return (quads > 0 && quads <= max_quads) ? quads : -1;
+}
+
+void VisualServerCanvasBatcher::_add_to_list(Item *p_item) {
+
+	p_item->next = NULL;
+	if (list_last) {
+		list_last->next = p_item;
+	} else {
+		list_first = p_item;
+	}
+	list_last = p_item;
+}
+
+VisualServerCanvasBatcher::Batch &VisualServerCanvasBatcher::_get_batch() {
+
+	if (batches_used == batches.size()) {
+		Batch batch;
+		batch.item = memnew(Item);
+		batch.polygon = batch.item->alloc_command<Item::CommandPolygon>();
+		batch.polygon->antialiased = false;
+		batches.push_back(batch);
+	}
+
+	return batches.write[batches_used++];
+}
+
+void VisualServerCanvasBatcher::_flush_run() {
+
+	if (!run_first)
+		return;
+
+	if (run_quads < 2) {
+		// a single rect is drawn the same way either way
+		_add_to_list(run_first);
+
+		run_first = NULL;
+		run_last = NULL;
+		run_quads = 0;
+		return;
+	}
+
+	Batch &batch = _get_batch();
+
+	Item::CommandPolygon *polygon = batch.polygon;
+	polygon->texture = run_texture;
+	polygon->normal_map = run_normal_map;
+	polygon->count = run_quads * 6;
+	polygon->points.resize(run_quads * 4);
+	polygon->uvs.resize(run_quads * 4);
+	polygon->colors.resize(run_quads * 4);
+	polygon->indices.resize(run_quads * 6);
+
+	Point2 *points = polygon->points.ptrw();
+	Point2 *uvs = polygon->uvs.ptrw();
+	Color *colors = polygon->colors.ptrw();
+	int *indices = polygon->indices.ptrw();
+
+	Size2 texpixel_size;
+	bool textured = false;
+	if (run_texture.is_valid()) {
+		int width = RasterizerStorage::base_singleton->texture_get_width(run_texture);
+		int height = RasterizerStorage::base_singleton->texture_get_height(run_texture);
+		if (width && height) {
+			texpixel_size = Size2(1.0 / width, 1.0 / height);
+			textured = true;
+		}
+	}
+
+	Rect2 global_rect = run_first->global_rect_cache;
+	int vertex = 0;
+
+	Item *ci = run_first;
+	while (true) {
+
+		// the next pointer is overwritten once the run is linked to the list
+		Item *next = ci->next;
+
+		Transform2D xform = ci->final_transform;
+		global_rect = global_rect.merge(ci->global_rect_cache);
+
+		for (const Item::Command *c = ci->commands; c; c = c->next) {
+
+			if (c->type == Item::Command::TYPE_TRANSFORM) {
+				xform = ci->final_transform * static_cast<const Item::CommandTransform *>(c)->xform;
+				continue;
+			}
+
+			// same vertices and uvs the rasterizers draw rects with
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+			Point2 *p = &points[vertex];
+			p[0] = rect->rect.position;
+			p[1] = rect->rect.position + Vector2(rect->rect.size.x, 0.0);
+			p[2] = rect->rect.position + rect->rect.size;
+			p[3] = rect->rect.position + Vector2(0.0, rect->rect.size.y);
+
+			if (rect->rect.size.x < 0) {
+				SWAP(p[0], p[1]);
+				SWAP(p[2], p[3]);
+			}
+			if (rect->rect.size.y < 0) {
+				SWAP(p[0], p[3]);
+				SWAP(p[1], p[2]);
+			}
+
+			Point2 *uv = &uvs[vertex];
+			Rect2 src_rect = (textured && rect->flags & RasterizerCanvas::CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+			uv[0] = src_rect.position;
+			uv[1] = src_rect.position + Vector2(src_rect.size.x, 0.0);
+			uv[2] = src_rect.position + src_rect.size;
+			uv[3] = src_rect.position + Vector2(0.0, src_rect.size.y);
+
+			if (textured) {
+				if (rect->flags & RasterizerCanvas::CANVAS_RECT_TRANSPOSE) {
+					SWAP(uv[1], uv[3]);
+				}
+				if (rect->flags & RasterizerCanvas::CANVAS_RECT_FLIP_H) {
+					SWAP(uv[0], uv[1]);
+					SWAP(uv[2], uv[3]);
+				}
+				if (rect->flags & RasterizerCanvas::CANVAS_RECT_FLIP_V) {
+					SWAP(uv[0], uv[3]);
+					SWAP(uv[1], uv[2]);
+				}
+			}
+
+			Color color = rect->modulate * ci->final_modulate;
+
+			for (int i = 0; i < 4; i++) {
+				p[i] = xform.xform(p[i]);
+				colors[vertex + i] = color;
+			}
+
+			indices[0] = vertex;
+			indices[1] = vertex + 1;
+			indices[2] = vertex + 2;
+			indices[3] = vertex;
+			indices[4] = vertex + 2;
+			indices[5] = vertex + 3;
+			indices += 6;
+
+			vertex += 4;
+		}
+
+		if (ci == run_last)
+			break;
+		ci = next;
+	}
+
+	// vertices are in canvas space and colors carry the modulate, the clip is shared by the whole run
+	Item *item = batch.item;
+	item->final_transform = Transform2D();
+	item->final_modulate = Color(1, 1, 1, 1);
+	item->final_clip_owner = run_first->final_clip_owner;
+	item->final_clip_rect = run_first->final_clip_rect;
+	item->global_rect_cache = global_rect;
+	item->light_mask = 0;
+	item->rect_dirty = true;
+
+	_add_to_list(item);
+
+	batches_in_frame++;
+	vertices_in_frame += vertex;
+
+	run_first = NULL;
+	run_last = NULL;
+	run_quads = 0;
+}
+
+Item *VisualServerCanvasBatcher::batch_items(Item *p_list, int p_z, RasterizerCanvas::Light *p_lights) {
+
+	if (!enabled || max_quads < 2) {
+		for (Item *ci = p_list; ci; ci = ci->next) {
+			items_in_frame++;
+		}
+		return p_list;
+	}
+
+	// the list given last time is drawn by now, so its batches can be reused
+	batches_used = 0;
+	list_first = NULL;
+	list_last = NULL;
+
+	Item *ci = p_list;
+	while (ci) {
+
+		Item *next = ci->next;
+		items_in_frame++;
+
+		RID texture;
+		RID normal_map;
+		int quads = _get_quad_count(ci, p_z, p_lights, texture, normal_map);
+
+		if (quads < 0) {
+			_flush_run();
+			_add_to_list(ci);
+		} else {
+			if (run_first && (texture != run_texture || normal_map != run_normal_map || ci->final_clip_owner != run_first->final_clip_owner || run_quads + quads > max_quads)) {
+				_flush_run();
+			}
+			if (!run_first) {
+				run_first = ci;
+				run_texture = texture;
+				run_normal_map = normal_map;
+			}
+			run_last = ci;
+			run_quads += quads;
+		}
+
+		ci = next;
+	}
+
+	_flush_run();
+
+	return list_first;
+}
+
+void VisualServerCanvasBatcher::begin_frame() {
+
+	last_items_in_frame = items_in_frame;
+	last_batches_in_frame = batches_in_frame;
+	last_vertices_in_frame = vertices_in_frame;
+	items_in_frame = 0;
+	batches_in_frame = 0;
+	vertices_in_frame = 0;
+}
+
+int VisualServerCanvasBatcher::get_render_info(VS::RenderInfo p_info) const {
+
+	switch (p_info) {
+		case VS::INFO_2D_ITEMS_IN_FRAME: return last_items_in_frame;
+		case VS::INFO_2D_BATCHES_IN_FRAME: return last_batches_in_frame;
+		case VS::INFO_2D_BATCH_VERTICES_IN_FRAME: return last_vertices_in_frame;
+		default: {
+		}
+	}
+
+	return 0;
+}
+
+VisualServerCanvasBatcher::VisualServerCanvasBatcher() {
+
+	enabled = GLOBAL_DEF("rendering/2d/batching/use_batching", true);
+
+	// batches are drawn from the rasterizer's polygon buffers, so they have to fit in them
+	uint32_t buffer_size = GLOBAL_DEF("rendering/limits/buffers/canvas_polygon_buffer_size_kb", 128);
+	uint32_t index_buffer_size = GLOBAL_DEF("rendering/limits/buffers/canvas_polygon_index_buffer_size_kb", 128);
+	uint32_t vertex_size = sizeof(Point2) * 2 + sizeof(Color);
+	max_quads = MIN(buffer_size * 1024 / (vertex_size * 4), index_buffer_size * 1024 / (sizeof(int) * 6));
+	max_quads = MIN(max_quads, 65536 / 4); // some rasterizers can only draw with 16 bit indices
+
+	batches_used = 0;
+	run_first = NULL;
+	run_last = NULL;
+	run_quads = 0;
+	list_first = NULL;
+	list_last = NULL;
+
+	items_in_frame = 0;
+	batches_in_frame = 0;
+	vertices_in_frame = 0;
+	last_items_in_frame = 0;
+	last_batches_in_frame = 0;
+	last_vertices_in_frame = 0;
+}
+
+VisualServerCanvasBatcher::~VisualServerCanvasBatcher() {
+
+	for (int i = 0; i < batches.size(); i++) {
+		memdelete(batches[i].item);
+	}
+}
@@ -0,0 +1,83 @@
+/*************************************************************************/
+/*  visual_server_canvas_batcher.h                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef VISUALSERVERCANVASBATCHER_H
+#define VISUALSERVERCANVASBATCHER_H
+
+#include "rasterizer.h"
+
+// Merges runs of consecutive canvas items that only draw rects with the same
+// texture into single polygons in canvas space. The rasterizer then issues one
+// draw call per run, instead of one per rect.
+class VisualServerCanvasBatcher {
+
+	struct Batch {
+		RasterizerCanvas::Item *item;
+		RasterizerCanvas::Item::CommandPolygon *polygon;
+	};
+
+	Vector<Batch> batches;
+	int batches_used;
+	int max_quads;
+
+	RasterizerCanvas::Item *run_first;
+	RasterizerCanvas::Item *run_last;
+	int run_quads;
+	RID run_texture;
+	RID run_normal_map;
+
+	RasterizerCanvas::Item *list_first;
+	RasterizerCanvas::Item *list_last;
+
+	uint32_t items_in_frame;
+	uint32_t batches_in_frame;
+	uint32_t vertices_in_frame;
+	uint32_t last_items_in_frame;
+	uint32_t last_batches_in_frame;
+	uint32_t last_vertices_in_frame;
+
+	int _get_quad_count(const RasterizerCanvas::Item *p_item, int p_z, RasterizerCanvas::Light *p_lights, RID &r_texture, RID &r_normal_map) const;
+	void _add_to_list(RasterizerCanvas::Item *p_item);
+	void _flush_run();
+	Batch &_get_batch();
+
+public:
+	bool enabled;
+
+	RasterizerCanvas::Item *batch_items(RasterizerCanvas::Item *p_list, int p_z, RasterizerCanvas::Light *p_lights);
+
+	void begin_frame();
+	int get_render_info(VS::RenderInfo p_info) const;
+
+	VisualServerCanvasBatcher();
+	~VisualServerCanvasBatcher();
+};
+
+#endif // VISUALSERVERCANVASBATCHER_H
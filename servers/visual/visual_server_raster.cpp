@@ -102,6 +102,8 @@ void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 	changes = 0;
 
 	VSG::rasterizer->begin_frame(frame_step);
+	VSG::canvas->batcher.begin_frame();
+	VSG::scene->begin_frame();
 
 	VSG::scene->update_dirty_instances(); //update scene stuff
 
@@ -150,6 +152,19 @@ void VisualServerRaster::finish() {
 
 int VisualServerRaster::get_render_info(RenderInfo p_info) {
 
+	switch (p_info) {
+		case INFO_2D_ITEMS_IN_FRAME:
+		case INFO_2D_BATCHES_IN_FRAME:
+		case INFO_2D_BATCH_VERTICES_IN_FRAME: {
+			return VSG::canvas->batcher.get_render_info(p_info);
+		}
+		case INFO_3D_DIRTY_INSTANCES_IN_FRAME: {
+			return VSG::scene->get_render_info(p_info);
+		}
+		default: {
+		}
+	}
+
 	return VSG::storage->get_render_info(p_info);
 }
 
@@ -30,6 +30,7 @@
 
 #include "visual_server_scene.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 #include <new>
@@ -37,8 +38,7 @@
 
 RID VisualServerScene::camera_create() {
 
-	Camera *camera = memnew(Camera);
-	return camera_owner.make_rid(camera);
+	return camera_owner.make_rid();
 }
 
 void VisualServerScene::camera_set_perspective(RID p_camera, float p_fovy_degrees, float p_z_near, float p_z_far) {
@@ -252,13 +252,14 @@ void VisualServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance
 
 RID VisualServerScene::scenario_create() {
 
-	Scenario *scenario = memnew(Scenario);
-	ERR_FAIL_COND_V(!scenario, RID());
-	RID scenario_rid = scenario_owner.make_rid(scenario);
+	RID scenario_rid = scenario_owner.make_rid();
+	ERR_FAIL_COND_V(!scenario_rid.is_valid(), RID());
+	Scenario *scenario = scenario_owner.get(scenario_rid);
 	scenario->self = scenario_rid;
 
-	scenario->octree.set_pair_callback(_instance_pair, this);
-	scenario->octree.set_unpair_callback(_instance_unpair, this);
+	scenario->spatial_index.use_bvh = GLOBAL_GET("rendering/quality/spatial_partitioning/use_bvh");
+	scenario->spatial_index.set_pair_callback(_instance_pair, this);
+	scenario->spatial_index.set_unpair_callback(_instance_unpair, this);
 	scenario->reflection_probe_shadow_atlas = VSG::scene_render->shadow_atlas_create();
 	VSG::scene_render->shadow_atlas_set_size(scenario->reflection_probe_shadow_atlas, 1024); //make enough shadows for close distance, don't bother with rest
 	VSG::scene_render->shadow_atlas_set_quadrant_subdivision(scenario->reflection_probe_shadow_atlas, 0, 4);
@@ -317,10 +318,10 @@ void VisualServerScene::_instance_queue_update(Instance *p_instance, bool p_upda
 // from can be mesh, light,  area and portal so far.
 RID VisualServerScene::instance_create() {
 
-	Instance *instance = memnew(Instance);
-	ERR_FAIL_COND_V(!instance, RID());
+	RID instance_rid = instance_owner.make_rid();
+	ERR_FAIL_COND_V(!instance_rid.is_valid(), RID());
 
-	RID instance_rid = instance_owner.make_rid(instance);
+	Instance *instance = instance_owner.get(instance_rid);
 	instance->self = instance_rid;
 
 	return instance_rid;
@@ -355,9 +356,9 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 			}
 		}
 
-		if (scenario && instance->octree_id) {
-			scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (scenario && instance->spatial_index_id) {
+			scenario->spatial_index.erase(instance->spatial_index_id); //make dependencies generated by the spatial index go away
+			instance->spatial_index_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -508,9 +509,9 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
 
 		instance->scenario->instances.remove(&instance->scenario_item);
 
-		if (instance->octree_id) {
-			instance->scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (instance->spatial_index_id) {
+			instance->scenario->spatial_index.erase(instance->spatial_index_id); //make dependencies generated by the spatial index go away
+			instance->spatial_index_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -620,6 +621,7 @@ void VisualServerScene::instance_set_blend_shape_weight(RID p_instance, int p_sh
 	ERR_FAIL_COND(!instance);
 
 	if (instance->update_item.in_list()) {
+		_update_instance_bounds(instance);
 		_update_dirty_instance(instance);
 	}
 
@@ -662,26 +664,26 @@ void VisualServerScene::instance_set_visible(RID p_instance, bool p_visible) {
 
 	switch (instance->base_type) {
 		case VS::INSTANCE_LIGHT: {
-			if (VSG::storage->light_get_type(instance->base) != VS::LIGHT_DIRECTIONAL && instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_LIGHT, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+			if (VSG::storage->light_get_type(instance->base) != VS::LIGHT_DIRECTIONAL && instance->spatial_index_id && instance->scenario) {
+				instance->scenario->spatial_index.set_pairable(instance->spatial_index_id, p_visible, 1 << VS::INSTANCE_LIGHT, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case VS::INSTANCE_REFLECTION_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_REFLECTION_PROBE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->spatial_index_id && instance->scenario) {
+				instance->scenario->spatial_index.set_pairable(instance->spatial_index_id, p_visible, 1 << VS::INSTANCE_REFLECTION_PROBE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case VS::INSTANCE_LIGHTMAP_CAPTURE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->spatial_index_id && instance->scenario) {
+				instance->scenario->spatial_index.set_pairable(instance->spatial_index_id, p_visible, 1 << VS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case VS::INSTANCE_GI_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_GI_PROBE, p_visible ? (VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)) : 0);
+			if (instance->spatial_index_id && instance->scenario) {
+				instance->scenario->spatial_index.set_pairable(instance->spatial_index_id, p_visible, 1 << VS::INSTANCE_GI_PROBE, p_visible ? (VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)) : 0);
 			}
 
 		} break;
@@ -785,7 +787,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_aabb(const AABB &p_aabb, RID
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_aabb(p_aabb, cull, 1024);
+	culled = scenario->spatial_index.cull_aabb(p_aabb, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 
@@ -808,7 +810,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_ray(const Vector3 &p_from, co
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
+	culled = scenario->spatial_index.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 		Instance *instance = cull[i];
@@ -831,7 +833,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_convex(const Vector<Plane> &p
 	int culled = 0;
 	Instance *cull[1024];
 
-	culled = scenario->octree.cull_convex(p_convex, cull, 1024);
+	culled = scenario->spatial_index.cull_convex(p_convex, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 
@@ -947,20 +949,15 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	p_instance->mirror = p_instance->transform.basis.determinant() < 0.0;
-
-	AABB new_aabb;
-
-	new_aabb = p_instance->transform.xform(p_instance->aabb);
-
-	p_instance->transformed_aabb = new_aabb;
+	// mirror and transformed_aabb were computed by _update_instance_bounds()
+	const AABB &new_aabb = p_instance->transformed_aabb;
 
 	if (!p_instance->scenario) {
 
 		return;
 	}
 
-	if (p_instance->octree_id == 0) {
+	if (p_instance->spatial_index_id == 0) {
 
 		uint32_t base_type = 1 << p_instance->base_type;
 		uint32_t pairable_mask = 0;
@@ -978,8 +975,8 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 			pairable = true;
 		}
 
-		// not inside octree
-		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+		// not inside spatial index
+		p_instance->spatial_index_id = p_instance->scenario->spatial_index.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
 
 	} else {
 
@@ -988,7 +985,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 			return;
 		*/
 
-		p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+		p_instance->scenario->spatial_index.move(p_instance->spatial_index_id, new_aabb);
 	}
 }
 
@@ -1067,6 +1064,26 @@ void VisualServerScene::_update_instance_aabb(Instance *p_instance) {
 	p_instance->aabb = new_aabb;
 }
 
+// Only touches the instance itself (and reads the storage), so it can run on worker threads.
+void VisualServerScene::_update_instance_bounds(Instance *p_instance) {
+
+	if (p_instance->update_aabb) {
+		_update_instance_aabb(p_instance);
+	}
+
+	if (p_instance->aabb.has_no_surface()) {
+		return;
+	}
+
+	p_instance->mirror = p_instance->transform.basis.determinant() < 0.0;
+	p_instance->transformed_aabb = p_instance->transform.xform(p_instance->aabb);
+}
+
+void VisualServerScene::_update_instance_bounds_thread(uint32_t p_index, Instance **p_instances) {
+
+	_update_instance_bounds(p_instances[p_index]);
+}
+
 _FORCE_INLINE_ static void _light_capture_sample_octree(const RasterizerStorage::LightmapCaptureOctree *p_octree, int p_cell_subdiv, const Vector3 &p_pos, const Vector3 &p_dir, float p_level, Vector3 &r_color, float &r_alpha) {
 
 	static const Vector3 aniso_normal[6] = {
@@ -1300,6 +1317,47 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	}
 }
 
+void VisualServerScene::_shadow_cull_instance(uint32_t p_index, const Plane *p_near_plane) {
+
+	Instance *instance = instance_shadow_cull_result[p_index];
+	if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+		instance_shadow_cull_verdict[p_index] = 0;
+		return;
+	}
+
+	instance->depth = p_near_plane->distance_to(instance->transform.origin);
+	instance->depth_layer = 0;
+
+	instance_shadow_cull_verdict[p_index] = SHADOW_CULL_KEEP | (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated ? SHADOW_CULL_ANIMATED : 0);
+}
+
+int VisualServerScene::_shadow_cull_filter(int p_cull_count, const Plane &p_near_plane, bool &r_animated_material_found) {
+
+	if (cull_use_threads && p_cull_count >= THREADED_CULL_MIN_INSTANCES) {
+		cull_thread_pool.do_work(p_cull_count, this, &VisualServerScene::_shadow_cull_instance, &p_near_plane);
+	} else {
+		for (int i = 0; i < p_cull_count; i++) {
+			_shadow_cull_instance(i, &p_near_plane);
+		}
+	}
+
+	// compact in order, so the result does not depend on threading
+	int cull_count = 0;
+	for (int i = 0; i < p_cull_count; i++) {
+
+		uint8_t verdict = instance_shadow_cull_verdict[i];
+		if (!(verdict & SHADOW_CULL_KEEP)) {
+			continue;
+		}
+		if (verdict & SHADOW_CULL_ANIMATED) {
+			r_animated_material_found = true;
+		}
+		instance_shadow_cull_result[cull_count++] = instance_shadow_cull_result[i];
+	}
+
+	return cull_count;
+}
+
 bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
@@ -1326,7 +1384,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			if (depth_range_mode == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
 				//optimize min/max
 				Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
-				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				int cull_count = p_scenario->spatial_index.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 				Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
 				//check distance max and min
 
@@ -1524,26 +1582,18 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
 				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				int cull_count = p_scenario->spatial_index.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 
 				// a pre pass will need to be needed to determine the actual z-near to be used
 
 				Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 
+				cull_count = _shadow_cull_filter(cull_count, near_plane, animated_material_found);
+
 				for (int j = 0; j < cull_count; j++) {
 
 					float min, max;
-					Instance *instance = instance_shadow_cull_result[j];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-						j--;
-						continue;
-					}
-
-					instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
+					instance_shadow_cull_result[j]->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
 					if (max > z_max)
 						z_max = max;
 				}
@@ -1588,25 +1638,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+					int cull_count = p_scenario->spatial_index.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
 
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
+					cull_count = _shadow_cull_filter(cull_count, near_plane, animated_material_found);
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
 					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -1642,24 +1677,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+					int cull_count = p_scenario->spatial_index.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
+					cull_count = _shadow_cull_filter(cull_count, near_plane, animated_material_found);
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
 					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -1679,24 +1700,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+			int cull_count = p_scenario->spatial_index.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-			for (int j = 0; j < cull_count; j++) {
-
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-					j--;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-				}
-			}
+			cull_count = _shadow_cull_filter(cull_count, near_plane, animated_material_found);
 
 			VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
 			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -1842,6 +1849,93 @@ void VisualServerScene::render_camera(Ref<ARVRInterface> &p_interface, ARVRInter
 	_render_scene(cam_transform, camera_matrix, false, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
+void VisualServerScene::_scene_cull_instance(uint32_t p_index, const SceneCullParams *p_params) {
+
+	// Runs on worker threads, so only this instance may be modified here.
+	// Anything touching shared lists or the storage is left to the serial pass in _prepare_scene.
+
+	Instance *ins = instance_cull_result[p_index];
+
+	if ((p_params->camera_layer_mask & ins->layer_mask) == 0) {
+
+		instance_cull_verdict[p_index] = CULL_VERDICT_DISCARD;
+
+	} else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
+
+		instance_cull_verdict[p_index] = CULL_VERDICT_LIGHT;
+
+	} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE && ins->visible) {
+
+		instance_cull_verdict[p_index] = CULL_VERDICT_REFLECTION_PROBE;
+
+	} else if (ins->base_type == VS::INSTANCE_GI_PROBE && ins->visible) {
+
+		instance_cull_verdict[p_index] = CULL_VERDICT_GI_PROBE;
+
+	} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+
+		if (geom->lighting_dirty) {
+			int l = 0;
+			//only called when lights AABB enter/exit this geometry
+			ins->light_instances.resize(geom->lighting.size());
+
+			for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
+
+				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+
+				ins->light_instances.write[l++] = light->instance;
+			}
+
+			geom->lighting_dirty = false;
+		}
+
+		if (geom->reflection_dirty) {
+			int l = 0;
+			//only called when reflection probe AABB enter/exit this geometry
+			ins->reflection_probe_instances.resize(geom->reflection_probes.size());
+
+			for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
+
+				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
+
+				ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
+			}
+
+			geom->reflection_dirty = false;
+		}
+
+		if (geom->gi_probes_dirty) {
+			int l = 0;
+			//only called when reflection probe AABB enter/exit this geometry
+			ins->gi_probe_instances.resize(geom->gi_probes.size());
+
+			for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
+
+				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
+
+				ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
+			}
+
+			geom->gi_probes_dirty = false;
+		}
+
+		ins->depth = p_params->near_plane.distance_to(ins->transform.origin);
+		ins->depth_layer = CLAMP(int(ins->depth * 16 / p_params->z_far), 0, 15);
+
+		if (ins->redraw_if_visible || ins->base_type == VS::INSTANCE_PARTICLES) {
+			instance_cull_verdict[p_index] = CULL_VERDICT_GEOMETRY_SERIAL;
+		} else {
+			instance_cull_verdict[p_index] = CULL_VERDICT_GEOMETRY;
+		}
+
+	} else {
+
+		instance_cull_verdict[p_index] = CULL_VERDICT_DISCARD;
+	}
+}
+
 void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
@@ -1862,7 +1956,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	float z_far = p_cam_projection.get_z_far();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	instance_cull_count = scenario->spatial_index.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -1881,151 +1975,126 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
-	for (int i = 0; i < instance_cull_count; i++) {
-
-		Instance *ins = instance_cull_result[i];
-
-		bool keep = false;
+	SceneCullParams cull_params;
+	cull_params.camera_layer_mask = camera_layer_mask;
+	cull_params.near_plane = near_plane;
+	cull_params.z_far = z_far;
 
-		if ((camera_layer_mask & ins->layer_mask) == 0) {
+	if (cull_use_threads && instance_cull_count >= THREADED_CULL_MIN_INSTANCES) {
+		cull_thread_pool.do_work(instance_cull_count, this, &VisualServerScene::_scene_cull_instance, &cull_params);
+	} else {
+		for (int i = 0; i < instance_cull_count; i++) {
+			_scene_cull_instance(i, &cull_params);
+		}
+	}
 
-			//failure
-		} else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
+	// apply the verdicts in order, everything touching shared state happens here
+	int keep_count = 0;
 
-			if (light_cull_count < MAX_LIGHTS_CULLED) {
+	for (int i = 0; i < instance_cull_count; i++) {
 
-				InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
+		Instance *ins = instance_cull_result[i];
 
-				if (!light->geometries.empty()) {
-					//do not add this light if no geometry is affected by it..
-					light_cull_result[light_cull_count] = ins;
-					light_instance_cull_result[light_cull_count] = light->instance;
-					if (p_shadow_atlas.is_valid() && VSG::storage->light_has_shadow(ins->base)) {
-						VSG::scene_render->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
-					}
+		bool keep = false;
 
-					light_cull_count++;
-				}
-			}
-		} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE && ins->visible) {
+		switch (instance_cull_verdict[i]) {
 
-			if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
+			case CULL_VERDICT_LIGHT: {
 
-				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
+				if (light_cull_count < MAX_LIGHTS_CULLED) {
 
-				if (p_reflection_probe != reflection_probe->instance) {
-					//avoid entering The Matrix
+					InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
 
-					if (!reflection_probe->geometries.empty()) {
+					if (!light->geometries.empty()) {
 						//do not add this light if no geometry is affected by it..
-
-						if (reflection_probe->reflection_dirty || VSG::scene_render->reflection_probe_instance_needs_redraw(reflection_probe->instance)) {
-							if (!reflection_probe->update_list.in_list()) {
-								reflection_probe->render_step = 0;
-								reflection_probe_render_list.add_last(&reflection_probe->update_list);
-							}
-
-							reflection_probe->reflection_dirty = false;
+						light_cull_result[light_cull_count] = ins;
+						light_instance_cull_result[light_cull_count] = light->instance;
+						if (p_shadow_atlas.is_valid() && VSG::storage->light_has_shadow(ins->base)) {
+							VSG::scene_render->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
 						}
 
-						if (VSG::scene_render->reflection_probe_instance_has_reflection(reflection_probe->instance)) {
-							reflection_probe_instance_cull_result[reflection_probe_cull_count] = reflection_probe->instance;
-							reflection_probe_cull_count++;
-						}
+						light_cull_count++;
 					}
 				}
-			}
+			} break;
+			case CULL_VERDICT_REFLECTION_PROBE: {
 
-		} else if (ins->base_type == VS::INSTANCE_GI_PROBE && ins->visible) {
+				if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
 
-			InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(ins->base_data);
-			if (!gi_probe->update_element.in_list()) {
-				gi_probe_update_list.add(&gi_probe->update_element);
-			}
+					InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
 
-		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+					if (p_reflection_probe != reflection_probe->instance) {
+						//avoid entering The Matrix
 
-			keep = true;
+						if (!reflection_probe->geometries.empty()) {
+							//do not add this light if no geometry is affected by it..
 
-			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+							if (reflection_probe->reflection_dirty || VSG::scene_render->reflection_probe_instance_needs_redraw(reflection_probe->instance)) {
+								if (!reflection_probe->update_list.in_list()) {
+									reflection_probe->render_step = 0;
+									reflection_probe_render_list.add_last(&reflection_probe->update_list);
+								}
 
-			if (ins->redraw_if_visible) {
-				VisualServerRaster::redraw_request();
-			}
+								reflection_probe->reflection_dirty = false;
+							}
 
-			if (ins->base_type == VS::INSTANCE_PARTICLES) {
-				//particles visible? process them
-				if (VSG::storage->particles_is_inactive(ins->base)) {
-					//but if nothing is going on, don't do it.
-					keep = false;
-				} else {
-					VSG::storage->particles_request_process(ins->base);
-					//particles visible? request redraw
-					VisualServerRaster::redraw_request();
+							if (VSG::scene_render->reflection_probe_instance_has_reflection(reflection_probe->instance)) {
+								reflection_probe_instance_cull_result[reflection_probe_cull_count] = reflection_probe->instance;
+								reflection_probe_cull_count++;
+							}
+						}
+					}
 				}
-			}
-
-			if (geom->lighting_dirty) {
-				int l = 0;
-				//only called when lights AABB enter/exit this geometry
-				ins->light_instances.resize(geom->lighting.size());
-
-				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 
-					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+			} break;
+			case CULL_VERDICT_GI_PROBE: {
 
-					ins->light_instances.write[l++] = light->instance;
+				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(ins->base_data);
+				if (!gi_probe->update_element.in_list()) {
+					gi_probe_update_list.add(&gi_probe->update_element);
 				}
 
-				geom->lighting_dirty = false;
-			}
-
-			if (geom->reflection_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->reflection_probe_instances.resize(geom->reflection_probes.size());
-
-				for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
+			} break;
+			case CULL_VERDICT_GEOMETRY_SERIAL: {
 
-					InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
+				keep = true;
 
-					ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
+				if (ins->redraw_if_visible) {
+					VisualServerRaster::redraw_request();
 				}
 
-				geom->reflection_dirty = false;
-			}
-
-			if (geom->gi_probes_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->gi_probe_instances.resize(geom->gi_probes.size());
-
-				for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
-
-					InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
-
-					ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
+				if (ins->base_type == VS::INSTANCE_PARTICLES) {
+					//particles visible? process them
+					if (VSG::storage->particles_is_inactive(ins->base)) {
+						//but if nothing is going on, don't do it.
+						keep = false;
+					} else {
+						VSG::storage->particles_request_process(ins->base);
+						//particles visible? request redraw
+						VisualServerRaster::redraw_request();
+					}
 				}
+			} break;
+			case CULL_VERDICT_GEOMETRY: {
 
-				geom->gi_probes_dirty = false;
+				keep = true;
+			} break;
+			default: {
 			}
-
-			ins->depth = near_plane.distance_to(ins->transform.origin);
-			ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
 		}
 
 		if (!keep) {
 			// remove, no reason to keep
-			instance_cull_count--;
-			SWAP(instance_cull_result[i], instance_cull_result[instance_cull_count]);
-			i--;
 			ins->last_render_pass = 0; // make invalid
 		} else {
 
 			ins->last_render_pass = render_pass;
+			instance_cull_result[keep_count++] = ins;
 		}
 	}
 
+	instance_cull_count = keep_count;
+
 	/* STEP 5 - PROCESS LIGHTS */
 
 	RID *directional_light_ptr = &light_instance_cull_result[light_cull_count];
@@ -3285,9 +3354,7 @@ void VisualServerScene::render_probes() {
 
 void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
 
-	if (p_instance->update_aabb) {
-		_update_instance_aabb(p_instance);
-	}
+	// bounds must already be up to date, see _update_instance_bounds()
 
 	if (p_instance->update_materials) {
 
@@ -3456,20 +3523,64 @@ void VisualServerScene::update_dirty_instances() {
 
 	VSG::storage->update_dirty_resources();
 
+	// Updating an instance can queue others (through pairing), so drain the list in passes.
 	while (_instance_update_list.first()) {
 
-		_update_dirty_instance(_instance_update_list.first()->self());
+		int count = 0;
+		for (SelfList<Instance> *E = _instance_update_list.first(); E; E = E->next()) {
+			count++;
+		}
+
+		if (dirty_instance_array.size() < count) {
+			dirty_instance_array.resize(next_power_of_2(count));
+		}
+
+		Instance **instances = dirty_instance_array.ptrw();
+		int idx = 0;
+		for (SelfList<Instance> *E = _instance_update_list.first(); E; E = E->next()) {
+			instances[idx++] = E->self();
+		}
+
+		// AABBs and transformed bounds are independent per instance; the rest
+		// (materials, lights, the spatial index) is shared and stays serial.
+		if (cull_use_threads && count >= THREADED_CULL_MIN_INSTANCES) {
+			cull_thread_pool.do_work(count, this, &VisualServerScene::_update_instance_bounds_thread, instances);
+		} else {
+			for (int i = 0; i < count; i++) {
+				_update_instance_bounds(instances[i]);
+			}
+		}
+
+		for (int i = 0; i < count; i++) {
+			_update_dirty_instance(instances[i]);
+		}
+
+		dirty_instances_in_frame += count;
 	}
 }
 
+void VisualServerScene::begin_frame() {
+
+	last_dirty_instances_in_frame = dirty_instances_in_frame;
+	dirty_instances_in_frame = 0;
+}
+
+int VisualServerScene::get_render_info(VS::RenderInfo p_info) const {
+
+	switch (p_info) {
+		case VS::INFO_3D_DIRTY_INSTANCES_IN_FRAME: return last_dirty_instances_in_frame;
+		default: {
+		}
+	}
+
+	return 0;
+}
+
 bool VisualServerScene::free(RID p_rid) {
 
 	if (camera_owner.owns(p_rid)) {
 
-		Camera *camera = camera_owner.get(p_rid);
-
 		camera_owner.free(p_rid);
-		memdelete(camera);
 
 	} else if (scenario_owner.owns(p_rid)) {
 
@@ -3481,15 +3592,12 @@ bool VisualServerScene::free(RID p_rid) {
 		VSG::scene_render->free(scenario->reflection_probe_shadow_atlas);
 		VSG::scene_render->free(scenario->reflection_atlas);
 		scenario_owner.free(p_rid);
-		memdelete(scenario);
 
 	} else if (instance_owner.owns(p_rid)) {
 		// delete the instance
 
 		update_dirty_instances();
 
-		Instance *instance = instance_owner.get(p_rid);
-
 		instance_set_use_lightmap(p_rid, RID(), RID());
 		instance_set_scenario(p_rid, RID());
 		instance_set_base(p_rid, RID());
@@ -3499,7 +3607,6 @@ bool VisualServerScene::free(RID p_rid) {
 		update_dirty_instances(); //in case something changed this
 
 		instance_owner.free(p_rid);
-		memdelete(instance);
 	} else {
 		return false;
 	}
@@ -3520,10 +3627,21 @@ VisualServerScene::VisualServerScene() {
 
 	render_pass = 1;
 	singleton = this;
+
+	dirty_instances_in_frame = 0;
+	last_dirty_instances_in_frame = 0;
+
+	cull_use_threads = GLOBAL_GET("rendering/threads/threaded_culling");
+	if (cull_use_threads) {
+		cull_thread_pool.init();
+		cull_use_threads = cull_thread_pool.is_threaded();
+	}
 }
 
 VisualServerScene::~VisualServerScene() {
 
+	cull_thread_pool.finish();
+
 #ifndef NO_THREADS
 	probe_bake_thread_exit = true;
 	probe_bake_sem->post();
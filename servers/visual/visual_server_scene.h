@@ -33,10 +33,12 @@
 
 #include "servers/visual/rasterizer.h"
 
+#include "core/math/dynamic_bvh.h"
 #include "core/math/geometry.h"
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/self_list.h"
 #include "servers/arvr/arvr_interface.h"
 
@@ -49,6 +51,7 @@ public:
 		MAX_REFLECTION_PROBES_CULLED = 4096,
 		MAX_ROOM_CULL = 32,
 		MAX_EXTERIOR_PORTALS = 128,
+		THREADED_CULL_MIN_INSTANCES = 1024, // below this, dispatching to worker threads costs more than it saves
 	};
 
 	uint64_t render_pass;
@@ -119,12 +122,70 @@ public:
 
 	struct Instance;
 
+	// Spatial index of a scenario, either the octree or the dynamic BVH.
+	// Chosen when the scenario is created, see rendering/quality/spatial_partitioning/use_bvh.
+	struct SpatialIndex {
+
+		typedef Octree<Instance, true>::PairCallback PairCallback;
+		typedef Octree<Instance, true>::UnpairCallback UnpairCallback;
+
+		bool use_bvh;
+		Octree<Instance, true> octree;
+		DynamicBVH<Instance, true> bvh;
+
+		_FORCE_INLINE_ uint32_t create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+			return use_bvh ? bvh.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask) : octree.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask);
+		}
+		_FORCE_INLINE_ void move(uint32_t p_id, const AABB &p_aabb) {
+			if (use_bvh) {
+				bvh.move(p_id, p_aabb);
+			} else {
+				octree.move(p_id, p_aabb);
+			}
+		}
+		_FORCE_INLINE_ void set_pairable(uint32_t p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+			if (use_bvh) {
+				bvh.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask);
+			} else {
+				octree.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask);
+			}
+		}
+		_FORCE_INLINE_ void erase(uint32_t p_id) {
+			if (use_bvh) {
+				bvh.erase(p_id);
+			} else {
+				octree.erase(p_id);
+			}
+		}
+
+		_FORCE_INLINE_ int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) {
+			return use_bvh ? bvh.cull_convex(p_convex, p_result_array, p_result_max, p_mask) : octree.cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+		}
+		_FORCE_INLINE_ int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) {
+			return use_bvh ? bvh.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask) : octree.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask);
+		}
+		_FORCE_INLINE_ int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) {
+			return use_bvh ? bvh.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask) : octree.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask);
+		}
+
+		void set_pair_callback(PairCallback p_callback, void *p_userdata) {
+			octree.set_pair_callback(p_callback, p_userdata);
+			bvh.set_pair_callback(p_callback, p_userdata);
+		}
+		void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+			octree.set_unpair_callback(p_callback, p_userdata);
+			bvh.set_unpair_callback(p_callback, p_userdata);
+		}
+
+		SpatialIndex() { use_bvh = false; }
+	};
+
 	struct Scenario : RID_Data {
 
 		VS::ScenarioDebugMode debug;
 		RID self;
 
-		Octree<Instance, true> octree;
+		SpatialIndex spatial_index;
 
 		List<Instance *> directional_lights;
 		RID environment;
@@ -160,7 +221,7 @@ public:
 
 		RID self;
 		//scenario stuff
-		OctreeElementID octree_id;
+		OctreeElementID spatial_index_id;
 		Scenario *scenario;
 		SelfList<Instance> scenario_item;
 
@@ -203,7 +264,7 @@ public:
 				scenario_item(this),
 				update_item(this) {
 
-			octree_id = 0;
+			spatial_index_id = 0;
 			scenario = NULL;
 
 			update_aabb = false;
@@ -438,8 +499,39 @@ public:
 		}
 	};
 
+	// Verdicts written by the (possibly threaded) per-instance cull pass,
+	// consumed in order by a serial pass so results don't depend on threading.
+	enum CullVerdict {
+		CULL_VERDICT_DISCARD,
+		CULL_VERDICT_GEOMETRY,
+		CULL_VERDICT_GEOMETRY_SERIAL, // geometry with side effects that must run serially (particles, redraw requests)
+		CULL_VERDICT_LIGHT,
+		CULL_VERDICT_REFLECTION_PROBE,
+		CULL_VERDICT_GI_PROBE,
+	};
+
+	enum {
+		SHADOW_CULL_KEEP = 1,
+		SHADOW_CULL_ANIMATED = 2,
+	};
+
+	struct SceneCullParams {
+		uint32_t camera_layer_mask;
+		Plane near_plane;
+		float z_far;
+	};
+
+	ThreadWorkPool cull_thread_pool;
+	bool cull_use_threads;
+
+	Vector<Instance *> dirty_instance_array; // only grows, reused every update
+	int dirty_instances_in_frame;
+	int last_dirty_instances_in_frame;
+
 	int instance_cull_count;
 	Instance *instance_cull_result[MAX_INSTANCE_CULL];
+	uint8_t instance_cull_verdict[MAX_INSTANCE_CULL];
+	uint8_t instance_shadow_cull_verdict[MAX_INSTANCE_CULL];
 	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
@@ -484,9 +576,15 @@ public:
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_bounds(Instance *p_instance);
+	void _update_instance_bounds_thread(uint32_t p_index, Instance **p_instances);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
+	void _scene_cull_instance(uint32_t p_index, const SceneCullParams *p_params);
+	void _shadow_cull_instance(uint32_t p_index, const Plane *p_near_plane);
+	int _shadow_cull_filter(int p_cull_count, const Plane &p_near_plane, bool &r_animated_material_found);
+
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
 
 	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe);
@@ -497,6 +595,9 @@ public:
 	void render_camera(Ref<ARVRInterface> &p_interface, ARVRInterface::Eyes p_eye, RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
 	void update_dirty_instances();
 
+	void begin_frame();
+	int get_render_info(VS::RenderInfo p_info) const;
+
 	//probes
 	struct GIProbeDataHeader {
 